@@ -0,0 +1,242 @@
+#include "BBoxFrame.h"
+#include "JsonStreamReader.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <cstddef>
+#include <new>
+
+namespace {
+struct KnownType {
+    QByteArrayView name;
+    quint16 type;
+};
+
+// 서버 표기 차이는 여기서 한 번에 흡수
+constexpr KnownType KnownTypes[] = {
+    { "vehicle", ObjectTypes::Vehicle },
+    { "vehical", ObjectTypes::Vehicle },
+    { "person", ObjectTypes::Person },
+    { "human", ObjectTypes::Person },
+};
+
+// 비정상적인 입력으로 표가 계속 커지지 않도록 제한 (넘으면 Unknown)
+constexpr qsizetype MaxDynamicTypes = 256;
+
+// 처음 보는 타입 이름 (네트워크 스레드에서 추가, GUI 스레드에서 이름 조회)
+QMutex dynamicTypesMutex;
+QList<QByteArray> dynamicTypes;
+}
+
+quint16 ObjectTypes::intern(QByteArrayView name)
+{
+    if (name.isEmpty()) {
+        return Unknown;
+    }
+
+    for (const KnownType &known : KnownTypes) {
+        if (name.compare(known.name, Qt::CaseInsensitive) == 0) {
+            return known.type;
+        }
+    }
+
+    QMutexLocker locker(&dynamicTypesMutex);
+    for (qsizetype i = 0; i < dynamicTypes.size(); ++i) {
+        if (name.compare(dynamicTypes.at(i), Qt::CaseInsensitive) == 0) {
+            return static_cast<quint16>(FirstDynamic + i);
+        }
+    }
+
+    if (dynamicTypes.size() >= MaxDynamicTypes) {
+        return Unknown;
+    }
+    dynamicTypes.append(name.toByteArray());
+    return static_cast<quint16>(FirstDynamic + dynamicTypes.size() - 1);
+}
+
+QString ObjectTypes::name(quint16 type)
+{
+    switch (type) {
+    case Vehicle:
+        return QStringLiteral("Vehicle");
+    case Person:
+        return QStringLiteral("Person");
+    case Unknown:
+        return QStringLiteral("Unknown");
+    default:
+        break;
+    }
+
+    QMutexLocker locker(&dynamicTypesMutex);
+    qsizetype index = type - FirstDynamic;
+    if (index < dynamicTypes.size()) {
+        return QString::fromUtf8(dynamicTypes.at(index));
+    }
+    return QStringLiteral("Unknown");
+}
+
+struct BBoxFramePool::FreeList {
+    // 제어 블록(삭제자와 할당자 포함)이 들어가는 슬롯 크기
+    static constexpr std::size_t SlotSize = 128;
+
+    QMutex mutex;
+    QList<BBoxFrame *> frames;      // 아무도 들고 있지 않은 프레임
+    QList<void *> slots;            // 아무도 쓰지 않는 제어 블록 슬롯
+    int created = 0;                // 풀이 만든 프레임 수 (MaxPooledFrames까지)
+
+    ~FreeList()
+    {
+        qDeleteAll(frames);
+        for (void *slot : std::as_const(slots)) {
+            ::operator delete(slot);
+        }
+    }
+};
+
+template <typename T>
+struct BBoxFramePool::SlotAllocator {
+    using value_type = T;
+
+    std::shared_ptr<FreeList> freeList;
+
+    explicit SlotAllocator(std::shared_ptr<FreeList> list) : freeList(std::move(list)) {}
+    template <typename U>
+    SlotAllocator(const SlotAllocator<U> &other) : freeList(other.freeList) {}
+
+    T *allocate(std::size_t n)
+    {
+        static_assert(sizeof(T) <= FreeList::SlotSize, "control block does not fit a pool slot");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "control block needs stricter alignment");
+        Q_ASSERT(n == 1);
+        Q_UNUSED(n);
+        {
+            QMutexLocker locker(&freeList->mutex);
+            if (!freeList->slots.isEmpty()) {
+                return static_cast<T *>(freeList->slots.takeLast());
+            }
+        }
+        return static_cast<T *>(::operator new(FreeList::SlotSize));
+    }
+
+    void deallocate(T *pointer, std::size_t)
+    {
+        QMutexLocker locker(&freeList->mutex);
+        freeList->slots.append(pointer);
+    }
+
+    template <typename U>
+    bool operator==(const SlotAllocator<U> &other) const { return freeList == other.freeList; }
+    template <typename U>
+    bool operator!=(const SlotAllocator<U> &other) const { return freeList != other.freeList; }
+};
+
+void BBoxFramePool::Recycler::operator()(BBoxFrame *frame) const
+{
+    // 잠금이 GUI 스레드의 마지막 읽기와 네트워크 스레드의 다음 쓰기 사이 순서를 보장
+    QMutexLocker locker(&freeList->mutex);
+    freeList->frames.append(frame);
+}
+
+BBoxFramePool::BBoxFramePool()
+    : m_freeList(std::make_shared<FreeList>())
+{
+    m_freeList->frames.reserve(MaxPooledFrames);
+    m_freeList->slots.reserve(MaxPooledFrames);
+}
+
+std::shared_ptr<BBoxFrame> BBoxFramePool::acquire()
+{
+    BBoxFrame *frame = nullptr;
+    {
+        QMutexLocker locker(&m_freeList->mutex);
+        if (!m_freeList->frames.isEmpty()) {
+            frame = m_freeList->frames.takeLast();
+        } else if (m_freeList->created < MaxPooledFrames) {
+            m_freeList->created++;
+        } else {
+            // GUI가 모든 풀 프레임을 들고 있으면 풀 밖의 일회용 프레임
+            locker.unlock();
+            auto spare = std::make_shared<BBoxFrame>();
+            spare->boxes.reserve(InitialCapacity);
+            return spare;
+        }
+    }
+
+    if (frame) {
+        frame->timestamp = 0;
+        frame->boxes.clear();
+    } else {
+        frame = new BBoxFrame();
+        frame->boxes.reserve(InitialCapacity);
+    }
+    return std::shared_ptr<BBoxFrame>(frame, Recycler{ m_freeList }, SlotAllocator<BBoxFrame>(m_freeList));
+}
+
+bool readBBoxFrame(QByteArrayView json, BBoxFrame &frame, QString *errorString)
+{
+    JsonStreamReader reader(json);
+    if (reader.readNext() != JsonStreamReader::BeginObject) {
+        if (errorString) {
+            *errorString = QStringLiteral("Invalid BBox frame format");
+        }
+        return false;
+    }
+
+    while (reader.readNext() == JsonStreamReader::Name) {
+        if (reader.isName("timestamp")) {
+            reader.readNext();
+            frame.timestamp = reader.toInteger(frame.timestamp);
+            continue;
+        }
+        if (!reader.isName("bboxes")) {
+            reader.skipValue();
+            continue;
+        }
+        if (reader.readNext() != JsonStreamReader::BeginArray) {
+            reader.skipValue();
+            continue;
+        }
+
+        while (reader.readNext() == JsonStreamReader::BeginObject) {
+            BBox bbox{0, ObjectTypes::Unknown, 0.0f, QRect()};
+            int x = 0, y = 0, width = 0, height = 0;
+
+            while (reader.readNext() == JsonStreamReader::Name) {
+                if (reader.isName("id")) {
+                    reader.readNext();
+                    bbox.object_id = static_cast<int>(reader.toInteger());
+                } else if (reader.isName("type")) {
+                    reader.readNext();
+                    bbox.type = ObjectTypes::intern(reader.text());
+                } else if (reader.isName("confidence")) {
+                    reader.readNext();
+                    bbox.confidence = static_cast<float>(reader.toDouble());
+                } else if (reader.isName("x")) {
+                    reader.readNext();
+                    x = static_cast<int>(reader.toInteger());
+                } else if (reader.isName("y")) {
+                    reader.readNext();
+                    y = static_cast<int>(reader.toInteger());
+                } else if (reader.isName("width")) {
+                    reader.readNext();
+                    width = static_cast<int>(reader.toInteger());
+                } else if (reader.isName("height")) {
+                    reader.readNext();
+                    height = static_cast<int>(reader.toInteger());
+                } else {
+                    reader.skipValue();
+                }
+            }
+
+            bbox.rect = QRect(x, y, width, height);
+            frame.boxes.append(bbox);
+        }
+    }
+
+    if (reader.hasError()) {
+        if (errorString) {
+            *errorString = reader.errorString();
+        }
+        return false;
+    }
+    return true;
+}
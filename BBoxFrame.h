@@ -0,0 +1,80 @@
+#ifndef BBOXFRAME_H
+#define BBOXFRAME_H
+
+#include <QByteArrayView>
+#include <QList>
+#include <QMetaType>
+#include <QRect>
+#include <QString>
+#include <memory>
+
+// 객체 타입 atom
+// 서버가 보내는 타입 문자열은 한 번만 등록하고 이후에는 번호로만 비교한다.
+namespace ObjectTypes {
+enum : quint16 {
+    Unknown = 0,
+    Vehicle,            // "vehicle", "vehical"(서버 표기)
+    Person,             // "person", "human"
+    FirstDynamic        // 처음 보는 타입 문자열에는 이 번호부터 차례로 할당
+};
+
+// 대소문자 구분 없이 같은 이름이면 같은 번호 (이미 등록된 이름이면 메모리 할당 없음)
+quint16 intern(QByteArrayView name);
+QString name(quint16 type);
+
+// 화면에 표시하는 타입 (차량, 사람)
+inline bool isDisplayed(quint16 type) { return type == Vehicle || type == Person; }
+}
+
+// BBox 데이터 구조체
+struct BBox {
+    int object_id;          // 객체 ID
+    quint16 type;           // 객체 타입 (ObjectTypes atom)
+    float confidence;       // 신뢰도 (0.0 ~ 1.0)
+    QRect rect;             // 바운딩 박스 영역 (x, y, width, height)
+};
+
+// 한 프레임 분량의 BBox
+// GUI 스레드에는 읽기 전용 스냅샷(BBoxFrameSnapshot)으로 넘기므로 복사가 없다.
+struct BBoxFrame {
+    qint64 timestamp = 0;
+    QList<BBox> boxes;
+};
+
+using BBoxFrameSnapshot = std::shared_ptr<const BBoxFrame>;
+
+// BBox 프레임(200) JSON을 frame에 채움 (frame->boxes에 이어서 추가, 용량이 충분하면 할당 없음)
+// 실패하면 false와 함께 errorString에 이유를 남긴다.
+bool readBBoxFrame(QByteArrayView json, BBoxFrame &frame, QString *errorString = nullptr);
+
+// 네트워크 스레드에서 BBoxFrame을 재사용하는 풀
+// 마지막 스냅샷이 해제될 때 삭제자가 프레임을 잠금으로 보호된 빈 목록에 돌려놓고,
+// acquire는 그 목록에서 꺼내 비운 뒤(용량 유지) 다시 쓴다 (GUI 쪽 읽기가 모두 끝난 뒤에만 재사용).
+// shared_ptr 제어 블록도 같은 목록의 고정 크기 슬롯에서 꺼내 쓰므로
+// 정상 상태에서는 프레임마다 새로 할당하는 메모리가 없다.
+class BBoxFramePool
+{
+public:
+    static constexpr int MaxPooledFrames = 4;
+    static constexpr qsizetype InitialCapacity = 64;
+
+    BBoxFramePool();
+
+    std::shared_ptr<BBoxFrame> acquire();
+
+private:
+    struct FreeList;
+    struct Recycler {
+        std::shared_ptr<FreeList> freeList;     // 풀이 먼저 없어져도 늦게 돌아온 프레임을 받아 정리
+        void operator()(BBoxFrame *frame) const;
+    };
+    // 제어 블록용 할당자 (해제된 슬롯을 목록에 돌려놓고 다음 acquire에서 재사용)
+    template <typename T>
+    struct SlotAllocator;
+
+    std::shared_ptr<FreeList> m_freeList;
+};
+
+Q_DECLARE_METATYPE(BBoxFrameSnapshot)
+
+#endif // BBOXFRAME_H
@@ -0,0 +1,242 @@
+#include "Base64Decoder.h"
+#include <array>
+#include <cstring>
+
+namespace {
+// 문자 → 6비트 값 (최상위 비트가 켜진 값은 빠른 경로에서 처리하지 않는 문자)
+constexpr quint8 Invalid = 0xFF;
+constexpr quint8 Whitespace = 0xFE;
+constexpr quint8 Padding = 0xFD;
+
+constexpr std::array<quint8, 256> makeDecodeTable()
+{
+    std::array<quint8, 256> table{};
+    for (int i = 0; i < 256; ++i) {
+        table[i] = Invalid;
+    }
+    const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (int i = 0; i < 64; ++i) {
+        table[static_cast<uchar>(alphabet[i])] = static_cast<quint8>(i);
+    }
+    table['\r'] = Whitespace;
+    table['\n'] = Whitespace;
+    table[' '] = Whitespace;
+    table['\t'] = Whitespace;
+    table['='] = Padding;
+    return table;
+}
+
+constexpr std::array<quint8, 256> DecodeTable = makeDecodeTable();
+}
+
+Base64Decoder::Base64Decoder(QIODevice *output)
+    : m_device(output)
+    , m_target(nullptr)
+    , m_outputSize(0)
+    , m_quadSize(0)
+    , m_padding(0)
+    , m_decodedBytes(0)
+{
+}
+
+Base64Decoder::Base64Decoder(QByteArray *output)
+    : m_device(nullptr)
+    , m_target(output)
+    , m_outputSize(0)
+    , m_quadSize(0)
+    , m_padding(0)
+    , m_decodedBytes(0)
+{
+}
+
+QByteArrayView Base64Decoder::stripDataUriPrefix(QByteArrayView input)
+{
+    // 접두어는 앞부분에만 있으므로 처음 몇십 바이트만 확인 (base64 본문에는 ','가 없음)
+    if (!input.startsWith("data:")) {
+        return input;
+    }
+    qsizetype comma = input.first(qMin<qsizetype>(input.size(), 128)).indexOf(',');
+    return comma >= 0 ? input.sliced(comma + 1) : input;
+}
+
+QByteArray Base64Decoder::decodeLenient(QByteArrayView input)
+{
+    return QByteArray::fromBase64(stripDataUriPrefix(input).toByteArray());
+}
+
+bool Base64Decoder::feed(QByteArrayView input)
+{
+    if (hasError()) {
+        return false;
+    }
+    if (m_target) {
+        m_target->reserve(m_target->size() + input.size() / 4 * 3 + 3);
+    }
+
+    const uchar *data = reinterpret_cast<const uchar *>(input.data());
+    qsizetype pos = 0;
+    qsizetype size = input.size();
+
+    while (pos < size) {
+        // 이전 조각에서 넘어온 문자가 없으면 묶음 단위로 처리
+        if (m_quadSize == 0 && m_padding == 0) {
+            pos += decodeBlocks(data + pos, size - pos);
+            if (hasError()) {
+                return false;
+            }
+            if (pos >= size) {
+                break;
+            }
+        }
+        if (!decodeSlow(data[pos])) {
+            return false;
+        }
+        ++pos;
+    }
+    return true;
+}
+
+qsizetype Base64Decoder::decodeBlocks(const uchar *input, qsizetype size)
+{
+    qsizetype pos = 0;
+
+    // 16문자(12바이트)씩: 표를 한 번씩 찾고 OR로 모아 특수 문자가 있는지 한 번만 확인
+    while (size - pos >= 16) {
+        if (OutputChunkSize - m_outputSize < 12 && !flushOutput()) {
+            return pos;
+        }
+
+        quint32 v[16];
+        quint32 flags = 0;
+        for (int i = 0; i < 16; ++i) {
+            v[i] = DecodeTable[input[pos + i]];
+            flags |= v[i];
+        }
+        if (flags & 0x80) {
+            break;
+        }
+
+        char *out = m_output + m_outputSize;
+        for (int quad = 0; quad < 4; ++quad) {
+            quint32 bits = (v[quad * 4] << 18) | (v[quad * 4 + 1] << 12) | (v[quad * 4 + 2] << 6) | v[quad * 4 + 3];
+            out[quad * 3] = static_cast<char>(bits >> 16);
+            out[quad * 3 + 1] = static_cast<char>(bits >> 8);
+            out[quad * 3 + 2] = static_cast<char>(bits);
+        }
+        m_outputSize += 12;
+        m_decodedBytes += 12;
+        pos += 16;
+    }
+
+    // 남은 4문자 묶음
+    while (size - pos >= 4) {
+        if (OutputChunkSize - m_outputSize < 3 && !flushOutput()) {
+            return pos;
+        }
+
+        quint32 a = DecodeTable[input[pos]];
+        quint32 b = DecodeTable[input[pos + 1]];
+        quint32 c = DecodeTable[input[pos + 2]];
+        quint32 d = DecodeTable[input[pos + 3]];
+        if ((a | b | c | d) & 0x80) {
+            break;
+        }
+
+        quint32 bits = (a << 18) | (b << 12) | (c << 6) | d;
+        char *out = m_output + m_outputSize;
+        out[0] = static_cast<char>(bits >> 16);
+        out[1] = static_cast<char>(bits >> 8);
+        out[2] = static_cast<char>(bits);
+        m_outputSize += 3;
+        m_decodedBytes += 3;
+        pos += 4;
+    }
+    return pos;
+}
+
+bool Base64Decoder::decodeSlow(uchar c)
+{
+    quint8 value = DecodeTable[c];
+    if (value == Whitespace) {
+        return true;
+    }
+    if (value == Padding) {
+        // "xx==" 또는 "xxx=" 만 허용
+        if (m_quadSize < 2 || m_quadSize + m_padding >= 4) {
+            return setError("Unexpected base64 padding");
+        }
+        m_padding++;
+        if (m_quadSize + m_padding == 4) {
+            return emitQuad(m_quadSize);
+        }
+        return true;
+    }
+    if (value == Invalid) {
+        return setError(QString("Invalid base64 character: 0x%1").arg(uint(c), 2, 16, QChar('0')));
+    }
+    if (m_padding > 0) {
+        return setError("Base64 data after padding");
+    }
+
+    m_quad[m_quadSize++] = value;
+    if (m_quadSize == 4) {
+        return emitQuad(4);
+    }
+    return true;
+}
+
+bool Base64Decoder::emitQuad(int count)
+{
+    // count 문자 → count - 1 바이트 (4문자면 3바이트), 모자란 자리는 0으로 봄
+    if (OutputChunkSize - m_outputSize < 3 && !flushOutput()) {
+        return false;
+    }
+
+    quint32 bits = 0;
+    for (int i = 0; i < 4; ++i) {
+        bits = (bits << 6) | (i < count ? m_quad[i] : 0);
+    }
+    const char bytes[3] = { static_cast<char>(bits >> 16), static_cast<char>(bits >> 8), static_cast<char>(bits) };
+    std::memcpy(m_output + m_outputSize, bytes, count - 1);
+    m_outputSize += count - 1;
+    m_decodedBytes += count - 1;
+    m_quadSize = 0;
+    return true;
+}
+
+bool Base64Decoder::finish()
+{
+    if (hasError()) {
+        return false;
+    }
+    if (m_quadSize == 1) {
+        return setError("Truncated base64 data");
+    }
+    if (m_quadSize > 1 && !emitQuad(m_quadSize)) {
+        return false;
+    }
+    return flushOutput();
+}
+
+bool Base64Decoder::flushOutput()
+{
+    if (m_outputSize == 0) {
+        return true;
+    }
+
+    if (m_target) {
+        m_target->append(m_output, m_outputSize);
+    } else if (m_device && m_device->write(m_output, m_outputSize) != m_outputSize) {
+        return setError(QString("Failed to write decoded data: %1").arg(m_device->errorString()));
+    }
+    m_outputSize = 0;
+    return true;
+}
+
+bool Base64Decoder::setError(const QString &error)
+{
+    if (m_errorString.isEmpty()) {
+        m_errorString = error;
+    }
+    return false;
+}
@@ -0,0 +1,55 @@
+#ifndef BASE64DECODER_H
+#define BASE64DECODER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QIODevice>
+#include <QString>
+
+// 조각 단위 base64 디코더
+// 프레임의 UTF-8 바이트를 그대로 받아 (QString/중간 QByteArray 없이) 고정 크기 출력 버퍼에 풀고,
+// 버퍼가 차면 파일 또는 대상 QByteArray로 내보낸다. feed()는 임의의 위치에서 잘린 입력을
+// 여러 번 받을 수 있으며, 줄바꿈/공백은 건너뛴다.
+class Base64Decoder
+{
+public:
+    static constexpr qsizetype OutputChunkSize = 48 * 1024;     // 3의 배수 (4문자 → 3바이트)
+
+    explicit Base64Decoder(QIODevice *output);
+    explicit Base64Decoder(QByteArray *output);
+
+    // "data:image/jpeg;base64," 형태의 접두어를 복사 없이 건너뜀
+    static QByteArrayView stripDataUriPrefix(QByteArrayView input);
+    // 엄격한 디코딩이 실패했을 때의 대체 경로 (이전 동작과 같은 QByteArray::fromBase64)
+    // URL-safe 문자('-', '_')나 알파벳 밖의 바이트를 오류 없이 건너뛴다. 입력 전체를 복사하므로 예외 상황에만 쓴다.
+    static QByteArray decodeLenient(QByteArrayView input);
+
+    bool feed(QByteArrayView input);
+    // 남은 문자(패딩 없는 끝 포함)를 처리하고 출력 버퍼를 비움
+    bool finish();
+
+    qint64 decodedBytes() const { return m_decodedBytes; }
+    bool hasError() const { return !m_errorString.isEmpty(); }
+    QString errorString() const { return m_errorString; }
+
+private:
+    // 4문자 묶음 단위로 처리하는 빠른 경로 (처리한 입력 길이 반환, 특수 문자를 만나면 멈춤)
+    qsizetype decodeBlocks(const uchar *input, qsizetype size);
+    bool decodeSlow(uchar c);
+    bool emitQuad(int count);
+    bool flushOutput();
+    bool setError(const QString &error);
+
+    QIODevice *m_device;
+    QByteArray *m_target;
+    char m_output[OutputChunkSize];
+    qsizetype m_outputSize;
+
+    quint8 m_quad[4];               // feed() 경계에 걸친 문자
+    int m_quadSize;
+    int m_padding;                  // '=' 이후에는 공백 외의 입력을 받지 않음
+    qint64 m_decodedBytes;
+    QString m_errorString;
+};
+
+#endif // BASE64DECODER_H
@@ -1,7 +1,10 @@
-QT += core widgets network multimedia multimediawidgets
+QT += core widgets network multimedia multimediawidgets concurrent
 
 CONFIG += c++17
 
+# qmake CONFIG+=strip_debug_logs : qDebug()/qCDebug()를 컴파일 단계에서 제거 (경고 이상은 유지)
+strip_debug_logs: DEFINES += QT_NO_DEBUG_OUTPUT
+
 TARGET = CCTVMonitoring
 TEMPLATE = app
 
@@ -13,6 +16,21 @@ SOURCES += \
     MainWindow.cpp \
     VideoStreamWidget.cpp \
     TcpCommunicator.cpp \
+    NetworkWorker.cpp \
+    FrameDecoder.cpp \
+    FrameCompressor.cpp \
+    JsonStreamReader.cpp \
+    CborCodec.cpp \
+    BBoxFrame.cpp \
+    MessageDispatcher.cpp \
+    RttHistogram.cpp \
+    SessionRecorder.cpp \
+    NetworkMetrics.cpp \
+    DiagnosticsDialog.cpp \
+    Logging.cpp \
+    EventLoopWatchdog.cpp \
+    Base64Decoder.cpp \
+    CaptureCache.cpp \
     ImageViewerDialog.cpp \
     NetworkConfigDialog.cpp \
     LineDrawingDialog.cpp \
@@ -24,6 +42,21 @@ HEADERS += \
     MainWindow.h \
     VideoStreamWidget.h \
     TcpCommunicator.h \
+    NetworkWorker.h \
+    FrameDecoder.h \
+    FrameCompressor.h \
+    JsonStreamReader.h \
+    CborCodec.h \
+    BBoxFrame.h \
+    MessageDispatcher.h \
+    RttHistogram.h \
+    SessionRecorder.h \
+    NetworkMetrics.h \
+    DiagnosticsDialog.h \
+    Logging.h \
+    EventLoopWatchdog.h \
+    Base64Decoder.h \
+    CaptureCache.h \
     ImageViewerDialog.h \
     NetworkConfigDialog.h \
     LineDrawingDialog.h \
@@ -50,6 +83,10 @@ win32 {
     QMAKE_POST_LINK += $$quote(copy /Y $$ENV_FILE $$TARGET_DIR$$escape_expand(\\n\\t))
 }
 
+# 프레임 압축 (z_stream 재사용) - Qt에 포함된 zlib은 외부에 공개되지 않으므로 시스템 zlib 링크
+win32-msvc*: LIBS += zlib.lib
+else: LIBS += -lz
+
 # 컴파일러 플래그
 QMAKE_CXXFLAGS += -Wno-unused-parameter
 
@@ -0,0 +1,532 @@
+#include "CaptureCache.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+
+namespace {
+constexpr quint32 IndexMagic = 0x43434958;     // "CCIX"
+constexpr quint32 IndexVersion = 1;
+constexpr int HourSecs = 3600;
+
+const QString IndexFileName = QStringLiteral("index.dat");
+}
+
+CaptureCache::CaptureCache()
+    : m_maxBytes(DefaultMaxBytes)
+    , m_totalBytes(0)
+    , m_indexDirty(false)
+{
+}
+
+CaptureCache::~CaptureCache()
+{
+    close();
+}
+
+bool CaptureCache::open(const QString &directory, qint64 maxBytes)
+{
+    close();
+
+    QMutexLocker locker(&m_mutex);
+    QString path = directory;
+    if (path.isEmpty()) {
+        path = QDir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("captures");
+    }
+    if (!QDir().mkpath(path)) {
+        qDebug() << "[Cache] Failed to create capture cache directory:" << path;
+        return false;
+    }
+
+    m_directory = QDir(path).absolutePath();
+    m_maxBytes = qMax<qint64>(1, maxBytes);
+    if (!loadIndex()) {
+        // 목록이 없거나 손상되었으면 빈 캐시로 시작 (남은 파일은 같은 이름으로 다시 쓰일 때 덮어씀)
+        m_entries.clear();
+        m_lru.clear();
+        m_hours.clear();
+        m_completeHours.clear();
+        m_totalBytes = 0;
+    }
+    evictLocked();
+
+    qDebug() << "[Cache] Capture cache opened:" << m_directory << "-" << m_entries.size() << "images,"
+             << m_totalBytes / (1024 * 1024) << "/" << m_maxBytes / (1024 * 1024) << "MB";
+    return true;
+}
+
+void CaptureCache::close()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_directory.isEmpty()) {
+        return;
+    }
+    if (m_indexDirty) {
+        saveIndex();
+    }
+
+    m_directory.clear();
+    m_entries.clear();
+    m_lru.clear();
+    m_hours.clear();
+    m_completeHours.clear();
+    m_cameraDirs.clear();
+    m_totalBytes = 0;
+}
+
+bool CaptureCache::isOpen() const
+{
+    QMutexLocker locker(&m_mutex);
+    return !m_directory.isEmpty();
+}
+
+bool CaptureCache::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_directory.isEmpty() || !m_indexDirty) {
+        return true;
+    }
+    return saveIndex();
+}
+
+QString CaptureCache::cameraKey(const QString &host, quint16 port)
+{
+    if (host.isEmpty()) {
+        return QString();
+    }
+    return QString("%1:%2").arg(host).arg(port);
+}
+
+QString CaptureCache::fileName(const QString &timestamp, bool thumbnail)
+{
+    QString cleanTimestamp = timestamp;
+    cleanTimestamp.replace(":", "_").replace("-", "_");
+    return QString(thumbnail ? "CCTVThumb%1.jpg" : "CCTVImage%1.jpg").arg(cleanTimestamp);
+}
+
+QString CaptureCache::filePath(const QString &camera, const QString &timestamp, bool thumbnail)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_directory.isEmpty() || camera.isEmpty()) {
+        return QString();
+    }
+
+    // 카메라(서버 주소)마다 하위 디렉터리
+    QString cameraDir = camera;
+    for (QChar &c : cameraDir) {
+        if (!c.isLetterOrNumber() && c != '.' && c != '-') {
+            c = '_';
+        }
+    }
+    QDir dir(m_directory);
+    if (!m_cameraDirs.contains(cameraDir)) {
+        dir.mkpath(cameraDir);
+        m_cameraDirs.insert(cameraDir);
+    }
+    return dir.filePath(cameraDir + "/" + fileName(timestamp, thumbnail));
+}
+
+void CaptureCache::insert(const QString &camera, const QList<ImageData> &images)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_directory.isEmpty() || camera.isEmpty() || images.isEmpty()) {
+        return;
+    }
+
+    QSet<QString> inserted;
+    for (const ImageData &image : images) {
+        QString imageFile = relativePath(image.imagePath);
+        QString thumbnailFile = relativePath(image.thumbnailPath);
+        if (image.timestamp.isEmpty() || (imageFile.isEmpty() && thumbnailFile.isEmpty())) {
+            continue;
+        }
+
+        QString key = entryKey(camera, image.timestamp);
+        inserted.insert(key);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            Entry entry;
+            entry.camera = camera;
+            entry.timestamp = image.timestamp;
+            entry.time = parseTimestamp(image.timestamp);
+            if (entry.time.isValid()) {
+                entry.hour = hourKey(camera, hourStart(entry.time));
+                m_hours[entry.hour].insert(key);
+            }
+            m_lru.push_front(key);
+            entry.lruPosition = m_lru.begin();
+            it = m_entries.insert(key, entry);
+        } else {
+            touch(*it);
+        }
+
+        Entry &entry = *it;
+        if (!imageFile.isEmpty()) {
+            entry.imageFile = imageFile;
+        }
+        if (!thumbnailFile.isEmpty()) {
+            entry.thumbnailFile = thumbnailFile;
+        }
+        if (!image.imageId.isEmpty()) {
+            entry.imageId = image.imageId;
+        }
+        entry.logText = image.logText;
+        entry.detectionType = image.detectionType;
+        entry.direction = image.direction;
+
+        // 작은 원본은 썸네일로 그대로 쓰므로 같은 파일을 두 번 세지 않음
+        m_totalBytes -= entry.bytes;
+        entry.bytes = fileSize(entry.imageFile);
+        if (entry.thumbnailFile != entry.imageFile) {
+            entry.bytes += fileSize(entry.thumbnailFile);
+        }
+        m_totalBytes += entry.bytes;
+    }
+
+    m_indexDirty = true;
+
+    // 방금 받은 페이지의 파일은 지우지 않음 (페이지 하나가 예산보다 크면 잠시 넘는 것을 허용)
+    evictLocked(inserted);
+}
+
+QList<ImageData> CaptureCache::images(const QString &camera, const QDateTime &start, const QDateTime &end)
+{
+    QMutexLocker locker(&m_mutex);
+    QList<const Entry *> found;
+    if (m_directory.isEmpty()) {
+        return QList<ImageData>();
+    }
+
+    for (QDateTime hour = hourStart(start); hour < end; hour = hour.addSecs(HourSecs)) {
+        const QSet<QString> keys = m_hours.value(hourKey(camera, hour));
+        for (const QString &key : keys) {
+            Entry &entry = m_entries[key];
+            if (entry.time >= start && entry.time < end) {
+                touch(entry);
+                found.append(&entry);
+            }
+        }
+    }
+
+    std::sort(found.begin(), found.end(), [](const Entry *a, const Entry *b) {
+        return a->time < b->time;
+    });
+
+    QList<ImageData> result;
+    result.reserve(found.size());
+    for (const Entry *entry : std::as_const(found)) {
+        result.append(toImageData(*entry));
+    }
+    return result;
+}
+
+QList<QPair<QDateTime, QDateTime>> CaptureCache::missingRanges(const QString &camera, const QDateTime &start,
+                                                               const QDateTime &end) const
+{
+    QMutexLocker locker(&m_mutex);
+    QList<QPair<QDateTime, QDateTime>> ranges;
+    if (m_directory.isEmpty()) {
+        ranges.append(qMakePair(start, end));
+        return ranges;
+    }
+
+    // 비어 있는 시간대가 이어지면 한 구간으로 합침 (서버 요청 수를 줄임)
+    for (QDateTime hour = hourStart(start); hour < end; hour = hour.addSecs(HourSecs)) {
+        if (m_completeHours.contains(hourKey(camera, hour))) {
+            continue;
+        }
+        QDateTime from = qMax(hour, start);
+        QDateTime to = qMin(hour.addSecs(HourSecs), end);
+        if (!ranges.isEmpty() && ranges.last().second == from) {
+            ranges.last().second = to;
+        } else {
+            ranges.append(qMakePair(from, to));
+        }
+    }
+    return ranges;
+}
+
+bool CaptureCache::isComplete(const QString &camera, const QDateTime &start, const QDateTime &end) const
+{
+    return missingRanges(camera, start, end).isEmpty();
+}
+
+void CaptureCache::markComplete(const QString &camera, const QDateTime &start, const QDateTime &end, int expectedImages)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_directory.isEmpty() || camera.isEmpty() || expectedImages < 0) {
+        return;
+    }
+
+    // 페이지를 받는 사이에 지워진 항목이 있으면 완전하지 않음
+    int cached = 0;
+    for (QDateTime hour = hourStart(start); hour < end; hour = hour.addSecs(HourSecs)) {
+        const QSet<QString> keys = m_hours.value(hourKey(camera, hour));
+        for (const QString &key : keys) {
+            const QDateTime &time = m_entries[key].time;
+            if (time >= start && time < end) {
+                ++cached;
+            }
+        }
+    }
+    if (cached < expectedImages) {
+        qDebug() << "[Cache] Range not complete in cache:" << start << "-" << end
+                 << cached << "/" << expectedImages << "images";
+        return;
+    }
+
+    // 아직 끝나지 않은 시간대는 캡처가 더 생길 수 있으므로 기록하지 않음
+    QDateTime now = QDateTime::currentDateTime();
+    bool changed = false;
+    for (QDateTime hour = hourStart(start); hour < end; hour = hour.addSecs(HourSecs)) {
+        QDateTime hourEnd = hour.addSecs(HourSecs);
+        if (hour >= start && hourEnd <= end && hourEnd <= now) {
+            m_completeHours.insert(hourKey(camera, hour));
+            changed = true;
+        }
+    }
+    if (changed) {
+        m_indexDirty = true;
+    }
+}
+
+qint64 CaptureCache::totalBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_totalBytes;
+}
+
+int CaptureCache::entryCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_entries.size();
+}
+
+QString CaptureCache::entryKey(const QString &camera, const QString &timestamp)
+{
+    return camera + QChar('|') + timestamp;
+}
+
+QString CaptureCache::hourKey(const QString &camera, const QDateTime &hour)
+{
+    return camera + QChar('|') + hour.toString("yyyy-MM-ddTHH");
+}
+
+QDateTime CaptureCache::parseTimestamp(const QString &timestamp)
+{
+    QDateTime time = QDateTime::fromString(timestamp, Qt::ISODate);
+    if (!time.isValid()) {
+        time = QDateTime::fromString(timestamp, "yyyy-MM-dd HH:mm:ss");
+    }
+    return time;
+}
+
+QDateTime CaptureCache::hourStart(const QDateTime &time)
+{
+    return QDateTime(time.date(), QTime(time.time().hour(), 0));
+}
+
+QString CaptureCache::relativePath(const QString &path) const
+{
+    if (path.isEmpty()) {
+        return QString();
+    }
+    // 캐시 밖(임시 폴더)에 저장된 파일은 등록하지 않음
+    QString relative = QDir(m_directory).relativeFilePath(path);
+    if (relative.startsWith("..") || QDir::isAbsolutePath(relative)) {
+        return QString();
+    }
+    return relative;
+}
+
+qint64 CaptureCache::fileSize(const QString &relativePath) const
+{
+    if (relativePath.isEmpty()) {
+        return 0;
+    }
+    return QFileInfo(QDir(m_directory).filePath(relativePath)).size();
+}
+
+ImageData CaptureCache::toImageData(const Entry &entry) const
+{
+    QDir dir(m_directory);
+    ImageData imageData;
+    imageData.imagePath = entry.imageFile.isEmpty() ? QString() : dir.filePath(entry.imageFile);
+    imageData.thumbnailPath = entry.thumbnailFile.isEmpty() ? QString() : dir.filePath(entry.thumbnailFile);
+    imageData.imageId = entry.imageId;
+    imageData.timestamp = entry.timestamp;
+    imageData.logText = entry.logText;
+    imageData.detectionType = entry.detectionType;
+    imageData.direction = entry.direction;
+    return imageData;
+}
+
+void CaptureCache::touch(Entry &entry)
+{
+    if (entry.lruPosition != m_lru.begin()) {
+        m_lru.splice(m_lru.begin(), m_lru, entry.lruPosition);
+        m_indexDirty = true;
+    }
+}
+
+void CaptureCache::removeEntry(const QString &key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return;
+    }
+
+    QDir dir(m_directory);
+    if (!it->imageFile.isEmpty()) {
+        QFile::remove(dir.filePath(it->imageFile));
+    }
+    if (!it->thumbnailFile.isEmpty() && it->thumbnailFile != it->imageFile) {
+        QFile::remove(dir.filePath(it->thumbnailFile));
+    }
+
+    if (!it->hour.isEmpty()) {
+        auto hour = m_hours.find(it->hour);
+        if (hour != m_hours.end()) {
+            hour->remove(key);
+            if (hour->isEmpty()) {
+                m_hours.erase(hour);
+            }
+        }
+        m_completeHours.remove(it->hour);
+    }
+
+    m_totalBytes -= it->bytes;
+    m_lru.erase(it->lruPosition);
+    m_entries.erase(it);
+}
+
+void CaptureCache::evictLocked(const QSet<QString> &keep)
+{
+    int evicted = 0;
+    auto next = m_lru.end();    // 다음 후보는 next 바로 앞 항목 (지운 항목 뒤쪽은 그대로 유효)
+    while (m_totalBytes > m_maxBytes && next != m_lru.begin()) {
+        auto candidate = std::prev(next);
+        if (keep.contains(*candidate)) {
+            next = candidate;
+            continue;
+        }
+        removeEntry(*candidate);
+        ++evicted;
+    }
+    if (evicted > 0) {
+        m_indexDirty = true;
+        qDebug() << "[Cache] Evicted" << evicted << "images -" << m_totalBytes / (1024 * 1024) << "MB in use";
+    }
+    if (m_totalBytes > m_maxBytes) {
+        qDebug() << "[Cache] Over budget with only protected images left -" << m_totalBytes / (1024 * 1024)
+                 << "/" << m_maxBytes / (1024 * 1024) << "MB";
+    }
+}
+
+bool CaptureCache::loadIndex()
+{
+    QFile file(QDir(m_directory).filePath(IndexFileName));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 count = 0;
+    in >> magic >> version >> count;
+    if (magic != IndexMagic || version != IndexVersion || count < 0) {
+        qDebug() << "[Cache] Ignoring capture cache index with unknown format";
+        return false;
+    }
+
+    // 최근 사용 순서로 저장되어 있으므로 읽은 순서대로 뒤에 붙임
+    QDir dir(m_directory);
+    QSet<QString> incompleteHours;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        Entry entry;
+        in >> entry.camera >> entry.timestamp >> entry.imageFile >> entry.thumbnailFile >> entry.imageId
+           >> entry.logText >> entry.detectionType >> entry.direction >> entry.bytes;
+
+        // 밖에서 지운 파일은 목록에서도 뺌
+        if (!entry.imageFile.isEmpty() && !QFileInfo::exists(dir.filePath(entry.imageFile))) {
+            entry.imageFile.clear();
+        }
+        if (!entry.thumbnailFile.isEmpty() && !QFileInfo::exists(dir.filePath(entry.thumbnailFile))) {
+            entry.thumbnailFile.clear();
+        }
+        entry.time = parseTimestamp(entry.timestamp);
+        if (entry.time.isValid()) {
+            entry.hour = hourKey(entry.camera, hourStart(entry.time));
+        }
+        QString key = entryKey(entry.camera, entry.timestamp);
+        if ((entry.imageFile.isEmpty() && entry.thumbnailFile.isEmpty()) || m_entries.contains(key)) {
+            incompleteHours.insert(entry.hour);
+            m_indexDirty = true;
+            continue;
+        }
+
+        // 크기는 남아 있는 파일에서 다시 셈 (목록의 값을 믿으면 지워진 파일만큼 과대 계산되어 유효한 항목을 축출)
+        qint64 indexedBytes = entry.bytes;
+        entry.bytes = fileSize(entry.imageFile);
+        if (entry.thumbnailFile != entry.imageFile) {
+            entry.bytes += fileSize(entry.thumbnailFile);
+        }
+        if (entry.bytes != indexedBytes) {
+            m_indexDirty = true;
+        }
+
+        if (!entry.hour.isEmpty()) {
+            m_hours[entry.hour].insert(key);
+        }
+        m_lru.push_back(key);
+        entry.lruPosition = std::prev(m_lru.end());
+        m_totalBytes += entry.bytes;
+        m_entries.insert(key, entry);
+    }
+
+    QStringList completeHours;
+    in >> completeHours;
+    if (in.status() != QDataStream::Ok) {
+        qDebug() << "[Cache] Capture cache index is truncated";
+        return false;
+    }
+    // 항목이 빠진 시간대는 완전하지 않음 (다음 조회 때 서버에서 다시 받음)
+    for (const QString &hour : std::as_const(completeHours)) {
+        if (!incompleteHours.contains(hour)) {
+            m_completeHours.insert(hour);
+        }
+    }
+    return true;
+}
+
+bool CaptureCache::saveIndex()
+{
+    QSaveFile file(QDir(m_directory).filePath(IndexFileName));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "[Cache] Failed to write capture cache index:" << file.errorString();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << IndexMagic << IndexVersion << qint32(m_entries.size());
+    for (const QString &key : m_lru) {
+        const Entry &entry = m_entries[key];
+        out << entry.camera << entry.timestamp << entry.imageFile << entry.thumbnailFile << entry.imageId
+            << entry.logText << entry.detectionType << entry.direction << entry.bytes;
+    }
+    out << QStringList(m_completeHours.values());
+
+    if (!file.commit()) {
+        qDebug() << "[Cache] Failed to write capture cache index:" << file.errorString();
+        return false;
+    }
+    m_indexDirty = false;
+    return true;
+}
@@ -0,0 +1,106 @@
+#ifndef CAPTURECACHE_H
+#define CAPTURECACHE_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <list>
+
+#include "TcpCommunicator.h"
+
+// 캡처 이미지 디스크 캐시 (카메라 + 타임스탬프 단위)
+//
+// 이미지 파일은 directory/<카메라>/ 아래에 두고, 목록은 directory/index.dat에 보관한다.
+// 메모리에는 키 → 항목 해시와 LRU 목록을 두어 조회/갱신이 O(1)이며, 전체 크기가 예산을 넘으면
+// 가장 오래 쓰지 않은 항목부터 지운다. 파일과 목록은 모두 임시 파일에 쓴 뒤 교체(QSaveFile)한다.
+// 목록은 바뀔 때마다 쓰지 않고 변경 표시만 해 두었다가 flush()(주기적 호출)나 close()에서 저장한다.
+//
+// 한 시간 단위로 "서버가 준 이미지를 모두 가지고 있음"을 기록해 두어, 그 시간대는 서버에 묻지 않고
+// 캐시에서 바로 돌려줄 수 있다. 항목이 하나라도 지워지면 그 시간대의 기록도 지운다.
+// 네트워크 스레드(저장)와 GUI 스레드(조회)가 함께 쓰므로 모든 함수는 잠금 안에서 동작한다.
+class CaptureCache
+{
+public:
+    static constexpr qint64 DefaultMaxBytes = 1024LL * 1024 * 1024;
+
+    CaptureCache();
+    ~CaptureCache();
+
+    // directory가 비어 있으면 앱 데이터 위치의 captures 폴더
+    bool open(const QString &directory, qint64 maxBytes = DefaultMaxBytes);
+    void close();
+    bool isOpen() const;
+    // 바뀐 목록이 있으면 index.dat에 저장 (호출하는 쪽에서 주기적으로)
+    bool flush();
+
+    // 서버 하나가 카메라 하나의 캡처를 돌려주므로 카메라는 서버 주소로 구분
+    static QString cameraKey(const QString &host, quint16 port);
+    // 이미지 파일 이름 (캐시 밖 임시 폴더에 저장할 때도 같은 이름)
+    static QString fileName(const QString &timestamp, bool thumbnail);
+
+    // 워커가 이미지를 바로 써 넣을 위치 (닫혀 있으면 빈 문자열 → 호출한 쪽의 임시 경로 사용)
+    QString filePath(const QString &camera, const QString &timestamp, bool thumbnail);
+    // 저장을 마친 이미지 등록 (같은 타임스탬프면 비어 있지 않은 경로/ID만 갱신)
+    void insert(const QString &camera, const QList<ImageData> &images);
+
+    // [start, end) 범위의 캐시된 이미지 (타임스탬프 순, 최근 사용으로 표시)
+    QList<ImageData> images(const QString &camera, const QDateTime &start, const QDateTime &end);
+    // 범위 안에서 완전하지 않은 시간대를 이어 붙인 구간들 (닫혀 있으면 범위 전체)
+    QList<QPair<QDateTime, QDateTime>> missingRanges(const QString &camera, const QDateTime &start,
+                                                     const QDateTime &end) const;
+    bool isComplete(const QString &camera, const QDateTime &start, const QDateTime &end) const;
+    // 서버가 범위 전체(expectedImages장)를 보냈을 때 호출 - 캐시에 모두 남아 있고 이미 지난 시간대만 기록
+    void markComplete(const QString &camera, const QDateTime &start, const QDateTime &end, int expectedImages);
+
+    qint64 totalBytes() const;
+    int entryCount() const;
+
+private:
+    struct Entry {
+        QString camera;
+        QString timestamp;
+        QString imageFile;          // 캐시 디렉터리 기준 상대 경로 (없으면 빈 문자열)
+        QString thumbnailFile;
+        QString imageId;
+        QString logText;
+        QString detectionType;
+        QString direction;
+        QDateTime time;             // 해석한 타임스탬프 (해석하지 못하면 범위 조회에서 빠짐)
+        QString hour;               // 시간대 키 (time이 없으면 빈 문자열)
+        qint64 bytes = 0;
+        std::list<QString>::iterator lruPosition;
+    };
+
+    static QString entryKey(const QString &camera, const QString &timestamp);
+    static QString hourKey(const QString &camera, const QDateTime &hour);
+    static QDateTime parseTimestamp(const QString &timestamp);
+    static QDateTime hourStart(const QDateTime &time);
+
+    QString relativePath(const QString &path) const;
+    qint64 fileSize(const QString &relativePath) const;
+    ImageData toImageData(const Entry &entry) const;
+    void touch(Entry &entry);
+    void removeEntry(const QString &key);
+    // 예산을 넘는 동안 오래된 항목부터 지움 (keep에 있는 항목은 남김)
+    void evictLocked(const QSet<QString> &keep = QSet<QString>());
+    bool loadIndex();
+    bool saveIndex();
+
+    mutable QMutex m_mutex;
+    QString m_directory;
+    qint64 m_maxBytes;
+    qint64 m_totalBytes;
+    bool m_indexDirty;              // 저장하지 않은 목록 변경이 있음 (flush/close에서 기록)
+
+    QHash<QString, Entry> m_entries;
+    std::list<QString> m_lru;               // 앞쪽이 최근에 쓴 항목
+    QHash<QString, QSet<QString>> m_hours;  // 시간대 키 → 항목 키
+    QSet<QString> m_completeHours;
+    QSet<QString> m_cameraDirs;             // 이미 만든 카메라 디렉터리
+};
+
+#endif // CAPTURECACHE_H
@@ -0,0 +1,327 @@
+#include "CborCodec.h"
+#include <QCborMap>
+#include <QCborValue>
+
+namespace {
+bool hasError(const QCborStreamReader &reader)
+{
+    return reader.lastError() != QCborError::NoError;
+}
+
+// map 키 읽기 (문자열이 아닌 키는 건너뛰고 빈 값 반환)
+QByteArray readKey(QCborStreamReader &reader)
+{
+    if (reader.isString()) {
+        return reader.readAllUtf8String();
+    }
+    reader.next();
+    return QByteArray();
+}
+
+// 아래 read* 함수들은 모두 값 하나를 소비한다 (타입이 맞지 않으면 건너뛰고 기본값 반환)
+qint64 readInteger(QCborStreamReader &reader, qint64 defaultValue = 0)
+{
+    if (reader.isString()) {
+        bool ok = false;
+        qint64 parsed = reader.readAllString().toLongLong(&ok);
+        return ok ? parsed : defaultValue;
+    }
+
+    qint64 value = defaultValue;
+    if (reader.isInteger()) {
+        value = reader.toInteger();
+    } else if (reader.isDouble()) {
+        value = static_cast<qint64>(reader.toDouble());
+    } else if (reader.isFloat()) {
+        value = static_cast<qint64>(reader.toFloat());
+    } else if (reader.isFloat16()) {
+        value = static_cast<qint64>(float(reader.toFloat16()));
+    }
+    reader.next();
+    return value;
+}
+
+double readDouble(QCborStreamReader &reader, double defaultValue = 0.0)
+{
+    double value = defaultValue;
+    if (reader.isDouble()) {
+        value = reader.toDouble();
+    } else if (reader.isFloat()) {
+        value = reader.toFloat();
+    } else if (reader.isFloat16()) {
+        value = float(reader.toFloat16());
+    } else if (reader.isInteger()) {
+        value = static_cast<double>(reader.toInteger());
+    }
+    reader.next();
+    return value;
+}
+
+bool readBool(QCborStreamReader &reader, bool defaultValue = false)
+{
+    bool value = reader.isBool() ? reader.toBool() : defaultValue;
+    reader.next();
+    return value;
+}
+
+QString readText(QCborStreamReader &reader)
+{
+    if (reader.isString()) {
+        return reader.readAllString();
+    }
+    reader.next();
+    return QString();
+}
+
+// 객체 타입 이름은 스택 버퍼로 읽어 바로 atom으로 변환 (짧은 이름은 할당 없음)
+quint16 readObjectType(QCborStreamReader &reader)
+{
+    if (!reader.isString()) {
+        reader.next();
+        return ObjectTypes::Unknown;
+    }
+
+    char buffer[64];
+    qsizetype length = 0;
+    while (true) {
+        qsizetype chunkSize = reader.currentStringChunkSize();
+        if (chunkSize < 0 || length + chunkSize > qsizetype(sizeof(buffer))) {
+            break;
+        }
+        auto result = reader.readStringChunk(buffer + length, sizeof(buffer) - length);
+        if (result.status == QCborStreamReader::EndOfString) {
+            return ObjectTypes::intern(QByteArrayView(buffer, length));
+        }
+        if (result.status != QCborStreamReader::Ok) {
+            return ObjectTypes::Unknown;
+        }
+        length += result.data;
+    }
+
+    // 버퍼보다 긴 이름 (드묾): 나머지를 읽어 붙임
+    QByteArray name(buffer, length);
+    auto result = reader.readUtf8String();
+    while (result.status == QCborStreamReader::Ok) {
+        name += result.data;
+        result = reader.readUtf8String();
+    }
+    return result.status == QCborStreamReader::EndOfString ? ObjectTypes::intern(name) : ObjectTypes::Unknown;
+}
+
+// map의 키마다 handler(key) 호출 - handler는 값 하나를 반드시 소비해야 함
+template <typename Handler>
+bool readMap(QCborStreamReader &reader, Handler handler)
+{
+    if (!reader.isMap()) {
+        reader.next();
+        return false;
+    }
+
+    reader.enterContainer();
+    while (!hasError(reader) && reader.hasNext()) {
+        QByteArray key = readKey(reader);
+        if (hasError(reader)) {
+            break;
+        }
+        handler(key);
+    }
+    if (!hasError(reader)) {
+        reader.leaveContainer();
+    }
+    return !hasError(reader);
+}
+
+// 배열 원소마다 handler() 호출 - handler는 원소 하나를 반드시 소비해야 함
+template <typename Handler>
+bool readArray(QCborStreamReader &reader, Handler handler)
+{
+    if (!reader.isArray()) {
+        reader.next();
+        return false;
+    }
+
+    reader.enterContainer();
+    while (!hasError(reader) && reader.hasNext()) {
+        handler();
+    }
+    if (!hasError(reader)) {
+        reader.leaveContainer();
+    }
+    return !hasError(reader);
+}
+}
+
+bool CborCodec::isCborFrame(QByteArrayView frame)
+{
+    return !frame.isEmpty() && (static_cast<uchar>(frame.front()) & 0xE0) == 0xA0;
+}
+
+int CborCodec::peekMessageId(QByteArrayView frame, quint64 *seq)
+{
+    QCborStreamReader reader(frame.data(), frame.size());
+
+    qint64 requestId = 0;
+    qint64 responseId = 0;
+    readMap(reader, [&](const QByteArray &key) {
+        if (key == "request_id") {
+            requestId = readInteger(reader);
+        } else if (key == "response_id") {
+            responseId = readInteger(reader);
+        } else if (key == "seq") {
+            qint64 value = readInteger(reader);
+            if (seq) {
+                *seq = static_cast<quint64>(value);
+            }
+        } else {
+            reader.next();
+        }
+    });
+
+    // JSON 경로와 같이 request_id가 없으면 response_id 사용
+    return static_cast<int>(requestId != 0 ? requestId : responseId);
+}
+
+bool CborCodec::readBBoxFrame(QCborStreamReader &reader, BBoxFrame &frame)
+{
+    return readMap(reader, [&](const QByteArray &key) {
+        if (key == "timestamp") {
+            frame.timestamp = readInteger(reader, frame.timestamp);
+        } else if (key == "bboxes") {
+            readArray(reader, [&]() {
+                BBox bbox{0, ObjectTypes::Unknown, 0.0f, QRect()};
+                int x = 0, y = 0, width = 0, height = 0;
+                readMap(reader, [&](const QByteArray &field) {
+                    if (field == "id") bbox.object_id = static_cast<int>(readInteger(reader));
+                    else if (field == "type") bbox.type = readObjectType(reader);
+                    else if (field == "confidence") bbox.confidence = static_cast<float>(readDouble(reader));
+                    else if (field == "x") x = static_cast<int>(readInteger(reader));
+                    else if (field == "y") y = static_cast<int>(readInteger(reader));
+                    else if (field == "width") width = static_cast<int>(readInteger(reader));
+                    else if (field == "height") height = static_cast<int>(readInteger(reader));
+                    else reader.next();
+                });
+                bbox.rect = QRect(x, y, width, height);
+                frame.boxes.append(bbox);
+            });
+        } else {
+            reader.next();
+        }
+    });
+}
+
+bool CborCodec::readRoadLines(QCborStreamReader &reader, QList<RoadLineData> &roadLines)
+{
+    return readMap(reader, [&](const QByteArray &key) {
+        if (key != "data") {
+            reader.next();
+            return;
+        }
+        readArray(reader, [&]() {
+            RoadLineData line{0, 0, 0, 0, 0, 0, 0};
+            readMap(reader, [&](const QByteArray &field) {
+                if (field == "index") line.index = static_cast<int>(readInteger(reader));
+                else if (field == "matrixNum1") line.matrixNum1 = static_cast<int>(readInteger(reader));
+                else if (field == "x1") line.x1 = static_cast<int>(readInteger(reader));
+                else if (field == "y1") line.y1 = static_cast<int>(readInteger(reader));
+                else if (field == "matrixNum2") line.matrixNum2 = static_cast<int>(readInteger(reader));
+                else if (field == "x2") line.x2 = static_cast<int>(readInteger(reader));
+                else if (field == "y2") line.y2 = static_cast<int>(readInteger(reader));
+                else reader.next();
+            });
+            roadLines.append(line);
+        });
+    });
+}
+
+bool CborCodec::readDetectionLines(QCborStreamReader &reader, QList<DetectionLineData> &detectionLines)
+{
+    return readMap(reader, [&](const QByteArray &key) {
+        if (key != "data") {
+            reader.next();
+            return;
+        }
+        readArray(reader, [&]() {
+            DetectionLineData line{0, 0, 0, 0, 0, QString(), QString(), 0, 0};
+            readMap(reader, [&](const QByteArray &field) {
+                if (field == "index") line.index = static_cast<int>(readInteger(reader));
+                else if (field == "x1") line.x1 = static_cast<int>(readInteger(reader));
+                else if (field == "y1") line.y1 = static_cast<int>(readInteger(reader));
+                else if (field == "x2") line.x2 = static_cast<int>(readInteger(reader));
+                else if (field == "y2") line.y2 = static_cast<int>(readInteger(reader));
+                else if (field == "name") line.name = readText(reader);
+                else if (field == "mode") line.mode = readText(reader);
+                else if (field == "leftMatrixNum") line.leftMatrixNum = static_cast<int>(readInteger(reader));
+                else if (field == "rightMatrixNum") line.rightMatrixNum = static_cast<int>(readInteger(reader));
+                else reader.next();
+            });
+            detectionLines.append(line);
+        });
+    });
+}
+
+bool CborCodec::readImages(QCborStreamReader &reader, const ImageCallback &callback, quint64 *seq, ImagePage *page)
+{
+    return readMap(reader, [&](const QByteArray &key) {
+        if (key == "seq") {
+            qint64 value = readInteger(reader);
+            if (seq) {
+                *seq = static_cast<quint64>(value);
+            }
+            return;
+        }
+        if (page && key == "next_cursor") {
+            page->nextCursor = readText(reader);
+            return;
+        }
+        if (page && key == "total") {
+            page->total = static_cast<int>(readInteger(reader));
+            return;
+        }
+        if (key != "data") {
+            reader.next();
+            return;
+        }
+
+        readArray(reader, [&]() {
+            ImageEntry entry;
+            bool hasImage = false;
+            bool hasTimestamp = false;
+
+            readMap(reader, [&](const QByteArray &field) {
+                if (field == "image" && reader.isByteArray()) {
+                    entry.image = reader.readAllByteArray();
+                    hasImage = true;
+                } else if (field == "image" && reader.isString()) {
+                    entry.image = reader.readAllUtf8String();
+                    entry.isBase64 = true;
+                    hasImage = true;
+                } else if (field == "timestamp") {
+                    entry.timestamp = readText(reader);
+                    hasTimestamp = true;
+                } else if (field == "image_id") {
+                    // 서버에 따라 정수 ID
+                    entry.imageId = reader.isString() ? readText(reader) : QString::number(readInteger(reader));
+                } else if (field == "thumbnail") {
+                    entry.thumbnail = readBool(reader);
+                } else {
+                    reader.next();
+                }
+            });
+
+            if (hasImage && hasTimestamp) {
+                callback(entry);
+            }
+        });
+    });
+}
+
+QJsonObject CborCodec::toJsonObject(QByteArrayView frame)
+{
+    QCborValue value = QCborValue::fromCbor(QByteArray::fromRawData(frame.data(), frame.size()));
+    return value.toMap().toJsonObject();
+}
+
+QByteArray CborCodec::encode(const QJsonObject &message)
+{
+    return QCborMap::fromJsonObject(message).toCborValue().toCbor();
+}
@@ -0,0 +1,50 @@
+#ifndef CBORCODEC_H
+#define CBORCODEC_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QCborStreamReader>
+#include <QJsonObject>
+#include <QList>
+#include <functional>
+
+#include "TcpCommunicator.h"
+
+// 서버와 CBOR 인코딩을 합의했을 때 사용하는 메시지 코덱
+// 수신 메시지는 QCborStreamReader로 바로 읽어 구조체로 변환하며, QCborValue/QJsonObject 같은
+// 중간 트리를 만들지 않는다. 스키마는 JSON과 같고(키 이름, 구조 동일) 이미지만 byte string도 허용한다.
+class CborCodec
+{
+public:
+    // 프레임 첫 바이트로 인코딩 판별 (CBOR map: 0xA0~0xBF, JSON은 '{')
+    static bool isCborFrame(QByteArrayView frame);
+
+    // 1단계: 최상위 map에서 request_id/response_id와 seq만 확인 (나머지 값은 건너뜀)
+    static int peekMessageId(QByteArrayView frame, quint64 *seq = nullptr);
+
+    // 2단계: 메시지 타입별 디코딩 (reader는 메시지 시작 위치)
+    static bool readBBoxFrame(QCborStreamReader &reader, BBoxFrame &frame);
+    static bool readRoadLines(QCborStreamReader &reader, QList<RoadLineData> &roadLines);
+    static bool readDetectionLines(QCborStreamReader &reader, QList<DetectionLineData> &detectionLines);
+
+    // 이미지는 하나씩 콜백으로 넘김 (image가 byte string이면 원본, text면 base64)
+    // page에는 다음 페이지 cursor와 total만 채움 (이미지는 콜백을 받은 쪽이 모음)
+    struct ImageEntry {
+        QByteArray image;
+        bool isBase64 = false;
+        QString timestamp;
+        QString imageId;
+        bool thumbnail = false;     // 요청한 thumbnail_size로 줄인 이미지
+    };
+    using ImageCallback = std::function<void(const ImageEntry &entry)>;
+    static bool readImages(QCborStreamReader &reader, const ImageCallback &callback, quint64 *seq = nullptr,
+                           ImagePage *page = nullptr);
+
+    // 빈도가 낮은 그 밖의 메시지는 기존 JSON 처리 경로로 넘김
+    static QJsonObject toJsonObject(QByteArrayView frame);
+
+    // 송신 메시지 인코딩
+    static QByteArray encode(const QJsonObject &message);
+};
+
+#endif // CBORCODEC_H
@@ -0,0 +1,229 @@
+#include "DiagnosticsDialog.h"
+#include "TcpCommunicator.h"
+#include "EventLoopWatchdog.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QPushButton>
+
+namespace {
+// 표에 보여 줄 처리 시간 (평균 / p95)
+constexpr NetworkMetrics::Timing TimingColumns[] = {
+    NetworkMetrics::DecodeTime,
+    NetworkMetrics::HandlerTime,
+    NetworkMetrics::QueueWait,
+    NetworkMetrics::ResponseLatency,
+};
+}
+
+DiagnosticsDialog::DiagnosticsDialog(TcpCommunicator *tcpCommunicator, QWidget *parent)
+    : QDialog(parent)
+    , m_tcpCommunicator(tcpCommunicator)
+    , m_summaryLabel(nullptr)
+    , m_lanesLabel(nullptr)
+    , m_stallsLabel(nullptr)
+    , m_table(nullptr)
+    , m_refreshTimer(new QTimer(this))
+{
+    setupUI();
+    setWindowTitle("네트워크 진단");
+    resize(980, 520);
+
+    m_refreshTimer->setInterval(1000);
+    connect(m_refreshTimer, &QTimer::timeout, this, &DiagnosticsDialog::refresh);
+}
+
+DiagnosticsDialog::~DiagnosticsDialog()
+{
+}
+
+void DiagnosticsDialog::setupUI()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    QLabel *titleLabel = new QLabel("Network Diagnostics");
+    titleLabel->setStyleSheet("font-size: 16pt; font-weight: bold; color: #F37321; padding: 5px;");
+    mainLayout->addWidget(titleLabel);
+
+    m_summaryLabel = new QLabel();
+    m_lanesLabel = new QLabel();
+    mainLayout->addWidget(m_summaryLabel);
+    mainLayout->addWidget(m_lanesLabel);
+
+    // 메시지 타입별 표 (시간은 평균 / p95)
+    QStringList headers{ "ID", "In frames", "In bytes", "Out frames", "Out bytes" };
+    headers << "Decode" << "Handler" << "Queue wait" << "Latency";
+    m_table = new QTableWidget(0, headers.size());
+    m_table->setHorizontalHeaderLabels(headers);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionMode(QAbstractItemView::NoSelection);
+    m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    mainLayout->addWidget(m_table);
+
+    // GUI 이벤트 루프 멈춤 (EventLoopWatchdog)
+    m_stallsLabel = new QLabel();
+    m_stallsLabel->setWordWrap(true);
+    m_stallsLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    mainLayout->addWidget(m_stallsLabel);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    QPushButton *resetButton = new QPushButton("통계 초기화");
+    QPushButton *closeButton = new QPushButton("닫기");
+    resetButton->setStyleSheet("QPushButton { padding: 8px 16px; border: none; border-radius: 4px; font-weight: bold; background-color: #837F7D; color: white; }");
+    closeButton->setStyleSheet("QPushButton { padding: 8px 16px; border: none; border-radius: 4px; font-weight: bold; background-color: #F37321; color: white; }");
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(resetButton);
+    buttonLayout->addWidget(closeButton);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(resetButton, &QPushButton::clicked, this, &DiagnosticsDialog::onResetClicked);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::close);
+}
+
+void DiagnosticsDialog::showEvent(QShowEvent *event)
+{
+    QDialog::showEvent(event);
+    refresh();
+    m_refreshTimer->start();
+}
+
+void DiagnosticsDialog::hideEvent(QHideEvent *event)
+{
+    // 보이지 않을 때는 통계를 읽지 않음
+    m_refreshTimer->stop();
+    QDialog::hideEvent(event);
+}
+
+void DiagnosticsDialog::onResetClicked()
+{
+    if (m_tcpCommunicator) {
+        m_tcpCommunicator->resetNetworkMetrics();
+    }
+    if (EventLoopWatchdog *watchdog = EventLoopWatchdog::instance()) {
+        watchdog->reset();
+    }
+    refresh();
+}
+
+void DiagnosticsDialog::refresh()
+{
+    refreshStalls();
+    if (!m_tcpCommunicator) {
+        return;
+    }
+
+    static const char *stateNames[] = { "Idle", "Resolving", "Connecting", "TLS handshake", "Authenticated", "Draining" };
+    int state = static_cast<int>(m_tcpCommunicator->connectionState());
+    m_summaryLabel->setText(QString("상태: %1 · RTT %2 ms · 지터 %3 ms · 대기 중 요청 %4")
+                                .arg(stateNames[state])
+                                .arg(m_tcpCommunicator->rttMs())
+                                .arg(m_tcpCommunicator->jitterMs())
+                                .arg(m_tcpCommunicator->pendingRequestCount()));
+
+    static const char *laneNames[] = { "Control", "Interactive", "Bulk" };
+    QStringList lanes;
+    for (int lane = 0; lane < 3; ++lane) {
+        OutboundLaneMetrics metrics = m_tcpCommunicator->outboundLaneMetrics(static_cast<MessagePriority>(lane));
+        lanes << QString("%1: 대기 %2개(%3), 최대 %4 ms")
+                     .arg(laneNames[lane])
+                     .arg(metrics.queuedMessages)
+                     .arg(formatBytes(quint64(metrics.queuedBytes)))
+                     .arg(metrics.maxWaitMs);
+    }
+    m_lanesLabel->setText("송신 레인 - " + lanes.join(" · "));
+
+    const QList<NetworkMetrics::MessageTypeSnapshot> entries = m_tcpCommunicator->networkMetrics().snapshot();
+    m_table->setRowCount(entries.size());
+    for (int row = 0; row < entries.size(); ++row) {
+        const NetworkMetrics::MessageTypeSnapshot &entry = entries[row];
+        QStringList cells{
+            entry.messageId < 0 ? QString("other") : QString::number(entry.messageId),
+            QString::number(entry.framesIn),
+            formatBytes(entry.bytesIn),
+            QString::number(entry.framesOut),
+            formatBytes(entry.bytesOut),
+        };
+        for (NetworkMetrics::Timing timing : TimingColumns) {
+            const NetworkMetrics::TimingSnapshot &summary = entry.timings[timing];
+            cells << (summary.count == 0 ? QString("-")
+                                         : QString("%1 / %2").arg(formatMicros(summary.averageUs), formatMicros(summary.p95Us)));
+        }
+
+        for (int column = 0; column < cells.size(); ++column) {
+            QTableWidgetItem *item = m_table->item(row, column);
+            if (!item) {
+                item = new QTableWidgetItem();
+                item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+                m_table->setItem(row, column, item);
+            }
+            item->setText(cells[column]);
+        }
+    }
+}
+
+void DiagnosticsDialog::refreshStalls()
+{
+    EventLoopWatchdog *watchdog = EventLoopWatchdog::instance();
+    if (!watchdog) {
+        m_stallsLabel->setText("GUI 멈춤 감시 꺼짐");
+        return;
+    }
+
+    // 분포: threshold 배수 구간별 횟수
+    QStringList buckets;
+    const std::array<quint64, EventLoopWatchdog::BucketCount> histogram = watchdog->histogram();
+    qint64 lower = watchdog->thresholdMs();
+    for (int i = 0; i < EventLoopWatchdog::BucketCount; ++i) {
+        qint64 upper = watchdog->bucketUpperBound(i);
+        if (histogram[i] > 0) {
+            buckets << (upper < 0 ? QString("%1+ ms: %2").arg(lower).arg(histogram[i])
+                                  : QString("%1-%2 ms: %3").arg(lower).arg(upper).arg(histogram[i]));
+        }
+        lower = upper;
+    }
+
+    QStringList offenders;
+    const QList<EventLoopWatchdog::Offender> worst = watchdog->worstOffenders();
+    for (int i = 0; i < qMin<qsizetype>(worst.size(), 5); ++i) {
+        const EventLoopWatchdog::Offender &offender = worst[i];
+        offenders << QString("%1 — %2회, 합계 %3 ms, 최대 %4 ms")
+                         .arg(offender.activity).arg(offender.count).arg(offender.totalMs).arg(offender.maxMs);
+    }
+
+    QString text = QString("GUI 멈춤 (%1 ms 이상): %2회").arg(watchdog->thresholdMs()).arg(watchdog->stallCount());
+    if (!buckets.isEmpty()) {
+        text += " · " + buckets.join(", ");
+    }
+    const QList<EventLoopWatchdog::Stall> recent = watchdog->recentStalls();
+    if (!recent.isEmpty()) {
+        const EventLoopWatchdog::Stall &last = recent.last();
+        text += QString("\n최근: %1 %2 ms - %3%4")
+                    .arg(last.startedAt.toString("HH:mm:ss.zzz"))
+                    .arg(last.durationMs)
+                    .arg(last.activity, last.nestedLoop ? " (중첩 이벤트 루프)" : "");
+    }
+    if (!offenders.isEmpty()) {
+        text += "\n" + offenders.join("\n");
+    }
+    m_stallsLabel->setText(text);
+}
+
+QString DiagnosticsDialog::formatBytes(quint64 bytes)
+{
+    if (bytes >= 1024 * 1024) {
+        return QString::number(bytes / (1024.0 * 1024.0), 'f', 1) + " MB";
+    }
+    if (bytes >= 1024) {
+        return QString::number(bytes / 1024.0, 'f', 1) + " KB";
+    }
+    return QString::number(bytes) + " B";
+}
+
+QString DiagnosticsDialog::formatMicros(qint64 usecs)
+{
+    if (usecs >= 1000) {
+        return QString::number(usecs / 1000.0, 'f', 1) + " ms";
+    }
+    return QString::number(usecs) + " µs";
+}
@@ -0,0 +1,43 @@
+#ifndef DIAGNOSTICSDIALOG_H
+#define DIAGNOSTICSDIALOG_H
+
+#include <QDialog>
+#include <QLabel>
+#include <QTableWidget>
+#include <QTimer>
+
+class TcpCommunicator;
+
+// 네트워크 진단 창 (Ctrl+Shift+D)
+// 메시지 타입별 송수신량과 처리 시간, 송신 레인, RTT, GUI 멈춤 기록을 1초마다 갱신해 보여준다.
+class DiagnosticsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit DiagnosticsDialog(TcpCommunicator *tcpCommunicator, QWidget *parent = nullptr);
+    ~DiagnosticsDialog();
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    void refresh();
+    void onResetClicked();
+
+private:
+    void setupUI();
+    void refreshStalls();
+    static QString formatBytes(quint64 bytes);
+    static QString formatMicros(qint64 usecs);
+
+    TcpCommunicator *m_tcpCommunicator;
+    QLabel *m_summaryLabel;
+    QLabel *m_lanesLabel;
+    QLabel *m_stallsLabel;
+    QTableWidget *m_table;
+    QTimer *m_refreshTimer;
+};
+
+#endif // DIAGNOSTICSDIALOG_H
@@ -0,0 +1,306 @@
+#include "EventLoopWatchdog.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QEvent>
+#include <QJsonArray>
+#include <QMetaEnum>
+#include <algorithm>
+
+namespace {
+std::atomic<EventLoopWatchdog *> s_instance{ nullptr };
+}
+
+EventLoopWatchdog::Scope::Scope(const char *name)
+    : m_name(name)
+    , m_previous(nullptr)
+    , m_startedAt(0)
+    , m_active(false)
+{
+    EventLoopWatchdog *watchdog = s_instance.load(std::memory_order_acquire);
+    if (!watchdog || QThread::currentThread() != watchdog->thread()) {
+        return;
+    }
+    m_active = true;
+    m_previous = watchdog->m_scope.exchange(name, std::memory_order_relaxed);
+    m_startedAt = watchdog->m_clock.elapsed();
+}
+
+EventLoopWatchdog::Scope::~Scope()
+{
+    EventLoopWatchdog *watchdog = s_instance.load(std::memory_order_acquire);
+    if (!m_active || !watchdog) {
+        return;
+    }
+    watchdog->m_scope.store(m_previous, std::memory_order_relaxed);
+
+    qint64 elapsedMs = watchdog->m_clock.elapsed() - m_startedAt;
+    if (elapsedMs >= watchdog->m_thresholdMs) {
+        watchdog->scopeFinished(m_name, m_startedAt, elapsedMs);
+    }
+}
+
+EventLoopWatchdog::EventLoopWatchdog(int thresholdMs, QObject *parent)
+    : QObject(parent)
+    , m_thresholdMs(qMax(10, thresholdMs))
+    , m_tickMs(qMax(5, thresholdMs / 4))
+    , m_stopping(false)
+    , m_beatSentAt(0)
+    , m_beatAnsweredAt(0)
+    , m_inStall(false)
+    , m_scope(nullptr)
+    , m_eventClass(nullptr)
+    , m_eventType(0)
+    , m_stallCount(0)
+{
+    m_buckets.fill(0);
+    m_clock.start();
+}
+
+EventLoopWatchdog::~EventLoopWatchdog()
+{
+    stop();
+}
+
+EventLoopWatchdog *EventLoopWatchdog::instance()
+{
+    return s_instance.load(std::memory_order_acquire);
+}
+
+void EventLoopWatchdog::start()
+{
+    if (m_thread) {
+        return;
+    }
+
+    qDebug() << "[Watchdog] GUI event loop watchdog started - threshold:" << m_thresholdMs << "ms";
+
+    // 어떤 객체가 이벤트를 받는 중인지 기록 (GUI 스레드 이벤트만 들어옴)
+    QCoreApplication::instance()->installEventFilter(this);
+    s_instance.store(this, std::memory_order_release);
+
+    m_stopping = false;
+    m_beatSentAt = m_clock.elapsed();
+    m_beatAnsweredAt = m_beatSentAt;
+    m_thread.reset(QThread::create([this]() { run(); }));
+    m_thread->setObjectName("EventLoopWatchdog");
+    m_thread->start();
+}
+
+void EventLoopWatchdog::stop()
+{
+    if (!m_thread) {
+        return;
+    }
+
+    m_stopping = true;
+    m_thread->wait();
+    m_thread.reset();
+
+    s_instance.store(nullptr, std::memory_order_release);
+    if (QCoreApplication::instance()) {
+        QCoreApplication::instance()->removeEventFilter(this);
+    }
+}
+
+bool EventLoopWatchdog::eventFilter(QObject *watched, QEvent *event)
+{
+    // 클래스 이름은 정적 문자열이므로 객체가 사라져도 안전
+    m_eventClass.store(watched->metaObject()->className(), std::memory_order_relaxed);
+    m_eventType.store(event->type(), std::memory_order_relaxed);
+    return false;
+}
+
+void EventLoopWatchdog::run()
+{
+    while (!m_stopping) {
+        QThread::msleep(m_tickMs);
+        tick();
+    }
+}
+
+void EventLoopWatchdog::tick()
+{
+    qint64 now = m_clock.elapsed();
+    qint64 answeredAt = m_beatAnsweredAt.load(std::memory_order_acquire);
+
+    if (answeredAt >= m_beatSentAt) {
+        qint64 latencyMs = answeredAt - m_beatSentAt;
+        if (m_inStall || latencyMs >= m_thresholdMs) {
+            Stall stall;
+            stall.startedAt = m_beatSentWall;
+            stall.durationMs = latencyMs;
+            stall.activity = m_inStall ? m_stallActivity : currentActivity();
+            recordStall(stall);
+            m_inStall = false;
+        }
+        sendBeat();
+        return;
+    }
+
+    // 아직 멈춰 있는 동안 무엇을 처리 중인지 잡아 둠 (풀린 뒤에는 이미 다른 일을 하고 있음)
+    if (!m_inStall && now - m_beatSentAt >= m_thresholdMs) {
+        m_inStall = true;
+        m_stallActivity = currentActivity();
+    }
+}
+
+void EventLoopWatchdog::sendBeat()
+{
+    m_beatSentAt = m_clock.elapsed();
+    m_beatSentWall = QDateTime::currentDateTime();
+
+    // this를 문맥으로 주면 GUI 스레드에서 실행되고, 감시자가 먼저 삭제되면 버려짐
+    QMetaObject::invokeMethod(this, [this]() {
+        m_beatAnsweredAt.store(m_clock.elapsed(), std::memory_order_release);
+    }, Qt::QueuedConnection);
+}
+
+QString EventLoopWatchdog::currentActivity() const
+{
+    if (const char *scope = m_scope.load(std::memory_order_relaxed)) {
+        return QString::fromLatin1(scope);
+    }
+
+    const char *className = m_eventClass.load(std::memory_order_relaxed);
+    if (!className) {
+        return QStringLiteral("unknown");
+    }
+    int type = m_eventType.load(std::memory_order_relaxed);
+    const char *typeName = QMetaEnum::fromType<QEvent::Type>().valueToKey(type);
+    return QString("%1 (%2)").arg(QString::fromLatin1(className),
+                                  typeName ? QString::fromLatin1(typeName) : QString::number(type));
+}
+
+void EventLoopWatchdog::scopeFinished(const char *name, qint64 startedAt, qint64 elapsedMs)
+{
+    // 구간 도중 beat가 처리되었다면 중첩 이벤트 루프 - 그렇지 않으면 감시 스레드가 멈춤으로 기록함
+    if (m_beatAnsweredAt.load(std::memory_order_acquire) <= startedAt) {
+        return;
+    }
+
+    Stall stall;
+    stall.startedAt = QDateTime::currentDateTime().addMSecs(-elapsedMs);
+    stall.durationMs = elapsedMs;
+    stall.activity = QString::fromLatin1(name);
+    stall.nestedLoop = true;
+    recordStall(stall);
+}
+
+void EventLoopWatchdog::recordStall(const Stall &stall)
+{
+    qWarning() << "[Watchdog]" << (stall.nestedLoop ? "GUI thread held in nested loop for" : "GUI event loop stalled for")
+               << stall.durationMs << "ms -" << stall.activity;
+
+    QMutexLocker locker(&m_mutex);
+    m_stallCount++;
+
+    int bucket = 0;
+    while (bucket < BucketCount - 1 && stall.durationMs >= bucketUpperBound(bucket)) {
+        ++bucket;
+    }
+    m_buckets[bucket]++;
+
+    m_recent.append(stall);
+    if (m_recent.size() > RecentLimit) {
+        m_recent.removeFirst();
+    }
+
+    Offender &offender = m_offenders[stall.activity];
+    offender.activity = stall.activity;
+    offender.count++;
+    offender.totalMs += stall.durationMs;
+    offender.maxMs = qMax(offender.maxMs, stall.durationMs);
+}
+
+qint64 EventLoopWatchdog::bucketUpperBound(int bucket) const
+{
+    if (bucket >= BucketCount - 1) {
+        return -1;
+    }
+    return qint64(m_thresholdMs) << (bucket + 1);
+}
+
+quint64 EventLoopWatchdog::stallCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stallCount;
+}
+
+QList<EventLoopWatchdog::Stall> EventLoopWatchdog::recentStalls() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_recent;
+}
+
+QList<EventLoopWatchdog::Offender> EventLoopWatchdog::worstOffenders() const
+{
+    QList<Offender> offenders;
+    {
+        QMutexLocker locker(&m_mutex);
+        offenders = m_offenders.values();
+    }
+    std::sort(offenders.begin(), offenders.end(), [](const Offender &a, const Offender &b) {
+        return a.totalMs > b.totalMs;
+    });
+    if (offenders.size() > OffenderLimit) {
+        offenders.resize(OffenderLimit);
+    }
+    return offenders;
+}
+
+std::array<quint64, EventLoopWatchdog::BucketCount> EventLoopWatchdog::histogram() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_buckets;
+}
+
+void EventLoopWatchdog::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_stallCount = 0;
+    m_buckets.fill(0);
+    m_recent.clear();
+    m_offenders.clear();
+}
+
+QJsonObject EventLoopWatchdog::toJson() const
+{
+    QJsonArray histogramArray;
+    const std::array<quint64, BucketCount> buckets = histogram();
+    for (int i = 0; i < BucketCount; ++i) {
+        histogramArray.append(QJsonObject{
+            { "upper_ms", bucketUpperBound(i) },
+            { "count", qint64(buckets[i]) },
+        });
+    }
+
+    QJsonArray offenderArray;
+    const QList<Offender> offenders = worstOffenders();
+    for (const Offender &offender : offenders) {
+        offenderArray.append(QJsonObject{
+            { "activity", offender.activity },
+            { "count", offender.count },
+            { "total_ms", offender.totalMs },
+            { "max_ms", offender.maxMs },
+        });
+    }
+
+    QJsonArray recentArray;
+    const QList<Stall> recent = recentStalls();
+    for (const Stall &stall : recent) {
+        recentArray.append(QJsonObject{
+            { "started_at", stall.startedAt.toString(Qt::ISODateWithMs) },
+            { "duration_ms", stall.durationMs },
+            { "activity", stall.activity },
+            { "nested_loop", stall.nestedLoop },
+        });
+    }
+
+    return QJsonObject{
+        { "threshold_ms", m_thresholdMs },
+        { "stalls", qint64(stallCount()) },
+        { "histogram", histogramArray },
+        { "worst", offenderArray },
+        { "recent", recentArray },
+    };
+}
@@ -0,0 +1,119 @@
+#ifndef EVENTLOOPWATCHDOG_H
+#define EVENTLOOPWATCHDOG_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+#include <array>
+#include <atomic>
+#include <memory>
+
+// GUI 이벤트 루프 멈춤 감시
+//
+// 감시 스레드가 주기적으로 GUI 스레드에 빈 호출(beat)을 보내고, 응답이 threshold 이상 늦으면 멈춤으로 기록한다.
+// 멈춘 동안 GUI 스레드가 처리 중이던 것은 두 가지로 파악한다.
+//  - WATCHDOG_SCOPE("...")로 표시한 구간의 이름 (가장 안쪽 구간)
+//  - 표시가 없으면 애플리케이션 이벤트 필터가 본 마지막 이벤트 (받는 객체의 클래스와 이벤트 타입)
+// 표시한 구간이 threshold 이상 걸렸지만 그동안 beat가 처리되었다면 (모달 exec() 같은 중첩 이벤트 루프)
+// 루프는 돌았으므로 멈춤과 구분해 nestedLoop로 기록한다.
+class EventLoopWatchdog : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int BucketCount = 8;       // threshold ×1, ×2, ×4 ... 단위, 마지막 버킷은 그 이상
+    static constexpr int RecentLimit = 32;
+    static constexpr int OffenderLimit = 10;
+
+    struct Stall {
+        QDateTime startedAt;
+        qint64 durationMs = 0;
+        QString activity;
+        bool nestedLoop = false;    // 이벤트 루프는 돌았지만 표시한 구간이 오래 걸림
+    };
+
+    struct Offender {
+        QString activity;
+        int count = 0;
+        qint64 totalMs = 0;
+        qint64 maxMs = 0;
+    };
+
+    // 구간 표시 (GUI 스레드에서만 의미가 있으며, 다른 스레드에서는 아무것도 하지 않음)
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name);
+        ~Scope();
+
+    private:
+        const char *m_name;
+        const char *m_previous;
+        qint64 m_startedAt;
+        bool m_active;
+    };
+
+    explicit EventLoopWatchdog(int thresholdMs = 100, QObject *parent = nullptr);
+    ~EventLoopWatchdog();
+
+    // 실행 중인 감시자 (없으면 nullptr)
+    static EventLoopWatchdog *instance();
+
+    void start();
+    void stop();
+    int thresholdMs() const { return m_thresholdMs; }
+
+    quint64 stallCount() const;
+    QList<Stall> recentStalls() const;
+    QList<Offender> worstOffenders() const;     // 누적 시간 순
+    std::array<quint64, BucketCount> histogram() const;
+    qint64 bucketUpperBound(int bucket) const;  // 마지막 버킷은 -1 (상한 없음)
+    QJsonObject toJson() const;
+    void reset();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    void run();
+    void tick();
+    void sendBeat();
+    QString currentActivity() const;
+    void recordStall(const Stall &stall);
+    void scopeFinished(const char *name, qint64 startedAt, qint64 elapsedMs);
+
+    const int m_thresholdMs;
+    const int m_tickMs;
+    QElapsedTimer m_clock;                      // 두 스레드가 함께 읽는 단조 시계
+    std::unique_ptr<QThread> m_thread;
+    std::atomic<bool> m_stopping;
+
+    // beat 상태 (보내는 쪽은 감시 스레드, 받는 쪽은 GUI 스레드)
+    qint64 m_beatSentAt;
+    QDateTime m_beatSentWall;
+    std::atomic<qint64> m_beatAnsweredAt;
+    bool m_inStall;
+    QString m_stallActivity;
+
+    // GUI 스레드가 지금 처리 중인 것
+    std::atomic<const char *> m_scope;
+    std::atomic<const char *> m_eventClass;
+    std::atomic<int> m_eventType;
+
+    // 기록 (드물게 갱신되므로 잠금 사용)
+    mutable QMutex m_mutex;
+    quint64 m_stallCount;
+    std::array<quint64, BucketCount> m_buckets;
+    QList<Stall> m_recent;
+    QHash<QString, Offender> m_offenders;
+};
+
+// 오래 걸릴 수 있는 GUI 스레드 구간 표시 (함수당 하나)
+#define WATCHDOG_SCOPE(name) EventLoopWatchdog::Scope watchdogScope(name)
+
+#endif // EVENTLOOPWATCHDOG_H
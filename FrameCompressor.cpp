@@ -0,0 +1,184 @@
+#include "FrameCompressor.h"
+#include <QtEndian>
+#include <zlib.h>
+
+FrameCompressor::FrameCompressor(int level)
+    : m_level(level)
+    , m_deflateReady(false)
+    , m_inflateReady(false)
+{
+}
+
+FrameCompressor::~FrameCompressor()
+{
+    if (m_deflateReady) {
+        deflateEnd(m_deflate.get());
+    }
+    if (m_inflateReady) {
+        inflateEnd(m_inflate.get());
+    }
+}
+
+bool FrameCompressor::compress(QByteArrayView input, QByteArray &output)
+{
+    m_errorString.clear();
+    if (input.size() > qsizetype(0xFFFFFFFFu)) {
+        return setError("Frame too large to compress");
+    }
+    if (!ensureDeflate()) {
+        return false;
+    }
+
+    z_stream &stream = *m_deflate;
+    uLong bound = deflateBound(&stream, uLong(input.size()));
+    output.resize(SizePrefixSize + qsizetype(bound));
+    qToBigEndian(quint32(input.size()), output.data());
+
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+    stream.avail_in = uInt(input.size());
+    stream.next_out = reinterpret_cast<Bytef *>(output.data() + SizePrefixSize);
+    stream.avail_out = uInt(bound);
+    int result = deflate(&stream, Z_FINISH);
+    qsizetype written = qsizetype(stream.total_out);
+    deflateReset(&stream);
+
+    if (result != Z_STREAM_END) {
+        return setError(QString("zlib deflate failed (%1)").arg(result));
+    }
+    output.resize(SizePrefixSize + written);
+    return true;
+}
+
+qint64 FrameCompressor::uncompressedSize(QByteArrayView frame)
+{
+    if (frame.size() < SizePrefixSize) {
+        return -1;
+    }
+    return qFromBigEndian<quint32>(frame.data());
+}
+
+bool FrameCompressor::decompress(QByteArrayView frame, QByteArray &output)
+{
+    m_errorString.clear();
+    qint64 expected = uncompressedSize(frame);
+    if (expected < 0) {
+        return setError(QString("Compressed frame is too short: %1 bytes").arg(frame.size()));
+    }
+    if (!ensureInflate()) {
+        return false;
+    }
+
+    output.resize(expected);
+    z_stream &stream = *m_inflate;
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(frame.data() + SizePrefixSize));
+    stream.avail_in = uInt(frame.size() - SizePrefixSize);
+    stream.next_out = reinterpret_cast<Bytef *>(output.data());
+    stream.avail_out = uInt(expected);
+    int result = inflate(&stream, Z_FINISH);
+    qint64 produced = qint64(stream.total_out);
+    inflateReset(&stream);
+
+    // 선언한 크기보다 길게 풀리면 출력 공간이 모자라 Z_STREAM_END에 닿지 못함
+    if (result != Z_STREAM_END || produced != expected) {
+        return setError(QString("Corrupt compressed frame (zlib %1, %2 / %3 bytes)")
+                            .arg(result).arg(produced).arg(expected));
+    }
+    return true;
+}
+
+bool FrameCompressor::decompress(QIODevice *input, qint64 length,
+                                 const std::function<bool(QByteArrayView)> &sink)
+{
+    m_errorString.clear();
+    char prefix[SizePrefixSize];
+    if (length < SizePrefixSize || input->read(prefix, SizePrefixSize) != SizePrefixSize) {
+        return setError(QString("Compressed frame is too short: %1 bytes").arg(length));
+    }
+    qint64 expected = qFromBigEndian<quint32>(prefix);
+    if (!ensureInflate()) {
+        return false;
+    }
+    if (m_inputChunk.size() < ChunkSize) {
+        m_inputChunk.resize(ChunkSize);
+        m_outputChunk.resize(ChunkSize);
+    }
+
+    z_stream &stream = *m_inflate;
+    stream.avail_in = 0;
+    qint64 remaining = length - SizePrefixSize;
+    qint64 produced = 0;
+    int result = Z_OK;
+    QString error;
+
+    while (result != Z_STREAM_END) {
+        if (stream.avail_in == 0) {
+            qint64 bytesRead = remaining > 0 ? input->read(m_inputChunk.data(), qMin(remaining, qint64(ChunkSize))) : 0;
+            if (bytesRead <= 0) {
+                error = QString("Compressed frame is truncated (%1 / %2 bytes inflated)").arg(produced).arg(expected);
+                break;
+            }
+            remaining -= bytesRead;
+            stream.next_in = reinterpret_cast<Bytef *>(m_inputChunk.data());
+            stream.avail_in = uInt(bytesRead);
+        }
+
+        stream.next_out = reinterpret_cast<Bytef *>(m_outputChunk.data());
+        stream.avail_out = uInt(ChunkSize);
+        result = inflate(&stream, Z_NO_FLUSH);
+        if (result != Z_OK && result != Z_STREAM_END) {
+            error = QString("Corrupt compressed frame (zlib %1)").arg(result);
+            break;
+        }
+
+        qsizetype chunk = ChunkSize - qsizetype(stream.avail_out);
+        produced += chunk;
+        if (produced > expected) {
+            error = QString("Compressed frame inflates past its declared size of %1 bytes").arg(expected);
+            break;
+        }
+        if (chunk > 0 && !sink(QByteArrayView(m_outputChunk.constData(), chunk))) {
+            error = "Decompression aborted";
+            break;
+        }
+    }
+    inflateReset(&stream);
+
+    if (error.isEmpty() && produced != expected) {
+        error = QString("Compressed frame size mismatch: %1 / %2 bytes").arg(produced).arg(expected);
+    }
+    return error.isEmpty() || setError(error);
+}
+
+bool FrameCompressor::ensureDeflate()
+{
+    if (m_deflateReady) {
+        return true;
+    }
+    m_deflate = std::make_unique<z_stream_s>();
+    if (deflateInit(m_deflate.get(), m_level) != Z_OK) {
+        m_deflate.reset();
+        return setError("Failed to initialize zlib deflate");
+    }
+    m_deflateReady = true;
+    return true;
+}
+
+bool FrameCompressor::ensureInflate()
+{
+    if (m_inflateReady) {
+        return true;
+    }
+    m_inflate = std::make_unique<z_stream_s>();
+    if (inflateInit(m_inflate.get()) != Z_OK) {
+        m_inflate.reset();
+        return setError("Failed to initialize zlib inflate");
+    }
+    m_inflateReady = true;
+    return true;
+}
+
+bool FrameCompressor::setError(const QString &error)
+{
+    m_errorString = error;
+    return false;
+}
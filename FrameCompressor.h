@@ -0,0 +1,58 @@
+#ifndef FRAMECOMPRESSOR_H
+#define FRAMECOMPRESSOR_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QIODevice>
+#include <QString>
+#include <functional>
+#include <memory>
+
+struct z_stream_s;
+
+// 프레임 압축/해제 (연결마다 하나씩 소유)
+// 형식은 qCompress와 같다: 풀린 크기(4바이트, 빅엔디안) + zlib 스트림.
+// zlib 상태(z_stream)는 처음 쓸 때 한 번만 만들고 프레임마다 reset해 재사용하므로
+// 프레임마다 압축 사전/창 버퍼를 새로 할당하지 않는다.
+class FrameCompressor
+{
+public:
+    static constexpr qsizetype SizePrefixSize = 4;
+    static constexpr qsizetype ChunkSize = 64 * 1024;      // 조각 단위 해제의 입력/출력 버퍼 크기
+
+    explicit FrameCompressor(int level = 6);
+    ~FrameCompressor();
+
+    FrameCompressor(const FrameCompressor &) = delete;
+    FrameCompressor &operator=(const FrameCompressor &) = delete;
+
+    // 압축 결과를 output에 씀 (output의 용량은 다음 호출에서 재사용)
+    bool compress(QByteArrayView input, QByteArray &output);
+
+    // 앞 4바이트의 풀린 크기 (짧으면 -1)
+    static qint64 uncompressedSize(QByteArrayView frame);
+
+    // 메모리 → 메모리 (풀린 크기만큼 output을 한 번에 잡음, 작은 프레임용)
+    bool decompress(QByteArrayView frame, QByteArray &output);
+    // 디바이스의 현재 위치부터 length 바이트를 조각 단위로 풀어 sink에 넘김
+    // sink가 false를 돌려주면 중단한다. 메모리는 ChunkSize 두 개만 쓴다.
+    bool decompress(QIODevice *input, qint64 length, const std::function<bool(QByteArrayView)> &sink);
+
+    QString errorString() const { return m_errorString; }
+
+private:
+    bool ensureDeflate();
+    bool ensureInflate();
+    bool setError(const QString &error);
+
+    int m_level;
+    std::unique_ptr<z_stream_s> m_deflate;
+    std::unique_ptr<z_stream_s> m_inflate;
+    bool m_deflateReady;
+    bool m_inflateReady;
+    QByteArray m_inputChunk;
+    QByteArray m_outputChunk;
+    QString m_errorString;
+};
+
+#endif // FRAMECOMPRESSOR_H
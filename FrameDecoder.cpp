@@ -0,0 +1,476 @@
+#include "FrameDecoder.h"
+#include <QtEndian>
+#include <QCborStreamReader>
+#include <QDir>
+#include <cstring>
+
+namespace {
+// 평상시 버퍼 크기와, 대용량 프레임 처리 후 메모리를 되돌려 줄 기준 크기
+constexpr qsizetype InitialCapacity = 64 * 1024;
+constexpr qsizetype ShrinkThreshold = 4 * 1024 * 1024;
+
+// 기본 제한: 타입을 알 수 없는 프레임은 64MB, 8MB 초과 프레임은 임시 파일로 수신
+constexpr qint64 DefaultMaxFrameSize = 64LL * 1024 * 1024;
+constexpr qint64 DefaultSpillThreshold = 8LL * 1024 * 1024;
+}
+
+FrameDecoder::FrameDecoder()
+    : m_readPos(0)
+    , m_writePos(0)
+    , m_maxFrameSize(DefaultMaxFrameSize)
+    , m_spillThreshold(DefaultSpillThreshold)
+    , m_pendingChecked(false)
+    , m_pendingMessageId(-1)
+    , m_pendingCompressed(false)
+    , m_pendingAttachment(false)
+    , m_compressionEnabled(false)
+    , m_attachmentsEnabled(false)
+    , m_spoolLength(0)
+    , m_spoolWritten(0)
+    , m_spoolDelivered(false)
+    , m_lastFrameSize(0)
+    , m_lastFrameMessageId(-1)
+    , m_lastFrameCompressed(false)
+    , m_lastFrameAttachment(false)
+{
+    m_buffer.resize(InitialCapacity);
+}
+
+FrameDecoder::~FrameDecoder()
+{
+}
+
+void FrameDecoder::setMaxFrameSize(qint64 bytes)
+{
+    m_maxFrameSize = bytes;
+}
+
+void FrameDecoder::setMaxFrameSize(int messageId, qint64 bytes)
+{
+    m_typeLimits.insert(messageId, bytes);
+}
+
+void FrameDecoder::setSpillThreshold(qint64 bytes)
+{
+    m_spillThreshold = bytes;
+}
+
+void FrameDecoder::setCompressionEnabled(bool enabled)
+{
+    m_compressionEnabled = enabled;
+}
+
+void FrameDecoder::setAttachmentsEnabled(bool enabled)
+{
+    m_attachmentsEnabled = enabled;
+}
+
+qint64 FrameDecoder::largestFrameLimit() const
+{
+    qint64 largest = m_maxFrameSize;
+    for (auto it = m_typeLimits.cbegin(); it != m_typeLimits.cend(); ++it) {
+        largest = qMax(largest, it.value());
+    }
+    return largest;
+}
+
+qint64 FrameDecoder::readFrom(QIODevice *device)
+{
+    if (m_spoolDelivered) {
+        releaseSpool();
+    }
+    if (hasError()) {
+        return -1;
+    }
+
+    qint64 available = device->bytesAvailable();
+    if (available <= 0) {
+        return 0;
+    }
+
+    if (m_spool) {
+        if (m_spoolWritten >= m_spoolLength) {
+            // 파일 프레임이 완성되어 nextFrame()을 기다리는 중
+            return 0;
+        }
+
+        // 현재 프레임에 속한 만큼만 읽어 바로 파일에 기록 (메모리에 쌓지 않음)
+        qint64 toRead = qMin(qMin(available, m_spoolLength - m_spoolWritten), qint64(ReadChunkSize));
+        qint64 bytesRead = device->read(m_chunk.data(), toRead);
+        if (bytesRead > 0 && !writeSpool(m_chunk.constData(), bytesRead)) {
+            return -1;
+        }
+        return bytesRead;
+    }
+
+    qint64 toRead = qMin(available, qint64(ReadChunkSize));
+    ensureWritable(toRead);
+
+    // 소켓 데이터를 중간 QByteArray 없이 버퍼 끝으로 바로 읽음
+    qint64 bytesRead = device->read(m_buffer.data() + m_writePos, toRead);
+    if (bytesRead > 0) {
+        m_writePos += bytesRead;
+    }
+    return bytesRead;
+}
+
+void FrameDecoder::append(QByteArrayView data)
+{
+    if (m_spoolDelivered) {
+        releaseSpool();
+    }
+
+    if (m_spool && m_spoolWritten < m_spoolLength && !data.isEmpty()) {
+        qsizetype toWrite = qMin(data.size(), qsizetype(m_spoolLength - m_spoolWritten));
+        if (!writeSpool(data.data(), toWrite)) {
+            return;
+        }
+        data = data.sliced(toWrite);
+    }
+
+    if (data.isEmpty() || hasError()) {
+        return;
+    }
+
+    ensureWritable(data.size());
+    std::memcpy(m_buffer.data() + m_writePos, data.data(), data.size());
+    m_writePos += data.size();
+}
+
+bool FrameDecoder::nextFrame(QByteArrayView &frame)
+{
+    if (m_spoolDelivered) {
+        // 이전에 넘긴 파일 프레임은 처리가 끝났으므로 정리
+        releaseSpool();
+    }
+    if (hasError()) {
+        return false;
+    }
+
+    if (m_spool) {
+        if (m_spoolWritten < m_spoolLength) {
+            return false;
+        }
+
+        m_spool->flush();
+        m_spool->seek(0);
+        m_spoolDelivered = true;
+        m_lastFrameSize = m_spoolLength;
+        m_lastFrameMessageId = m_pendingMessageId;
+        m_lastFrameCompressed = m_pendingCompressed;
+        m_lastFrameAttachment = m_pendingAttachment;
+        m_pendingChecked = false;
+        m_pendingMessageId = -1;
+        m_pendingCompressed = false;
+        m_pendingAttachment = false;
+        frame = QByteArrayView();
+        return true;
+    }
+
+    qsizetype available = m_writePos - m_readPos;
+    if (available < HeaderSize) {
+        // 길이 정보가 아직 다 오지 않음
+        return false;
+    }
+
+    quint32 header = qFromBigEndian<quint32>(m_buffer.constData() + m_readPos);
+    bool compressed = m_compressionEnabled && (header & CompressedFlag);
+    bool attachment = m_attachmentsEnabled && (header & AttachmentFlag);
+    quint32 length = header & ~((compressed ? CompressedFlag : 0) | (attachment ? AttachmentFlag : 0));
+    if (!checkPendingFrame(length, compressed, attachment)) {
+        return false;
+    }
+
+    if (length > m_spillThreshold) {
+        if (!startSpool(length)) {
+            return false;
+        }
+        // 버퍼에 이미 전부 들어와 있었다면 바로 전달
+        return nextFrame(frame);
+    }
+
+    if (available - HeaderSize < static_cast<qsizetype>(length)) {
+        // 메시지가 아직 다 오지 않음
+        return false;
+    }
+
+    frame = QByteArrayView(m_buffer.constData() + m_readPos + HeaderSize, length);
+    m_readPos += HeaderSize + length;
+    m_lastFrameSize = length;
+    m_lastFrameMessageId = m_pendingMessageId;
+    m_lastFrameCompressed = m_pendingCompressed;
+    m_lastFrameAttachment = m_pendingAttachment;
+    m_pendingChecked = false;
+    m_pendingMessageId = -1;
+    m_pendingCompressed = false;
+    m_pendingAttachment = false;
+    return true;
+}
+
+QIODevice *FrameDecoder::spilledFrame() const
+{
+    return m_spoolDelivered ? m_spool.get() : nullptr;
+}
+
+void FrameDecoder::reset()
+{
+    releaseSpool();
+
+    m_readPos = 0;
+    m_writePos = 0;
+    m_pendingChecked = false;
+    m_pendingMessageId = -1;
+    m_pendingCompressed = false;
+    m_pendingAttachment = false;
+    m_lastFrameSize = 0;
+    m_lastFrameMessageId = -1;
+    m_lastFrameCompressed = false;
+    m_lastFrameAttachment = false;
+    m_errorString.clear();
+
+    if (m_buffer.size() > ShrinkThreshold) {
+        m_buffer.resize(InitialCapacity);
+        m_buffer.squeeze();
+    }
+}
+
+void FrameDecoder::ensureWritable(qsizetype additional)
+{
+    // 이미 처리한 앞부분이 있으면 남은 미완성 프레임만 앞으로 당김 (읽기 호출당 최대 한 번)
+    if (m_readPos > 0) {
+        qsizetype remaining = m_writePos - m_readPos;
+        if (remaining > 0) {
+            std::memmove(m_buffer.data(), m_buffer.constData() + m_readPos, remaining);
+        }
+        m_readPos = 0;
+        m_writePos = remaining;
+
+        // 대용량 프레임을 처리하고 난 뒤라면 커진 버퍼를 원래 크기로 되돌림
+        if (m_buffer.size() > ShrinkThreshold && remaining + additional <= InitialCapacity) {
+            m_buffer.resize(InitialCapacity);
+            m_buffer.squeeze();
+        }
+    }
+
+    qsizetype required = m_writePos + additional;
+    if (required > m_buffer.size()) {
+        m_buffer.resize(qMax(m_buffer.size() * 2, required));
+    }
+}
+
+bool FrameDecoder::checkPendingFrame(quint32 length, bool compressed, bool attachment)
+{
+    if (m_pendingChecked) {
+        return true;
+    }
+    m_pendingAttachment = attachment;
+
+    // 압축된 페이로드에서는 타입을 알 수 없으므로 가장 큰 허용치로 검사 (풀린 크기는 워커가 다시 확인)
+    if (compressed) {
+        qint64 limit = largestFrameLimit();
+        if (length > limit) {
+            setError(QString("Compressed frame too large: %1 bytes (limit %2 bytes)").arg(length).arg(limit));
+            return false;
+        }
+        m_pendingChecked = true;
+        m_pendingMessageId = -1;
+        m_pendingCompressed = true;
+        return true;
+    }
+    m_pendingCompressed = false;
+
+    qint64 smallestLimit = m_maxFrameSize;
+    for (auto it = m_typeLimits.cbegin(); it != m_typeLimits.cend(); ++it) {
+        smallestLimit = qMin(smallestLimit, it.value());
+    }
+
+    // 어떤 제한에도 걸리지 않고 메모리로 받을 크기면 타입 확인 없이 통과
+    if (length <= smallestLimit && length <= m_spillThreshold) {
+        m_pendingChecked = true;
+        m_pendingMessageId = -1;
+        return true;
+    }
+
+    // 타입 확인에 필요한 페이로드 앞부분을 기다림 (첨부 프레임은 헤더 길이 뒤의 JSON/CBOR 헤더에서 확인)
+    qsizetype skip = attachment ? AttachmentHeaderPrefixSize : 0;
+    qsizetype needed = qMin(qsizetype(length), skip + SniffSize);
+    if (m_writePos - m_readPos - HeaderSize < needed) {
+        return false;
+    }
+
+    m_pendingMessageId = needed > skip
+        ? sniffMessageId(QByteArrayView(m_buffer.constData() + m_readPos + HeaderSize + skip, needed - skip))
+        : -1;
+    qint64 limit = frameLimit(m_pendingMessageId);
+    if (length > limit) {
+        setError(QString("Frame too large: %1 bytes (message %2, limit %3 bytes)")
+                     .arg(length).arg(m_pendingMessageId).arg(limit));
+        return false;
+    }
+
+    m_pendingChecked = true;
+    return true;
+}
+
+qint64 FrameDecoder::frameLimit(int messageId) const
+{
+    return m_typeLimits.value(messageId, m_maxFrameSize);
+}
+
+int FrameDecoder::sniffMessageId(QByteArrayView payload)
+{
+    // 최상위 객체의 키만 인정 (중첩 객체의 키나 문자열 안의 같은 글자는 무시)
+    // 앞부분만 보므로 최상위 키가 잘린 범위 밖에 있으면 -1
+
+    // CBOR 프레임: 최상위 맵을 차례로 읽고 나머지 값은 통째로 건너뜀
+    if (!payload.isEmpty() && (static_cast<uchar>(payload.front()) & 0xE0) == 0xA0) {
+        QCborStreamReader reader(payload.data(), payload.size());
+        if (!reader.isMap() || !reader.enterContainer()) {
+            return -1;
+        }
+        while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+            if (!reader.isString()) {
+                return -1;
+            }
+            QString key;
+            auto chunk = reader.readString();
+            while (chunk.status == QCborStreamReader::Ok) {
+                key += chunk.data;
+                chunk = reader.readString();
+            }
+            if (chunk.status == QCborStreamReader::Error) {
+                return -1;
+            }
+
+            bool idKey = key == QLatin1String("request_id") || key == QLatin1String("response_id");
+            if (idKey && reader.isUnsignedInteger()) {
+                quint64 id = reader.toUnsignedInteger();
+                return id <= 1000000 ? static_cast<int>(id) : -1;
+            }
+            if (!reader.next()) {
+                return -1;
+            }
+        }
+        return -1;
+    }
+
+    // JSON 프레임: 깊이와 문자열 안 여부를 따라가며 최상위 객체의 키 위치에서만 비교
+    auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+    qsizetype pos = 0;
+    while (pos < payload.size() && isSpace(payload[pos])) {
+        ++pos;
+    }
+    if (pos >= payload.size() || payload[pos] != '{') {
+        return -1;
+    }
+
+    int depth = 0;
+    bool expectKey = false;
+    for (; pos < payload.size(); ++pos) {
+        char c = payload[pos];
+        if (c == '"') {
+            qsizetype end = pos + 1;
+            while (end < payload.size() && payload[end] != '"') {
+                end += payload[end] == '\\' ? 2 : 1;
+            }
+            if (end >= payload.size()) {
+                return -1;
+            }
+
+            QByteArrayView name = payload.sliced(pos + 1, end - pos - 1);
+            pos = end;
+            if (depth != 1 || !expectKey) {
+                continue;
+            }
+            expectKey = false;
+            if (name != "request_id" && name != "response_id") {
+                continue;
+            }
+
+            qsizetype value = end + 1;
+            while (value < payload.size() && (payload[value] == ':' || isSpace(payload[value]))) {
+                ++value;
+            }
+            int id = 0;
+            bool hasDigits = false;
+            while (value < payload.size() && payload[value] >= '0' && payload[value] <= '9' && id < 1000000) {
+                id = id * 10 + (payload[value] - '0');
+                hasDigits = true;
+                ++value;
+            }
+            if (hasDigits) {
+                return id;
+            }
+            continue;
+        }
+
+        switch (c) {
+        case '{':
+        case '[':
+            ++depth;
+            expectKey = c == '{' && depth == 1;
+            break;
+        case '}':
+        case ']':
+            if (--depth <= 0) {
+                return -1;
+            }
+            break;
+        case ',':
+            expectKey = depth == 1;
+            break;
+        default:
+            break;
+        }
+    }
+    return -1;
+}
+
+bool FrameDecoder::startSpool(quint32 length)
+{
+    m_spool = std::make_unique<QTemporaryFile>(QDir::tempPath() + "/CCTVFrame.XXXXXX");
+    if (!m_spool->open()) {
+        setError(QString("Failed to create temporary file for large frame: %1").arg(m_spool->errorString()));
+        m_spool.reset();
+        return false;
+    }
+
+    m_spoolLength = length;
+    m_spoolWritten = 0;
+    m_spoolDelivered = false;
+    if (m_chunk.size() < ReadChunkSize) {
+        m_chunk.resize(ReadChunkSize);
+    }
+
+    // 헤더 뒤로 버퍼에 이미 받아 둔 페이로드를 파일로 옮김
+    m_readPos += HeaderSize;
+    qsizetype buffered = qMin(m_writePos - m_readPos, qsizetype(length));
+    if (buffered > 0 && !writeSpool(m_buffer.constData() + m_readPos, buffered)) {
+        return false;
+    }
+    m_readPos += buffered;
+    return true;
+}
+
+bool FrameDecoder::writeSpool(const char *data, qsizetype size)
+{
+    if (m_spool->write(data, size) != size) {
+        setError(QString("Failed to write large frame to temporary file: %1").arg(m_spool->errorString()));
+        return false;
+    }
+    m_spoolWritten += size;
+    return true;
+}
+
+void FrameDecoder::releaseSpool()
+{
+    m_spool.reset();
+    m_spoolLength = 0;
+    m_spoolWritten = 0;
+    m_spoolDelivered = false;
+}
+
+void FrameDecoder::setError(const QString &error)
+{
+    m_errorString = error;
+}
@@ -0,0 +1,120 @@
+#ifndef FRAMEDECODER_H
+#define FRAMEDECODER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QIODevice>
+#include <QHash>
+#include <QString>
+#include <QTemporaryFile>
+#include <memory>
+
+// 4바이트 빅엔디안 길이 헤더 + 페이로드 형식의 프레임 디코더 (연결마다 하나씩 소유)
+// 수신 데이터는 하나의 버퍼에 이어 붙이고 읽기 위치(offset)만 옮기므로
+// 메시지마다 remove/left 복사가 발생하지 않는다. 완성된 프레임은 버퍼를 가리키는
+// view로 전달되며, 다음 nextFrame()/readFrom()/append()/reset() 호출 전까지만 유효하다.
+//
+// 헤더의 길이는 그대로 믿지 않는다. 메시지 타입별 최대 크기를 넘으면 오류 상태가 되고,
+// 기준(spill threshold)보다 큰 프레임은 메모리 대신 임시 파일로 받아 spilledFrame()으로 넘긴다.
+class FrameDecoder
+{
+public:
+    static constexpr qsizetype HeaderSize = 4;
+    static constexpr qsizetype ReadChunkSize = 256 * 1024;     // readFrom() 한 번에 읽는 최대 크기
+    static constexpr qsizetype SniffSize = 4096;               // 타입 확인을 위해 살펴보는 페이로드 앞부분
+    static constexpr quint32 CompressedFlag = 0x80000000u;     // 길이 헤더 최상위 비트: 압축된 페이로드 (합의한 경우만)
+    static constexpr quint32 AttachmentFlag = 0x40000000u;     // 그다음 비트: 첨부 프레임 (합의한 경우만, 형식은 아래)
+
+    // 첨부 프레임 페이로드: 헤더 길이(4바이트, 빅엔디안) + JSON/CBOR 헤더 + 바이너리 블롭 영역
+    // 헤더의 각 항목은 블롭 영역 시작 기준 offset/length로 자기 데이터를 가리킨다 (base64 없음).
+    static constexpr qsizetype AttachmentHeaderPrefixSize = 4;
+
+    FrameDecoder();
+    ~FrameDecoder();
+
+    // 크기 제한 설정 (타입별 제한이 없으면 기본 제한 적용)
+    void setMaxFrameSize(qint64 bytes);
+    void setMaxFrameSize(int messageId, qint64 bytes);
+    void setSpillThreshold(qint64 bytes);
+    // 압축 플래그 해석 (연결마다 서버와 합의, 끄면 최상위 비트가 켜진 길이는 크기 초과 오류)
+    void setCompressionEnabled(bool enabled);
+    // 첨부 프레임 플래그 해석 (압축과 같은 방식으로 연결마다 합의)
+    void setAttachmentsEnabled(bool enabled);
+    qint64 largestFrameLimit() const;
+    // 메시지 타입의 최대 크기 (압축 프레임은 풀린 뒤 이 값으로 다시 검사)
+    qint64 frameLimit(int messageId) const;
+    qint64 spillThreshold() const { return m_spillThreshold; }
+
+    // 디바이스에서 최대 ReadChunkSize 만큼 읽어 들임 (읽은 바이트 수 반환, 오류 시 -1)
+    qint64 readFrom(QIODevice *device);
+
+    // 이미 메모리에 있는 데이터를 추가 (리플레이 등)
+    void append(QByteArrayView data);
+
+    // 완성된 프레임이 있으면 true 반환
+    // 메모리 프레임은 frame에 페이로드 view를 담고, 파일로 받은 프레임은 frame을 비우고
+    // lastFrameSpilled()가 true가 된다 (내용은 spilledFrame()에서 읽음)
+    bool nextFrame(QByteArrayView &frame);
+
+    bool lastFrameSpilled() const { return m_spoolDelivered; }
+    QIODevice *spilledFrame() const;
+    qint64 lastFrameSize() const { return m_lastFrameSize; }
+    int lastFrameMessageId() const { return m_lastFrameMessageId; }    // 알 수 없으면 -1
+    bool lastFrameCompressed() const { return m_lastFrameCompressed; }
+    bool lastFrameAttachment() const { return m_lastFrameAttachment; }
+
+    bool hasError() const { return !m_errorString.isEmpty(); }
+    QString errorString() const { return m_errorString; }
+
+    // 연결이 끊기면 반쯤 받은 프레임을 포함한 모든 상태를 버림 (설정은 유지)
+    void reset();
+
+    qsizetype bufferedBytes() const { return m_writePos - m_readPos; }
+    qsizetype capacity() const { return m_buffer.size(); }
+
+    // 페이로드 앞부분에서 최상위 객체의 request_id/response_id만 빠르게 찾음 (JSON/CBOR, 못 찾으면 -1)
+    static int sniffMessageId(QByteArrayView payload);
+
+private:
+    // 쓰기 공간이 additional 바이트 이상 남도록 보장 (남은 데이터를 앞으로 당기거나 버퍼 확장)
+    void ensureWritable(qsizetype additional);
+
+    // 대기 중인 프레임 헤더 검사 - 더 기다려야 하거나 오류면 false
+    bool checkPendingFrame(quint32 length, bool compressed, bool attachment);
+
+    // 임시 파일 수신
+    bool startSpool(quint32 length);
+    bool writeSpool(const char *data, qsizetype size);
+    void releaseSpool();
+    void setError(const QString &error);
+
+    QByteArray m_buffer;
+    qsizetype m_readPos;     // 다음 프레임 헤더 시작 위치
+    qsizetype m_writePos;    // 유효 데이터의 끝
+
+    // 크기 제한
+    qint64 m_maxFrameSize;
+    qint64 m_spillThreshold;
+    QHash<int, qint64> m_typeLimits;
+    bool m_pendingChecked;          // 현재 대기 중인 프레임의 헤더 검사 완료 여부
+    int m_pendingMessageId;
+    bool m_pendingCompressed;
+    bool m_pendingAttachment;
+    bool m_compressionEnabled;
+    bool m_attachmentsEnabled;
+
+    // 임시 파일로 받는 중인 프레임
+    std::unique_ptr<QTemporaryFile> m_spool;
+    qint64 m_spoolLength;
+    qint64 m_spoolWritten;
+    bool m_spoolDelivered;
+    QByteArray m_chunk;             // 스풀 중 소켓 → 파일 복사용 재사용 버퍼
+
+    qint64 m_lastFrameSize;
+    int m_lastFrameMessageId;
+    bool m_lastFrameCompressed;
+    bool m_lastFrameAttachment;
+    QString m_errorString;
+};
+
+#endif // FRAMEDECODER_H
@@ -0,0 +1,339 @@
+#include "JsonStreamReader.h"
+#include <cstring>
+
+JsonStreamReader::JsonStreamReader(QByteArrayView data)
+    : m_data(data.data())
+    , m_pos(0)
+    , m_end(data.size())
+    , m_device(nullptr)
+    , m_chunkSize(0)
+    , m_expectName(false)
+    , m_token(NoToken)
+{
+}
+
+JsonStreamReader::JsonStreamReader(QIODevice *device, qsizetype chunkSize)
+    : m_data(nullptr)
+    , m_pos(0)
+    , m_end(0)
+    , m_device(device)
+    , m_chunkSize(chunkSize)
+    , m_expectName(false)
+    , m_token(NoToken)
+{
+}
+
+JsonStreamReader::TokenType JsonStreamReader::readNext()
+{
+    if (m_token == Invalid || m_token == EndOfData) {
+        return m_token;
+    }
+    m_text = QByteArrayView();
+
+    while (true) {
+        if (!fill(1)) {
+            if (!m_stack.isEmpty()) {
+                return setInvalid("Unexpected end of JSON data");
+            }
+            return m_token = EndOfData;
+        }
+
+        char c = m_data[m_pos];
+        switch (c) {
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+        case ':':
+            ++m_pos;
+            continue;
+        case ',':
+            ++m_pos;
+            if (!m_stack.isEmpty() && m_stack.last() == '{') {
+                m_expectName = true;
+            }
+            continue;
+        case '{':
+            ++m_pos;
+            m_stack.append('{');
+            m_expectName = true;
+            return m_token = BeginObject;
+        case '[':
+            ++m_pos;
+            m_stack.append('[');
+            m_expectName = false;
+            return m_token = BeginArray;
+        case '}':
+        case ']':
+            ++m_pos;
+            if (m_stack.isEmpty() || m_stack.last() != (c == '}' ? '{' : '[')) {
+                return setInvalid("Mismatched JSON bracket");
+            }
+            m_stack.removeLast();
+            m_expectName = false;
+            return m_token = (c == '}') ? EndObject : EndArray;
+        case '"':
+            return readString();
+        default:
+            return readLiteral();
+        }
+    }
+}
+
+qint64 JsonStreamReader::toInteger(qint64 defaultValue) const
+{
+    if (m_token != Number && m_token != String) {
+        return defaultValue;
+    }
+
+    bool ok = false;
+    qint64 value = m_text.toLongLong(&ok);
+    if (!ok) {
+        // "10.0" 같은 실수 표기
+        double d = m_text.toDouble(&ok);
+        value = static_cast<qint64>(d);
+    }
+    return ok ? value : defaultValue;
+}
+
+double JsonStreamReader::toDouble(double defaultValue) const
+{
+    if (m_token != Number && m_token != String) {
+        return defaultValue;
+    }
+
+    bool ok = false;
+    double value = m_text.toDouble(&ok);
+    return ok ? value : defaultValue;
+}
+
+void JsonStreamReader::skipValue()
+{
+    if (m_token == Name) {
+        readNext();
+    }
+    if (m_token != BeginObject && m_token != BeginArray) {
+        return;
+    }
+
+    int depth = 1;
+    while (depth > 0) {
+        TokenType token = readNext();
+        if (token == BeginObject || token == BeginArray) {
+            ++depth;
+        } else if (token == EndObject || token == EndArray) {
+            --depth;
+        } else if (token == Invalid || token == EndOfData) {
+            return;
+        }
+    }
+}
+
+bool JsonStreamReader::fill(qsizetype needed)
+{
+    if (m_end - m_pos >= needed) {
+        return true;
+    }
+    if (!m_device) {
+        return false;
+    }
+
+    // 이미 지나간 앞부분을 버리고 남은 데이터를 앞으로 당김
+    if (m_pos > 0) {
+        qsizetype remaining = m_end - m_pos;
+        if (remaining > 0) {
+            std::memmove(m_storage.data(), m_storage.constData() + m_pos, remaining);
+        }
+        m_pos = 0;
+        m_end = remaining;
+    }
+
+    qsizetype required = qMax(needed, m_end + m_chunkSize);
+    if (m_storage.size() < required) {
+        m_storage.resize(qMax(required, m_storage.size() * 2));
+    }
+
+    while (m_end < needed) {
+        qint64 bytesRead = m_device->read(m_storage.data() + m_end, m_storage.size() - m_end);
+        if (bytesRead <= 0) {
+            break;
+        }
+        m_end += bytesRead;
+    }
+
+    m_data = m_storage.constData();
+    return m_end - m_pos >= needed;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::readString()
+{
+    // m_pos는 여는 따옴표를 가리킴. 문자열이 끝날 때까지 m_pos는 그대로 두고 오프셋으로만 탐색
+    qsizetype offset = 1;
+    while (true) {
+        if (m_pos + offset >= m_end && !fill(offset + 1)) {
+            return setInvalid("Unterminated JSON string");
+        }
+
+        const char *start = m_data + m_pos + offset;
+        const void *quote = std::memchr(start, '"', m_end - m_pos - offset);
+        if (!quote) {
+            offset = m_end - m_pos;
+            continue;
+        }
+
+        offset = static_cast<const char *>(quote) - (m_data + m_pos);
+
+        // 앞의 역슬래시 개수가 홀수면 이스케이프된 따옴표
+        qsizetype backslashes = 0;
+        while (offset - 1 - backslashes >= 1 && m_data[m_pos + offset - 1 - backslashes] == '\\') {
+            ++backslashes;
+        }
+        if (backslashes % 2 == 0) {
+            break;
+        }
+        ++offset;
+    }
+
+    QByteArrayView raw(m_data + m_pos + 1, offset - 1);
+    m_pos += offset + 1;
+
+    if (raw.contains('\\')) {
+        if (!unescape(raw)) {
+            return setInvalid("Invalid escape sequence in JSON string");
+        }
+        m_text = QByteArrayView(m_scratch);
+    } else {
+        m_text = raw;
+    }
+
+    bool isName = m_expectName && !m_stack.isEmpty() && m_stack.last() == '{';
+    m_expectName = false;
+    return m_token = isName ? Name : String;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::readLiteral()
+{
+    qsizetype offset = 0;
+    while (true) {
+        if (m_pos + offset >= m_end && !fill(offset + 1)) {
+            break;
+        }
+        char c = m_data[m_pos + offset];
+        if (c == ',' || c == '}' || c == ']' || c == ':' || c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            break;
+        }
+        ++offset;
+    }
+
+    if (offset == 0) {
+        return setInvalid("Unexpected character in JSON data");
+    }
+
+    m_text = QByteArrayView(m_data + m_pos, offset);
+    m_pos += offset;
+    m_expectName = false;
+
+    if (m_text == "true" || m_text == "false") {
+        return m_token = Bool;
+    }
+    if (m_text == "null") {
+        return m_token = Null;
+    }
+
+    char first = m_text.front();
+    if (first == '-' || (first >= '0' && first <= '9')) {
+        return m_token = Number;
+    }
+    return setInvalid(QString("Invalid JSON literal: %1").arg(QString::fromUtf8(m_text.left(32))));
+}
+
+JsonStreamReader::TokenType JsonStreamReader::setInvalid(const QString &error)
+{
+    m_errorString = error;
+    m_text = QByteArrayView();
+    return m_token = Invalid;
+}
+
+bool JsonStreamReader::unescape(QByteArrayView raw)
+{
+    m_scratch.clear();
+    m_scratch.reserve(raw.size());
+
+    auto appendUtf8 = [this](char32_t cp) {
+        if (cp < 0x80) {
+            m_scratch.append(char(cp));
+        } else if (cp < 0x800) {
+            m_scratch.append(char(0xC0 | (cp >> 6)));
+            m_scratch.append(char(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            m_scratch.append(char(0xE0 | (cp >> 12)));
+            m_scratch.append(char(0x80 | ((cp >> 6) & 0x3F)));
+            m_scratch.append(char(0x80 | (cp & 0x3F)));
+        } else {
+            m_scratch.append(char(0xF0 | (cp >> 18)));
+            m_scratch.append(char(0x80 | ((cp >> 12) & 0x3F)));
+            m_scratch.append(char(0x80 | ((cp >> 6) & 0x3F)));
+            m_scratch.append(char(0x80 | (cp & 0x3F)));
+        }
+    };
+
+    auto readHex4 = [&raw](qsizetype pos, char32_t &value) {
+        if (pos + 4 > raw.size()) {
+            return false;
+        }
+        value = 0;
+        for (qsizetype i = pos; i < pos + 4; ++i) {
+            char c = raw[i];
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= char32_t(c - '0');
+            else if (c >= 'a' && c <= 'f') value |= char32_t(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') value |= char32_t(c - 'A' + 10);
+            else return false;
+        }
+        return true;
+    };
+
+    for (qsizetype i = 0; i < raw.size(); ++i) {
+        char c = raw[i];
+        if (c != '\\') {
+            m_scratch.append(c);
+            continue;
+        }
+
+        if (++i >= raw.size()) {
+            return false;
+        }
+
+        switch (raw[i]) {
+        case '"':  m_scratch.append('"'); break;
+        case '\\': m_scratch.append('\\'); break;
+        case '/':  m_scratch.append('/'); break;
+        case 'b':  m_scratch.append('\b'); break;
+        case 'f':  m_scratch.append('\f'); break;
+        case 'n':  m_scratch.append('\n'); break;
+        case 'r':  m_scratch.append('\r'); break;
+        case 't':  m_scratch.append('\t'); break;
+        case 'u': {
+            char32_t cp = 0;
+            if (!readHex4(i + 1, cp)) {
+                return false;
+            }
+            i += 4;
+
+            // 서로게이트 쌍
+            if (cp >= 0xD800 && cp <= 0xDBFF && i + 6 < raw.size() && raw[i + 1] == '\\' && raw[i + 2] == 'u') {
+                char32_t low = 0;
+                if (readHex4(i + 3, low) && low >= 0xDC00 && low <= 0xDFFF) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    i += 6;
+                }
+            }
+            appendUtf8(cp);
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,80 @@
+#ifndef JSONSTREAMREADER_H
+#define JSONSTREAMREADER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QIODevice>
+#include <QString>
+#include <QVarLengthArray>
+
+// 토큰 단위로 읽는 JSON pull 리더
+// QJsonDocument처럼 전체 문서를 트리로 만들지 않으므로, 파일로 받은 대용량 응답도
+// 한 번에 하나의 값(가장 큰 문자열 하나)만 메모리에 올려 처리할 수 있다.
+// 메모리 뷰를 직접 읽거나, QIODevice에서 필요한 만큼씩 채워 가며 읽는다.
+class JsonStreamReader
+{
+public:
+    enum TokenType {
+        NoToken,
+        BeginObject,
+        EndObject,
+        BeginArray,
+        EndArray,
+        Name,
+        String,
+        Number,
+        Bool,
+        Null,
+        EndOfData,
+        Invalid
+    };
+
+    explicit JsonStreamReader(QByteArrayView data);
+    explicit JsonStreamReader(QIODevice *device, qsizetype chunkSize = 64 * 1024);
+
+    TokenType readNext();
+    TokenType tokenType() const { return m_token; }
+
+    // 현재 토큰의 텍스트 (Name/String은 이스케이프를 푼 UTF-8, Number/Bool/Null은 원문)
+    // 다음 readNext() 호출 전까지만 유효
+    QByteArrayView text() const { return m_text; }
+    QString toString() const { return QString::fromUtf8(m_text); }
+    qint64 toInteger(qint64 defaultValue = 0) const;
+    double toDouble(double defaultValue = 0.0) const;
+    bool toBool() const { return m_token == Bool && m_text == "true"; }
+    bool isName(QByteArrayView name) const { return m_token == Name && m_text == name; }
+
+    // Name 직후라면 그 값을, Begin 토큰이면 해당 컨테이너 전체를 건너뜀
+    void skipValue();
+
+    bool hasError() const { return m_token == Invalid; }
+    QString errorString() const { return m_errorString; }
+    qsizetype depth() const { return m_stack.size(); }
+    // 디바이스 모드에서 잡아 둔 버퍼 크기 (가장 큰 값 하나 + 읽기 조각 정도로 유지됨)
+    qsizetype bufferCapacity() const { return m_storage.size(); }
+
+private:
+    bool fill(qsizetype needed);
+    TokenType readString();
+    TokenType readLiteral();
+    TokenType setInvalid(const QString &error);
+    bool unescape(QByteArrayView raw);
+
+    // 입력
+    const char *m_data;
+    qsizetype m_pos;
+    qsizetype m_end;
+    QIODevice *m_device;
+    QByteArray m_storage;           // 디바이스 모드에서 읽어 둔 구간
+    qsizetype m_chunkSize;
+
+    // 파서 상태
+    QVarLengthArray<char, 32> m_stack;
+    bool m_expectName;
+    TokenType m_token;
+    QByteArrayView m_text;
+    QByteArray m_scratch;           // 이스케이프가 있는 문자열만 여기에 풀어 둠
+    QString m_errorString;
+};
+
+#endif // JSONSTREAMREADER_H
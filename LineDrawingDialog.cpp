@@ -1,4 +1,6 @@
 #include "LineDrawingDialog.h"
+#include "Logging.h"
+#include "EventLoopWatchdog.h"
 #include "custommessagebox.h"
 #include <QApplication>
 #include <QMessageBox>
@@ -159,7 +161,7 @@ void VideoGraphicsView::loadSavedRoadLines(const QList<RoadLineData> &roadLines)
     // 도로선 데이터 처리 - 얇은 선으로
     for (int i = 0; i < roadLines.size(); ++i) {
         const auto &roadLine = roadLines[i];
-        qDebug() << QString("도로선 %1: index=%2, (%3,%4) → (%5,%6), matrix1=%7, matrix2=%8")
+        qCDebug(lcRender) << QString("도로선 %1: index=%2, (%3,%4) → (%5,%6), matrix1=%7, matrix2=%8")
                         .arg(i).arg(roadLine.index)
                         .arg(roadLine.x1).arg(roadLine.y1).arg(roadLine.x2).arg(roadLine.y2)
                         .arg(roadLine.matrixNum1).arg(roadLine.matrixNum2);
@@ -204,7 +206,7 @@ void VideoGraphicsView::loadSavedRoadLines(const QList<RoadLineData> &roadLines)
         m_scene->addItem(endPoint);
         m_pointItems.append(endPoint);
 
-        qDebug() << QString("도로선 %1 그리기 완료: (%2,%3) → (%4,%5)")
+        qCDebug(lcRender) << QString("도로선 %1 그리기 완료: (%2,%3) → (%4,%5)")
                         .arg(roadLine.index).arg(x1).arg(y1).arg(x2).arg(y2);
 
         QPoint startPointQP(x1,y1);
@@ -227,7 +229,7 @@ void VideoGraphicsView::loadSavedDetectionLines(const QList<DetectionLineData> &
     // 감지선 데이터 처리 - 원래 얇은 선으로
     for (int i = 0; i < detectionLines.size(); ++i) {
         const auto &detectionLine = detectionLines[i];
-        qDebug() << QString("감지선 %1: index=%2, name=%3, (%4,%5) → (%6,%7), mode=%8")
+        qCDebug(lcRender) << QString("감지선 %1: index=%2, name=%3, (%4,%5) → (%6,%7), mode=%8")
                         .arg(i).arg(detectionLine.index).arg(detectionLine.name)
                         .arg(detectionLine.x1).arg(detectionLine.y1)
                         .arg(detectionLine.x2).arg(detectionLine.y2)
@@ -272,7 +274,7 @@ void VideoGraphicsView::loadSavedDetectionLines(const QList<DetectionLineData> &
         m_scene->addItem(endPoint);
         m_pointItems.append(endPoint);
 
-        qDebug() << QString("감지선 %1 그리기 완료: (%2,%3) → (%4,%5)")
+        qCDebug(lcRender) << QString("감지선 %1 그리기 완료: (%2,%3) → (%4,%5)")
                         .arg(detectionLine.index).arg(x1).arg(y1).arg(x2).arg(y2);
 
         QPoint startPointQP(x1,y1);
@@ -288,7 +290,8 @@ void VideoGraphicsView::loadSavedDetectionLines(const QList<DetectionLineData> &
 
 void VideoGraphicsView::redrawAllLines()
 {
-    qDebug() << "redrawAllLines 호출됨 - 그릴 선의 개수:" << m_categorizedLines.size();
+    WATCHDOG_SCOPE("VideoGraphicsView::redrawAllLines");
+    qCDebug(lcRender) << "redrawAllLines 호출됨 - 그릴 선의 개수:" << m_categorizedLines.size();
 
     // 모든 선을 다시 그리기 - 원래 얇은 선으로
     for (int i = 0; i < m_categorizedLines.size(); ++i) {
@@ -328,7 +331,7 @@ void VideoGraphicsView::redrawAllLines()
         m_scene->addItem(endPoint);
         m_pointItems.append(endPoint);
 
-        qDebug() << "선 그리기 완료:" << i << "번째 선," <<
+        qCDebug(lcRender) << "선 그리기 완료:" << i << "번째 선," <<
             (catLine.category == LineCategory::ROAD_DEFINITION ? "도로선" : "감지선") <<
             catLine.start << "→" << catLine.end << "Z-Value:" << lineItem->zValue();
     }
@@ -339,7 +342,7 @@ void VideoGraphicsView::redrawAllLines()
     viewport()->update();
     repaint();
 
-    qDebug() << "총" << m_lineItems.size() << "개의 선과" << m_pointItems.size() << "개의 점이 그려짐";
+    qCDebug(lcRender) << "총" << m_lineItems.size() << "개의 선과" << m_pointItems.size() << "개의 점이 그려짐";
 }
 
 void VideoGraphicsView::mousePressEvent(QMouseEvent *event)
@@ -350,7 +353,7 @@ void VideoGraphicsView::mousePressEvent(QMouseEvent *event)
     }
 
     QPointF scenePos = mapToScene(event->pos());
-    qDebug() << "마우스 클릭 - 뷰 좌표:" << event->pos() << "씬 좌표:" << scenePos;
+    qCDebug(lcRender) << "마우스 클릭 - 뷰 좌표:" << event->pos() << "씬 좌표:" << scenePos;
 
     // 그리기 모드가 아닐 때는 도로선의 좌표점 클릭 감지
     if (!m_drawingMode) {
@@ -391,7 +394,7 @@ void VideoGraphicsView::mousePressEvent(QMouseEvent *event)
     m_currentLineItem->setZValue(2000); // 최고 Z-Value
     m_scene->addItem(m_currentLineItem);
 
-    qDebug() << "선 그리기 시작:" << m_startPoint;
+    qCDebug(lcRender) << "선 그리기 시작:" << m_startPoint;
 }
 
 QGraphicsLineItem* VideoGraphicsView::findClickedRoadLine(const QPointF &clickPos)
@@ -480,8 +483,9 @@ void VideoGraphicsView::clearHighlight()
 }
 
 // BBox 관련 함수 구현
-void VideoGraphicsView::setBBoxes(const QList<BBox> &bboxes, qint64 timestamp)
+void VideoGraphicsView::setBBoxes(const BBoxFrameSnapshot &frame)
 {
+    WATCHDOG_SCOPE("VideoGraphicsView::setBBoxes");
     // 기존 BBox 아이템들 제거
     clearBBoxes();
 
@@ -489,10 +493,9 @@ void VideoGraphicsView::setBBoxes(const QList<BBox> &bboxes, qint64 timestamp)
     double scaleX = static_cast<double>(m_currentViewSize.width()) / m_originalVideoSize.width();
     double scaleY = static_cast<double>(m_currentViewSize.height()) / m_originalVideoSize.height();
 
-    for (const BBox &bbox : bboxes) {
-        // Vehicle과 Human(Person) 타입만 필터링
-        QString lowerType = bbox.type.toLower();
-        if (lowerType != "vehical" && lowerType != "person" && lowerType != "human") {
+    for (const BBox &bbox : frame->boxes) {
+        // Vehicle과 Human(Person) 타입만 필터링 (타입 문자열 비교는 수신 시 한 번만)
+        if (!ObjectTypes::isDisplayed(bbox.type)) {
             continue; // 다른 타입은 건너뛰기
         }
         
@@ -514,7 +517,7 @@ void VideoGraphicsView::setBBoxes(const QList<BBox> &bboxes, qint64 timestamp)
         m_bboxRectItems.append(rectItem);
 
         // 텍스트 아이템 생성 (타입과 신뢰도 표시 - 백분율로 표시)
-        QString labelText = QString("%1 (%2%)").arg(bbox.type).arg(static_cast<int>(bbox.confidence * 100));
+        QString labelText = QString("%1 (%2%)").arg(ObjectTypes::name(bbox.type)).arg(static_cast<int>(bbox.confidence * 100));
         QGraphicsTextItem* textItem = new QGraphicsTextItem(labelText);
         
         // 텍스트 스타일 설정
@@ -531,7 +534,7 @@ void VideoGraphicsView::setBBoxes(const QList<BBox> &bboxes, qint64 timestamp)
         m_bboxTextItems.append(textItem);
     }
 
-    qDebug() << QString("[VideoView] BBox 시각화 완료 - %1개 객체, 타임스탬프: %2").arg(bboxes.size()).arg(timestamp);
+    qCDebug(lcBBox) << QString("[VideoView] BBox 시각화 완료 - %1개 객체, 타임스탬프: %2").arg(frame->boxes.size()).arg(frame->timestamp);
 }
 
 void VideoGraphicsView::clearBBoxes()
@@ -554,7 +557,7 @@ void VideoGraphicsView::clearBBoxes()
     }
     m_bboxTextItems.clear();
 
-    qDebug() << "[VideoView] BBox 아이템들 제거 완료";
+    qCDebug(lcBBox) << "[VideoView] BBox 아이템들 제거 완료";
 }
 
 void VideoGraphicsView::mouseMoveEvent(QMouseEvent *event)
@@ -633,7 +636,7 @@ void VideoGraphicsView::mouseReleaseEvent(QMouseEvent *event)
         emit lineDrawn(m_startPoint, endPoint, m_currentCategory);
 
         QString categoryName = (m_currentCategory == LineCategory::ROAD_DEFINITION) ? "도로 명시선" : "객체 감지선";
-        qDebug() << categoryName << "추가됨:" << m_startPoint << "→" << endPoint << "Z-Value:" << lineItem->zValue();
+        qCDebug(lcRender) << categoryName << "추가됨:" << m_startPoint << "→" << endPoint << "Z-Value:" << lineItem->zValue();
     } else {
         qDebug() << "선이 너무 짧아서 무시됨";
     }
@@ -739,8 +742,8 @@ void LineDrawingDialog::setTcpCommunicator(TcpCommunicator* communicator)
                   this, &LineDrawingDialog::onSavedRoadLinesReceived);
         disconnect(m_tcpCommunicator, &TcpCommunicator::savedDetectionLinesReceived,
                   this, &LineDrawingDialog::onSavedDetectionLinesReceived);
-        disconnect(m_tcpCommunicator, &TcpCommunicator::bboxesReceived,
-                  this, &LineDrawingDialog::onBBoxesReceived);
+        disconnect(m_tcpCommunicator, &TcpCommunicator::bboxFrameReceived,
+                  this, &LineDrawingDialog::onBBoxFrameReceived);
     }
 
     m_tcpCommunicator = communicator;
@@ -751,8 +754,8 @@ void LineDrawingDialog::setTcpCommunicator(TcpCommunicator* communicator)
                 this, &LineDrawingDialog::onSavedRoadLinesReceived);
         connect(m_tcpCommunicator, &TcpCommunicator::savedDetectionLinesReceived,
                 this, &LineDrawingDialog::onSavedDetectionLinesReceived);
-        connect(m_tcpCommunicator, &TcpCommunicator::bboxesReceived,
-                this, &LineDrawingDialog::onBBoxesReceived);
+        connect(m_tcpCommunicator, &TcpCommunicator::bboxFrameReceived,
+                this, &LineDrawingDialog::onBBoxFrameReceived);
         
         qDebug() << "LineDrawingDialog에 TcpCommunicator 설정 완료";
     }
@@ -780,8 +783,8 @@ void LineDrawingDialog::setupTcpConnection()
                 this, &LineDrawingDialog::onSavedDetectionLinesReceived);
 
         // BBox 데이터 수신 시그널 연결
-        connect(m_tcpCommunicator, &TcpCommunicator::bboxesReceived,
-                this, &LineDrawingDialog::onBBoxesReceived);
+        connect(m_tcpCommunicator, &TcpCommunicator::bboxFrameReceived,
+                this, &LineDrawingDialog::onBBoxFrameReceived);
 
         qDebug() << "TCP 통신 설정 완료";
     } else {
@@ -819,7 +822,7 @@ void LineDrawingDialog::onSavedRoadLinesReceived(const QList<RoadLineData> &road
     // 받은 데이터를 모두 출력
     for (int i = 0; i < roadLines.size(); ++i) {
         const auto &roadLine = roadLines[i];
-        qDebug() << QString("수신된 도로선 %1: index=%2, x1=%3, y1=%4, x2=%5, y2=%6, matrix1=%7, matrix2=%8")
+        qCDebug(lcRender) << QString("수신된 도로선 %1: index=%2, x1=%3, y1=%4, x2=%5, y2=%6, matrix1=%7, matrix2=%8")
                         .arg(i).arg(roadLine.index)
                         .arg(roadLine.x1).arg(roadLine.y1).arg(roadLine.x2).arg(roadLine.y2)
                         .arg(roadLine.matrixNum1).arg(roadLine.matrixNum2);
@@ -873,7 +876,7 @@ void LineDrawingDialog::onSavedDetectionLinesReceived(const QList<DetectionLineD
     // 받은 데이터를 모두 출력
     for (int i = 0; i < detectionLines.size(); ++i) {
         const auto &detectionLine = detectionLines[i];
-        qDebug() << QString("수신된 감지선 %1: index=%2, name=%3, x1=%4, y1=%5, x2=%6, y2=%7, mode=%8")
+        qCDebug(lcRender) << QString("수신된 감지선 %1: index=%2, name=%3, x1=%4, y1=%5, x2=%6, y2=%7, mode=%8")
                         .arg(i).arg(detectionLine.index).arg(detectionLine.name)
                         .arg(detectionLine.x1).arg(detectionLine.y1)
                         .arg(detectionLine.x2).arg(detectionLine.y2)
@@ -1805,6 +1808,7 @@ void LineDrawingDialog::generatePerpendicularLine(const CategorizedLine &detecti
 
 void LineDrawingDialog::onLoadSavedLinesClicked()
 {
+    WATCHDOG_SCOPE("LineDrawingDialog::onLoadSavedLinesClicked");
     if (!m_tcpCommunicator) {
         addLogMessage("TCP 통신이 설정되지 않음", "ERROR");
         CustomMessageBox msgBox(nullptr, "오류", "서버 연결이 설정되지 않음");
@@ -1830,67 +1834,54 @@ void LineDrawingDialog::onLoadSavedLinesClicked()
     m_loadedRoadLines.clear();
     m_loadedDetectionLines.clear();
 
-    // 도로선과 감지선을 따로 요청
-    bool roadSuccess = m_tcpCommunicator->requestSavedRoadLines();
-    bool detectionSuccess = m_tcpCommunicator->requestSavedDetectionLines();
-
-    // 상단의 함수들이 완료되고 update 함수가 수행될 수 있도록 delay 0.5초
-    QEventLoop loop;
-    QTimer::singleShot(500, &loop, &QEventLoop::quit);
-    loop.exec();
-
-
-    updateCategoryInfo();
-    updateMappingInfo();
-    updateButtonStates();
+    // 도로선과 감지선을 동시에 요청하고, 두 응답이 모두 도착(또는 타임아웃)하면 화면 갱신
+    // 선 데이터 자체는 savedRoadLinesReceived/savedDetectionLinesReceived 시그널로 반영됨
+    QList<QFuture<TcpResponse>> requests{
+        m_tcpCommunicator->fetchSavedRoadLines(),
+        m_tcpCommunicator->fetchSavedDetectionLines()
+    };
+
+    QtFuture::whenAll(requests.begin(), requests.end())
+        .then(this, [this](const QList<QFuture<TcpResponse>> &results) {
+            updateCategoryInfo();
+            updateMappingInfo();
+            updateButtonStates();
+
+            bool allOk = true;
+            for (const QFuture<TcpResponse> &result : results) {
+                if (!result.isValid() || result.isCanceled() || !result.result().isOk()) {
+                    allOk = false;
+                }
+            }
 
-    if (roadSuccess && detectionSuccess) {
-        addLogMessage("서버에 저장된 선 데이터 요청", "SUCCESS");
-    } else {
-        addLogMessage("저장된 선 데이터 요청 실패", "ERROR");
-        CustomMessageBox msgBox(nullptr, "오류", "저장된 선 데이터 요청 실패");
-        msgBox.setFixedSize(300,150);
-        msgBox.exec();
-    }
+            if (allOk) {
+                addLogMessage("서버에 저장된 선 데이터 요청", "SUCCESS");
+            } else {
+                addLogMessage("저장된 선 데이터 요청 실패", "ERROR");
+                CustomMessageBox msgBox(nullptr, "오류", "저장된 선 데이터 요청 실패");
+                msgBox.setFixedSize(300,150);
+                msgBox.exec();
+            }
+        });
 }
 
 // BBox 데이터 수신 슬롯 구현
-void LineDrawingDialog::onBBoxesReceived(const QList<BBox> &bboxes, qint64 timestamp)
+void LineDrawingDialog::onBBoxFrameReceived(const BBoxFrameSnapshot &frame)
 {
-    qDebug() << QString("Bounding Box 데이터 수신 - %1개 객체, 타임스탬프: %2").arg(bboxes.size()).arg(timestamp);
-    
+    if (!frame) {
+        return;
+    }
+
     // BBox가 비활성화되어 있다면 처리하지 않음
     if (!m_bboxEnabled) {
-        qDebug() << "Bounding Box 비활성화";
         return;
     }
     
-    // VideoGraphicsView에 Bounding Box 전달
+    // VideoGraphicsView에 Bounding Box 전달 (스냅샷을 그대로 넘김, 복사 없음)
     if (m_videoView) {
-        m_videoView->setBBoxes(bboxes, timestamp);
-        
-        // 로그 메시지 추가
-        if (bboxes.isEmpty()) {
-
-        } else {
-            QString objectList;
-            int filteredCount = 0;
-            for (const BBox &bbox : bboxes) {
-                // Vehicle과 Human(Person) 타입만 로그에 표시
-                QString lowerType = bbox.type.toLower();
-                if (lowerType == "vehicle" || lowerType == "person" || lowerType == "human") {
-                    objectList += QString("%1(%2%) ").arg(bbox.type).arg(static_cast<int>(bbox.confidence * 100));
-                    filteredCount++;
-                }
-            }
-            if (filteredCount > 0) {
-
-            } else {
-
-            }
-        }
+        m_videoView->setBBoxes(frame);
     } else {
-        qDebug() << "VideoView null - Bounding Box 표시 불가";
+        qCDebug(lcBBox) << "VideoView null - Bounding Box 표시 불가";
         addLogMessage("Bounding Box 표시 실패 - VideoView를 찾을 수 없음", "ERROR");
     }
 }
@@ -82,7 +82,7 @@ public:
     void drawImmediateTestLines();
 
     // BBox 관련 함수
-    void setBBoxes(const QList<BBox> &bboxes, qint64 timestamp);
+    void setBBoxes(const BBoxFrameSnapshot &frame);
     void clearBBoxes();
     void setOriginalVideoSize(const QSize &size) { m_originalVideoSize = size; }
 
@@ -159,7 +159,7 @@ private slots:
     void onSavedDetectionLinesReceived(const QList<DetectionLineData> &detectionLines);
 
     // BBox 관련 슬롯
-    void onBBoxesReceived(const QList<BBox> &bboxes, qint64 timestamp);
+    void onBBoxFrameReceived(const BBoxFrameSnapshot &frame);
     void onBBoxOnClicked();
     void onBBoxOffClicked();
 
@@ -0,0 +1,215 @@
+#include "Logging.h"
+#include <QDateTime>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QWaitCondition>
+#include <array>
+#include <cstdio>
+#include <memory>
+
+Q_LOGGING_CATEGORY(lcNet, "cctv.net", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcProto, "cctv.proto", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcBBox, "cctv.bbox", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcRender, "cctv.render", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcVideo, "cctv.video", QtInfoMsg)
+
+namespace {
+
+struct SinkState {
+    QMutex mutex;
+    QWaitCondition available;
+    std::array<QByteArray, AsyncLogSink::Capacity> ring;
+    int head = 0;
+    int count = 0;
+    quint64 dropped = 0;
+    quint64 reportedDropped = 0;
+    bool stopping = false;
+    std::unique_ptr<QThread> writer;
+
+    // 파일은 작성 스레드와 setLogFile()만 건드림 (버퍼 잠금과 분리)
+    QMutex fileMutex;
+    QFile file;
+};
+
+SinkState &state()
+{
+    static SinkState sink;
+    return sink;
+}
+
+QByteArray formatLine(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    static const char levels[] = { 'D', 'W', 'C', 'F', 'I' };
+    QByteArray line = QTime::currentTime().toString("HH:mm:ss.zzz").toLatin1();
+    line += ' ';
+    line += (type >= 0 && type < int(sizeof(levels))) ? levels[type] : '?';
+    line += ' ';
+    if (context.category && qstrcmp(context.category, "default") != 0) {
+        line += context.category;
+        line += ": ";
+    }
+    line += message.toUtf8();
+    line += '\n';
+    return line;
+}
+
+void writeOut(SinkState &sink, const QByteArray &data)
+{
+    std::fwrite(data.constData(), 1, size_t(data.size()), stderr);
+    std::fflush(stderr);
+
+    QMutexLocker locker(&sink.fileMutex);
+    if (sink.file.isOpen()) {
+        sink.file.write(data);
+        sink.file.flush();
+    }
+}
+
+void writerLoop()
+{
+    SinkState &sink = state();
+    QByteArray batch;
+
+    forever {
+        quint64 newlyDropped = 0;
+        {
+            QMutexLocker locker(&sink.mutex);
+            while (sink.count == 0 && !sink.stopping) {
+                sink.available.wait(&sink.mutex);
+            }
+            if (sink.count == 0 && sink.stopping) {
+                break;
+            }
+
+            // 잠금은 버퍼에서 꺼내는 동안만
+            batch.clear();
+            while (sink.count > 0) {
+                batch += sink.ring[sink.head];
+                sink.ring[sink.head].clear();
+                sink.head = (sink.head + 1) % AsyncLogSink::Capacity;
+                sink.count--;
+            }
+            newlyDropped = sink.dropped - sink.reportedDropped;
+            sink.reportedDropped = sink.dropped;
+        }
+
+        if (newlyDropped > 0) {
+            batch += QByteArray("-- log buffer full, dropped ") + QByteArray::number(newlyDropped) + " lines\n";
+        }
+        writeOut(sink, batch);
+    }
+}
+
+void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    SinkState &sink = state();
+    QByteArray line = formatLine(type, context, message);
+
+    QMutexLocker locker(&sink.mutex);
+    if (type == QtFatalMsg || !sink.writer) {
+        // 치명적 오류는 프로그램이 곧 종료되므로 버퍼를 거치지 않고 바로 씀
+        writeOut(sink, line);
+        return;
+    }
+
+    if (sink.count == AsyncLogSink::Capacity) {
+        sink.dropped++;
+        return;
+    }
+    sink.ring[(sink.head + sink.count) % AsyncLogSink::Capacity] = std::move(line);
+    sink.count++;
+    sink.available.wakeOne();
+}
+
+}
+
+void AsyncLogSink::install()
+{
+    SinkState &sink = state();
+    {
+        QMutexLocker locker(&sink.mutex);
+        if (sink.writer) {
+            return;
+        }
+        sink.stopping = false;
+        sink.writer.reset(QThread::create(writerLoop));
+        sink.writer->setObjectName("LogWriter");
+    }
+    sink.writer->start(QThread::LowPriority);
+    qInstallMessageHandler(messageHandler);
+}
+
+void AsyncLogSink::shutdown()
+{
+    SinkState &sink = state();
+    {
+        QMutexLocker locker(&sink.mutex);
+        if (!sink.writer) {
+            return;
+        }
+        sink.stopping = true;
+        sink.available.wakeOne();
+    }
+    sink.writer->wait();
+
+    {
+        // 작성 스레드가 끝난 뒤 다른 스레드가 남긴 줄도 버리지 않고 기록 (이후 줄은 바로 씀)
+        QMutexLocker locker(&sink.mutex);
+        QByteArray batch;
+        while (sink.count > 0) {
+            batch += sink.ring[sink.head];
+            sink.ring[sink.head].clear();
+            sink.head = (sink.head + 1) % AsyncLogSink::Capacity;
+            sink.count--;
+        }
+        quint64 newlyDropped = sink.dropped - sink.reportedDropped;
+        sink.reportedDropped = sink.dropped;
+        if (newlyDropped > 0) {
+            batch += QByteArray("-- log buffer full, dropped ") + QByteArray::number(newlyDropped) + " lines\n";
+        }
+        if (!batch.isEmpty()) {
+            writeOut(sink, batch);
+        }
+        sink.writer.reset();
+    }
+    QMutexLocker locker(&sink.fileMutex);
+    if (sink.file.isOpen()) {
+        sink.file.close();
+    }
+}
+
+void AsyncLogSink::setLogFile(const QString &path)
+{
+    SinkState &sink = state();
+    QMutexLocker locker(&sink.fileMutex);
+    if (sink.file.isOpen()) {
+        sink.file.close();
+    }
+    if (path.isEmpty()) {
+        return;
+    }
+
+    sink.file.setFileName(path);
+    if (!sink.file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        QByteArray error = "Failed to open log file: " + path.toUtf8() + " - " + sink.file.errorString().toUtf8() + "\n";
+        std::fwrite(error.constData(), 1, size_t(error.size()), stderr);
+    }
+}
+
+void AsyncLogSink::applyRules(const QString &rules)
+{
+    if (rules.isEmpty()) {
+        return;
+    }
+    QString filterRules = rules;
+    QLoggingCategory::setFilterRules(filterRules.replace(';', '\n'));
+}
+
+quint64 AsyncLogSink::droppedCount()
+{
+    SinkState &sink = state();
+    QMutexLocker locker(&sink.mutex);
+    return sink.dropped;
+}
@@ -0,0 +1,38 @@
+#ifndef LOGGING_H
+#define LOGGING_H
+
+#include <QLoggingCategory>
+#include <QString>
+
+// 자주 호출되는 경로의 로그 카테고리
+// 디버그 출력은 기본적으로 꺼져 있으며, 꺼진 카테고리의 qCDebug()는 인자를 평가하지 않는다.
+// 켜기: .env의 LOG_RULES=cctv.bbox.debug=true;cctv.net.debug=true (또는 QT_LOGGING_RULES)
+// 릴리스에서 디버그 로그를 아예 빼려면 qmake CONFIG+=strip_debug_logs (QT_NO_DEBUG_OUTPUT)
+Q_DECLARE_LOGGING_CATEGORY(lcNet)       // 소켓 송수신, 프레임 단위
+Q_DECLARE_LOGGING_CATEGORY(lcProto)     // 메시지 내용, 응답 처리 결과
+Q_DECLARE_LOGGING_CATEGORY(lcBBox)      // BBox 스트림과 오버레이
+Q_DECLARE_LOGGING_CATEGORY(lcRender)    // 선 그리기, 마우스 입력
+Q_DECLARE_LOGGING_CATEGORY(lcVideo)     // RTSP 재생 상태
+
+// 비동기 로그 출력
+// 메시지 핸들러는 한 줄로 만든 로그를 고정 크기 링 버퍼에 넣기만 하고,
+// stderr(와 로그 파일) 쓰기는 전용 스레드가 모아서 처리한다. 버퍼가 가득 차면 새 로그는 버리고 개수만 센다.
+class AsyncLogSink
+{
+public:
+    static constexpr int Capacity = 4096;
+
+    // main() 시작 직후 한 번 호출
+    static void install();
+    // 남은 로그를 모두 쓰고 스레드 종료 (이후 로그는 바로 stderr로)
+    static void shutdown();
+
+    // stderr와 함께 파일에도 기록 (빈 경로면 중지)
+    static void setLogFile(const QString &path);
+    // 세미콜론으로 구분한 QLoggingCategory 규칙 (LOG_RULES)
+    static void applyRules(const QString &rules);
+
+    static quint64 droppedCount();
+};
+
+#endif // LOGGING_H
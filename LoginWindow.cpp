@@ -167,6 +167,8 @@ void LoginWindow::setupConnectionTimer()
     m_connectionTimer = new QTimer(this);
     m_connectionTimer->setInterval(5000); // 5초
     connect(m_connectionTimer, &QTimer::timeout, this, &LoginWindow::checkConnectionStatus);
+    // 로그인 후에는 재연결을 워커의 백오프에 맡김 (창은 세션 내내 살아 있음)
+    connect(this, &QDialog::accepted, m_connectionTimer, &QTimer::stop);
     m_connectionTimer->start();
 }
 
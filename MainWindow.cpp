@@ -3,6 +3,7 @@
 #include "NetworkConfigDialog.h"
 #include "EnvConfig.h"
 #include "custommessagebox.h"
+#include "EventLoopWatchdog.h"
 #include <QApplication>
 #include <QStackedLayout>
 #include <QMessageBox>
@@ -17,6 +18,9 @@
 #include <QComboBox>
 #include <QCalendarWidget>
 #include <QDialog>
+#include <QShortcut>
+#include <QScrollBar>
+#include <QFileInfo>
 
 // ClickableImageLabel 구현
 ClickableImageLabel::ClickableImageLabel(QWidget *parent)
@@ -26,11 +30,23 @@ ClickableImageLabel::ClickableImageLabel(QWidget *parent)
     setStyleSheet("border: 2px solid #ddd; border-radius: 8px; padding: 5px; background-color: white;");
 }
 
-void ClickableImageLabel::setImageData(const QString &imagePath, const QString &timestamp, const QString &logText)
+void ClickableImageLabel::setImageData(const QString &imagePath, const QString &timestamp, const QString &logText,
+                                       const QString &imageId)
 {
     m_imagePath = imagePath;
     m_timestamp = timestamp;
     m_logText = logText;
+    m_imageId = imageId;
+}
+
+void ClickableImageLabel::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        emit clicked(m_imagePath, m_timestamp, m_logText, m_imageId);
+        event->accept();
+        return;
+    }
+    QLabel::mousePressEvent(event);
 }
 
 void MainWindow::mousePressEvent(QMouseEvent *event)
@@ -86,18 +102,26 @@ MainWindow::MainWindow(QWidget *parent)
     , m_dateEdit(nullptr)
     , m_hourSpinBox(nullptr)
     , m_requestButton(nullptr)
+    , m_statusLabel(nullptr)
     , m_networkButton(nullptr)
     , m_rtspUrl("")  // 빈 문자열로 초기화
     , m_tcpHost("")  // 빈 문자열로 초기화
     , m_tcpPort(0)   // 0으로 초기화
     , m_isConnected(false)
+    , m_hasConnectedOnce(false)
     , m_tcpCommunicator(nullptr)
     , m_networkManager(nullptr)
     , m_updateTimer(nullptr)
-    , m_requestTimeoutTimer(nullptr)
     , m_imageViewerDialog(nullptr)
     , m_networkDialog(nullptr)
     , m_lineDrawingDialog(nullptr)
+    , m_diagnosticsDialog(nullptr)
+    , m_imagePageSize(24)
+    , m_imageQueryHour(-1)
+    , m_imagePageLoading(false)
+    , m_imageQueryGeneration(0)
+    , m_displayedImageCount(0)
+    , m_imageTotal(-1)
 {
     // .env 파일 로드
     EnvConfig::loadFromFile(".env");
@@ -106,6 +130,7 @@ MainWindow::MainWindow(QWidget *parent)
     m_rtspUrl = EnvConfig::getValue("RTSP_URL", "rtsp://192.168.0.81:8554/original");
     m_tcpHost = EnvConfig::getValue("TCP_HOST", "192.168.0.81");
     m_tcpPort = EnvConfig::getValue("TCP_PORT", "8080").toInt();
+    m_imagePageSize = qMax(1, EnvConfig::getValue("IMAGE_PAGE_SIZE", "24").toInt());
 
     qDebug() << "[MainWindow] .env 설정 로드됨 - RTSP:" << m_rtspUrl << "TCP:" << m_tcpHost << ":" << m_tcpPort;
 
@@ -141,9 +166,6 @@ MainWindow::~MainWindow()
     if (m_updateTimer) {
         m_updateTimer->stop();
     }
-    if (m_requestTimeoutTimer) {
-        m_requestTimeoutTimer->stop();
-    }
     if (m_calendarDialog) {
         delete m_calendarDialog;
     }
@@ -154,42 +176,57 @@ void MainWindow::setTcpCommunicator(TcpCommunicator* communicator)
 {
     // 기존 연결 해제
     if (m_tcpCommunicator && m_tcpCommunicator != communicator) {
+        // 진단 창은 이전 통신 객체를 가리키므로 다시 만듦
+        delete m_diagnosticsDialog;
+        m_diagnosticsDialog = nullptr;
+
         disconnect(m_tcpCommunicator, &TcpCommunicator::connected,
                    this, &MainWindow::onTcpConnected);
         disconnect(m_tcpCommunicator, &TcpCommunicator::disconnected,
                    this, &MainWindow::onTcpDisconnected);
+        disconnect(m_tcpCommunicator, &TcpCommunicator::reconnected,
+                   this, &MainWindow::onTcpReconnected);
+        disconnect(m_tcpCommunicator, &TcpCommunicator::rttUpdated,
+                   this, &MainWindow::onTcpRttUpdated);
         disconnect(m_tcpCommunicator, &TcpCommunicator::errorOccurred,
                    this, &MainWindow::onTcpError);
         disconnect(m_tcpCommunicator, &TcpCommunicator::messageReceived,
                    this, &MainWindow::onTcpDataReceived);
-        disconnect(m_tcpCommunicator, &TcpCommunicator::imagesReceived,
-                   this, &MainWindow::onImagesReceived);
         disconnect(m_tcpCommunicator, &TcpCommunicator::coordinatesConfirmed,
                    this, &MainWindow::onCoordinatesConfirmed);
         disconnect(m_tcpCommunicator, &TcpCommunicator::statusUpdated,
                    this, &MainWindow::onStatusUpdated);
         disconnect(m_tcpCommunicator, &TcpCommunicator::perpendicularLineConfirmed,
                    this, nullptr);
+        disconnect(m_tcpCommunicator, &TcpCommunicator::lineBatchResult,
+                   this, &MainWindow::onLineBatchResult);
     }
 
     m_tcpCommunicator = communicator;
 
     // 새로운 통신기에 시그널 연결
     if (m_tcpCommunicator) {
+        // 그리드 타일(300x200) 크기의 썸네일만 받고 원본은 클릭할 때
+        m_tcpCommunicator->setThumbnailSize(QSize(300, 200));
+
         connect(m_tcpCommunicator, &TcpCommunicator::connected,
                 this, &MainWindow::onTcpConnected);
         connect(m_tcpCommunicator, &TcpCommunicator::disconnected,
                 this, &MainWindow::onTcpDisconnected);
+        connect(m_tcpCommunicator, &TcpCommunicator::reconnected,
+                this, &MainWindow::onTcpReconnected);
+        connect(m_tcpCommunicator, &TcpCommunicator::rttUpdated,
+                this, &MainWindow::onTcpRttUpdated);
         connect(m_tcpCommunicator, &TcpCommunicator::errorOccurred,
                 this, &MainWindow::onTcpError);
         connect(m_tcpCommunicator, &TcpCommunicator::messageReceived,
                 this, &MainWindow::onTcpDataReceived);
-        connect(m_tcpCommunicator, &TcpCommunicator::imagesReceived,
-                this, &MainWindow::onImagesReceived);
         connect(m_tcpCommunicator, &TcpCommunicator::coordinatesConfirmed,
                 this, &MainWindow::onCoordinatesConfirmed);
         connect(m_tcpCommunicator, &TcpCommunicator::statusUpdated,
                 this, &MainWindow::onStatusUpdated);
+        connect(m_tcpCommunicator, &TcpCommunicator::lineBatchResult,
+                this, &MainWindow::onLineBatchResult);
         connect(m_tcpCommunicator, &TcpCommunicator::perpendicularLineConfirmed,
                 this, [this](bool success, const QString &message) {
                     qDebug() << "수직선 서버 응답 - 성공:" << success << "메시지:" << message;
@@ -230,6 +267,11 @@ void MainWindow::setupUI()
 
     headerLayout->addWidget(titleLabel, 0, 0, 1, 3, Qt::AlignHCenter);
 
+    // 연결 상태 / 하트비트 RTT 표시
+    m_statusLabel = new QLabel("서버 연결 안 됨");
+    m_statusLabel->setStyleSheet("background-color: transparent; color: #A0A3B1; font-size: 12px;");
+    headerLayout->addWidget(m_statusLabel, 0, 0, Qt::AlignLeft | Qt::AlignVCenter);
+
 
     // 네트워크 버튼
     m_networkButton = new QPushButton();
@@ -295,6 +337,10 @@ void MainWindow::setupUI()
 
     connect(m_networkButton,&QPushButton::clicked,this,&MainWindow::onNetworkConfigClicked);
     connect(m_closeButton, &QPushButton::clicked, this, &MainWindow::close);
+
+    // 운영자용 네트워크 진단 창
+    QShortcut *diagnosticsShortcut = new QShortcut(QKeySequence("Ctrl+Shift+D"), this);
+    connect(diagnosticsShortcut, &QShortcut::activated, this, &MainWindow::onDiagnosticsRequested);
 }
 
 void MainWindow::setupLiveVideoTab()
@@ -612,6 +658,10 @@ void MainWindow::setupCapturedImageTab()
     m_imageScrollArea->setWidget(m_imageGridWidget);
     mainLayout->addWidget(m_imageScrollArea);
 
+    // 끝에 가까워지면 다음 페이지 요청
+    connect(m_imageScrollArea->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &MainWindow::onImageScrolled);
+
     m_tabWidget->addTab(m_capturedImageTab, "Captured Images");
 }
 
@@ -630,9 +680,10 @@ void MainWindow::setupNetworkConnection()
         // 수정된 시그널 연결 - 개별 시그널로 분리
         connect(m_tcpCommunicator, &TcpCommunicator::connected, this, &MainWindow::onTcpConnected);
         connect(m_tcpCommunicator, &TcpCommunicator::disconnected, this, &MainWindow::onTcpDisconnected);
+        connect(m_tcpCommunicator, &TcpCommunicator::reconnected, this, &MainWindow::onTcpReconnected);
+        connect(m_tcpCommunicator, &TcpCommunicator::rttUpdated, this, &MainWindow::onTcpRttUpdated);
         connect(m_tcpCommunicator, &TcpCommunicator::errorOccurred, this, &MainWindow::onTcpError);
         connect(m_tcpCommunicator, &TcpCommunicator::messageReceived, this, &MainWindow::onTcpDataReceived);
-        connect(m_tcpCommunicator, &TcpCommunicator::imagesReceived, this, &MainWindow::onImagesReceived);
 
         // 새로운 JSON 기반 시그널 연결
         connect(m_tcpCommunicator, &TcpCommunicator::coordinatesConfirmed, this, &MainWindow::onCoordinatesConfirmed);
@@ -655,12 +706,6 @@ void MainWindow::setupNetworkConnection()
                 });
     }
 
-    // 이미지 요청 타임아웃 타이머 설정
-    m_requestTimeoutTimer = new QTimer(this);
-    m_requestTimeoutTimer->setSingleShot(true);
-    m_requestTimeoutTimer->setInterval(30000);
-    connect(m_requestTimeoutTimer, &QTimer::timeout, this, &MainWindow::onRequestTimeout);
-
     m_imageViewerDialog = new ImageViewerDialog(this);
     m_imageViewerDialog->setWindowFlags(Qt::Window | Qt::FramelessWindowHint);
 }
@@ -680,11 +725,9 @@ void MainWindow::clearImageGrid()
     }
 }
 
-void MainWindow::displayImages(const QList<ImageData> &images)
+void MainWindow::appendImages(const QList<ImageData> &images)
 {
-    clearImageGrid();
-
-    if (images.isEmpty()) {
+    if (images.isEmpty() && m_displayedImageCount == 0) {
         QLabel *emptyLabel = new QLabel("해당 시간대에 캡처된 이미지가 없습니다.");
         emptyLabel->setAlignment(Qt::AlignCenter);
         emptyLabel->setStyleSheet("color: #999; font-size: 16px; padding: 50px;");
@@ -692,18 +735,20 @@ void MainWindow::displayImages(const QList<ImageData> &images)
         return;
     }
 
-    int row = 0;
-    int col = 0;
+    // 이미 표시한 이미지 뒤에 이어 붙임 (2열)
+    int row = m_displayedImageCount / 2;
+    int col = m_displayedImageCount % 2;
 
     for (const ImageData &imageData : images) {
         ClickableImageLabel *imageLabel = new ClickableImageLabel();
         imageLabel->setFixedSize(300, 200);
         imageLabel->setScaledContents(true);
-        imageLabel->setImageData(imageData.imagePath, imageData.timestamp, imageData.logText);
+        imageLabel->setImageData(imageData.imagePath, imageData.timestamp, imageData.logText, imageData.imageId);
         imageLabel->setStyleSheet("border: none; padding: 2px; margin:0px");
 
+        // 그리드에는 썸네일만 디코딩 (원본은 클릭할 때)
         QPixmap pixmap;
-        if (pixmap.load(imageData.imagePath)) {
+        if (pixmap.load(imageData.thumbnailPath.isEmpty() ? imageData.imagePath : imageData.thumbnailPath)) {
             imageLabel->setPixmap(pixmap);
         } else {
             imageLabel->setText("이미지 로드 실패");
@@ -735,6 +780,7 @@ void MainWindow::displayImages(const QList<ImageData> &images)
         connect(imageLabel, &ClickableImageLabel::clicked, this, &MainWindow::onImageClicked);
 
         m_imageGridLayout->addWidget(container, row, col);
+        m_displayedImageCount++;
 
         col++;
         if (col >= 2) {
@@ -747,6 +793,21 @@ void MainWindow::displayImages(const QList<ImageData> &images)
 }
 
 
+void MainWindow::onDiagnosticsRequested()
+{
+    if (!m_tcpCommunicator) {
+        return;
+    }
+
+    if (!m_diagnosticsDialog) {
+        m_diagnosticsDialog = new DiagnosticsDialog(m_tcpCommunicator, this);
+    }
+
+    m_diagnosticsDialog->show();
+    m_diagnosticsDialog->raise();
+    m_diagnosticsDialog->activateWindow();
+}
+
 void MainWindow::onNetworkConfigClicked()
 {
     if (!m_networkDialog) {
@@ -937,10 +998,66 @@ void MainWindow::onRequestImagesClicked()
     int selectedHour = m_hourComboBox->currentData().toInt();
     QString dateString = m_selectedDate.toString("yyyy-MM-dd");
 
-    // JSON 기반 이미지 요청
-    m_tcpCommunicator->requestImageData(dateString, selectedHour);
+    // 새 조회 시작 - 첫 페이지만 바로 받고 나머지는 스크롤할 때 받음
+    m_imageQueryGeneration++;
+    m_imageQueryDate = dateString;
+    m_imageQueryHour = selectedHour;
+    m_imageNextCursor.clear();
+    m_imagePageLoading = false;
+    m_displayedImageCount = 0;
+    m_imageTotal = -1;
+    m_fullImagePaths.clear();
+    m_fullImageRequests.clear();
+    clearImageGrid();
+
+    m_requestButton->setEnabled(false);
+    fetchNextImagePage();
+
+    qDebug() << QString("JSON 이미지 요청: %1, %2시~%3시 (페이지당 %4개)")
+                    .arg(dateString).arg(selectedHour).arg(selectedHour + 1).arg(m_imagePageSize);
+}
+
+void MainWindow::fetchNextImagePage()
+{
+    if (m_imagePageLoading || !m_tcpCommunicator) {
+        return;
+    }
+
+    // 결과(이미지/타임아웃)는 요청별 future로 받음
+    m_imagePageLoading = true;
+    quint64 generation = m_imageQueryGeneration;
+    m_tcpCommunicator->requestImagePage(m_imageQueryDate, m_imageQueryHour, m_imagePageSize, m_imageNextCursor)
+        .then(this, [this, generation](const TcpResponse &response) {
+            if (generation != m_imageQueryGeneration) {
+                return;
+            }
+            m_imagePageLoading = false;
+
+            switch (response.status) {
+            case TcpResponse::Ok:
+                onImagePageReceived(response.payload.value<ImagePage>());
+                break;
+            case TcpResponse::Timeout:
+                onRequestTimeout();
+                break;
+            default:
+                m_requestButton->setEnabled(m_isConnected);
+                break;
+            }
+        });
+}
+
+void MainWindow::onImageScrolled(int value)
+{
+    if (m_imageNextCursor.isEmpty() || m_imagePageLoading) {
+        return;
+    }
 
-    qDebug() << QString("JSON 이미지 요청: %1, %2시~%3시").arg(dateString).arg(selectedHour).arg(selectedHour + 1);
+    // 남은 스크롤이 한 화면 높이 이하이면 미리 다음 페이지 요청
+    QScrollBar *scrollBar = m_imageScrollArea->verticalScrollBar();
+    if (scrollBar->maximum() - value <= scrollBar->pageStep()) {
+        fetchNextImagePage();
+    }
 }
 
 void MainWindow::onTcpConnected()
@@ -951,13 +1068,32 @@ void MainWindow::onTcpConnected()
     if (m_requestButton) {
         m_requestButton->setEnabled(true);
     }
+    if (m_statusLabel) {
+        m_statusLabel->setText("서버 연결됨");
+    }
 
+    if (m_hasConnectedOnce) {
+        return;
+    }
+    m_hasConnectedOnce = true;
 
     CustomMessageBox msgBox(nullptr, "연결 성공", "TCP 서버에 성공적으로 연결되었습니다.");
     msgBox.setFixedSize(300,150);
     msgBox.exec();
 }
 
+void MainWindow::onTcpReconnected(qint64 outageMs)
+{
+    qDebug() << QString("TCP 서버 재연결 - 복구 시간: %1초").arg(outageMs / 1000.0, 0, 'f', 1);
+}
+
+void MainWindow::onTcpRttUpdated(int rttMs, int jitterMs)
+{
+    if (m_statusLabel) {
+        m_statusLabel->setText(QString("서버 연결됨 · RTT %1 ms · 지터 %2 ms").arg(rttMs).arg(jitterMs));
+    }
+}
+
 void MainWindow::onTcpDisconnected()
 {
     m_isConnected = false;
@@ -966,6 +1102,9 @@ void MainWindow::onTcpDisconnected()
     if (m_requestButton) {
         m_requestButton->setEnabled(false);
     }
+    if (m_statusLabel) {
+        m_statusLabel->setText("서버 연결 끊김 - 재연결 중");
+    }
 
 
 }
@@ -994,20 +1133,72 @@ void MainWindow::onTcpPacketReceived(int requestId, int success, const QString &
     qDebug() << QString("TCP 패킷 수신 - ID: %1, 성공: %2").arg(requestId).arg(success);
 }
 
-void MainWindow::onImagesReceived(const QList<ImageData> &images)
+void MainWindow::onImagePageReceived(const ImagePage &page)
 {
-    qDebug() << QString("이미지 리스트 수신: %1개").arg(images.size());
-
-    if (m_requestTimeoutTimer->isActive()) {
-        m_requestTimeoutTimer->stop();
+    WATCHDOG_SCOPE("MainWindow::onImagePageReceived");
+    if (page.total >= 0) {
+        m_imageTotal = page.total;
     }
+    qDebug() << QString("이미지 페이지 수신: %1개 (표시 %2 / 전체 %3)%4")
+                    .arg(page.images.size()).arg(m_displayedImageCount + page.images.size())
+                    .arg(m_imageTotal >= 0 ? QString::number(m_imageTotal) : QString("?"))
+                    .arg(page.hasMore() ? " - 다음 페이지 있음" : "");
 
-    displayImages(images);
+    appendImages(page.images);
+    m_imageNextCursor = page.nextCursor;
 
     m_requestButton->setEnabled(true);
+
+    // 첫 페이지가 화면을 채우지 못해 스크롤할 수 없으면 바로 다음 페이지를 받음
+    if (page.hasMore() && !page.images.isEmpty()) {
+        QTimer::singleShot(0, this, [this]() {
+            onImageScrolled(m_imageScrollArea->verticalScrollBar()->value());
+        });
+    }
 }
 
-void MainWindow::onImageClicked(const QString &imagePath, const QString &timestamp, const QString &logText)
+void MainWindow::onImageClicked(const QString &imagePath, const QString &timestamp, const QString &logText, const QString &imageId)
+{
+    QString fullImagePath = imagePath.isEmpty() ? m_fullImagePaths.value(imageId) : imagePath;
+    // 캐시 용량 때문에 지워진 원본은 다시 받음
+    if (!fullImagePath.isEmpty() && !imageId.isEmpty() && !QFileInfo::exists(fullImagePath)) {
+        m_fullImagePaths.remove(imageId);
+        fullImagePath.clear();
+    }
+    if (!fullImagePath.isEmpty() || imageId.isEmpty() || !m_tcpCommunicator) {
+        showFullImage(fullImagePath, timestamp, logText);
+        return;
+    }
+
+    // 썸네일만 받은 이미지 - 원본을 받아 온 뒤 보여 줌 (같은 이미지를 연달아 누르면 한 번만 요청)
+    if (m_fullImageRequests.contains(imageId)) {
+        return;
+    }
+    m_fullImageRequests.insert(imageId);
+    quint64 generation = m_imageQueryGeneration;
+    m_tcpCommunicator->requestFullImage(imageId)
+        .then(this, [this, generation, imageId, timestamp, logText](const TcpResponse &response) {
+            // 그 사이 새로 조회했으면 같은 ID가 다른 이미지를 가리킬 수 있음
+            if (generation != m_imageQueryGeneration) {
+                return;
+            }
+            m_fullImageRequests.remove(imageId);
+
+            ImagePage page = response.payload.value<ImagePage>();
+            if (!response.isOk() || page.images.isEmpty() || page.images.first().imagePath.isEmpty()) {
+                qDebug() << "원본 이미지 요청 실패 - image_id:" << imageId << "상태:" << response.status;
+                CustomMessageBox msgBox(nullptr, "이미지 로드 오류", "원본 이미지를 받지 못했습니다.");
+                msgBox.setFixedSize(300,150);
+                msgBox.exec();
+                return;
+            }
+
+            m_fullImagePaths.insert(imageId, page.images.first().imagePath);
+            showFullImage(page.images.first().imagePath, timestamp, logText);
+        });
+}
+
+void MainWindow::showFullImage(const QString &imagePath, const QString &timestamp, const QString &logText)
 {
     QPixmap pixmap;
     if (pixmap.load(imagePath)) {
@@ -1027,14 +1218,15 @@ void MainWindow::updateLogDisplay()
 
 void MainWindow::onRequestTimeout()
 {
-    qDebug() << "이미지 요청 타임아웃 (60초)";
+    int timeoutSeconds = TcpCommunicator::DefaultRequestTimeoutMs / 1000;
+    qDebug() << "이미지 요청 타임아웃" << timeoutSeconds << "초";
 
 
     m_requestButton->setEnabled(m_isConnected);
 
     CustomMessageBox msgBox(nullptr, "요청 타임아웃",
-                            "서버에서 60초 내에 응답이 없습니다.\n"
-                            "서버 상태와 네트워크 연결을 확인하고 다시 시도해주세요.");
+                            QString("서버에서 %1초 내에 응답이 없습니다.\n"
+                                    "서버 상태와 네트워크 연결을 확인하고 다시 시도해주세요.").arg(timeoutSeconds));
     msgBox.setFixedSize(300,150);
     msgBox.exec();
 }
@@ -1078,23 +1270,10 @@ void MainWindow::onStatusUpdated(const QString &status)
 void MainWindow::sendCategorizedCoordinates(const QList<RoadLineData> &roadLines, const QList<DetectionLineData> &detectionLines)
 {
     if (m_tcpCommunicator && m_tcpCommunicator->isConnectedToServer()) {
-        // 새로운 RoadLineData 구조를 직접 사용
-        if (!roadLines.isEmpty()) {
-            bool roadSuccess = m_tcpCommunicator->sendMultipleRoadLines(roadLines);
-            if (roadSuccess) {
-                qDebug() << "도로선 전송 완료:" << roadLines.size() << "개";
-            }
+        // 도로선과 감지선을 한 번에 업로드 - 선별 결과는 onLineBatchResult에서 처리
+        if (m_tcpCommunicator->sendLineBatch(roadLines, detectionLines)) {
+            qDebug() << "카테고리별 좌표 전송 요청 - 도로선:" << roadLines.size() << "개, 감지선:" << detectionLines.size() << "개";
         }
-
-        // 감지선 전송 (기존 방식 유지)
-        if (!detectionLines.isEmpty()) {
-            bool detectionSuccess = m_tcpCommunicator->sendMultipleDetectionLines(detectionLines);
-            if (detectionSuccess) {
-                qDebug() << "감지선 전송 완료:" << detectionLines.size() << "개";
-            }
-        }
-
-        qDebug() << "카테고리별 좌표 전송 완료 - 도로선:" << roadLines.size() << "개, 감지선:" << detectionLines.size() << "개";
     } else {
         qDebug() << "TCP 연결이 없어 좌표 전송 실패";
         CustomMessageBox msgBox(nullptr, "전송 실패", "서버에 연결되어 있지 않습니다.");
@@ -1102,3 +1281,25 @@ void MainWindow::sendCategorizedCoordinates(const QList<RoadLineData> &roadLines
         msgBox.exec();
     }
 }
+
+void MainWindow::onLineBatchResult(const QList<LineUploadResult> &results)
+{
+    QStringList failures;
+    int unconfirmed = 0;
+    for (const auto &result : results) {
+        if (!result.success) {
+            failures.append(QString("%1 #%2 %3").arg(result.kind).arg(result.index).arg(result.message));
+        } else if (!result.confirmed) {
+            ++unconfirmed;
+        }
+    }
+
+    qDebug() << "선 업로드 결과 - 전체:" << results.size() << "실패:" << failures.size()
+             << "전송만 완료(서버 미확인):" << unconfirmed;
+
+    if (!failures.isEmpty()) {
+        CustomMessageBox msgBox(nullptr, "전송 실패", "일부 선 전송에 실패했습니다:\n" + failures.join("\n"));
+        msgBox.setFixedSize(300,150);
+        msgBox.exec();
+    }
+}
@@ -24,6 +24,7 @@
 #include "ImageViewerDialog.h"
 #include "NetworkConfigDialog.h"
 #include "LineDrawingDialog.h"
+#include "DiagnosticsDialog.h"
 
 // 클릭 가능한 이미지 라벨 클래스
 class ClickableImageLabel : public QLabel
@@ -32,16 +33,21 @@ class ClickableImageLabel : public QLabel
 
 public:
     explicit ClickableImageLabel(QWidget *parent = nullptr);
-    void setImageData(const QString &imagePath, const QString &timestamp, const QString &logText);
+    // imagePath가 비어 있으면 (썸네일만 받은 경우) 클릭할 때 imageId로 원본을 받아 옴
+    void setImageData(const QString &imagePath, const QString &timestamp, const QString &logText,
+                      const QString &imageId = QString());
 
 signals:
-    void clicked(const QString &imagePath, const QString &timestamp, const QString &logText);
+    void clicked(const QString &imagePath, const QString &timestamp, const QString &logText, const QString &imageId);
 
+protected:
+    void mousePressEvent(QMouseEvent *event) override;
 
 private:
     QString m_imagePath;
     QString m_timestamp;
     QString m_logText;
+    QString m_imageId;
 };
 
 class MainWindow : public QMainWindow
@@ -62,6 +68,7 @@ protected:
 
 private slots:
     void onNetworkConfigClicked();
+    void onDiagnosticsRequested();
     void onVideoStreamClicked();
     void onDateChanged(const QDate &date);
     void onHourChanged(int hour);
@@ -73,16 +80,20 @@ private slots:
     void onRequestImagesClicked();
     void onTcpConnected();
     void onTcpDisconnected();
+    void onTcpReconnected(qint64 outageMs);
+    void onTcpRttUpdated(int rttMs, int jitterMs);
     void onTcpError(const QString &error);
     void onTcpDataReceived(const QString &data);
     void onTcpPacketReceived(int requestId, int success, const QString &data1, const QString &data2, const QString &data3);
-    void onImagesReceived(const QList<ImageData> &images);
-    void onImageClicked(const QString &imagePath, const QString &timestamp, const QString &logText);
+    void onImagePageReceived(const ImagePage &page);
+    void onImageScrolled(int value);
+    void onImageClicked(const QString &imagePath, const QString &timestamp, const QString &logText, const QString &imageId);
     void updateLogDisplay();
     void onRequestTimeout();
     void onStreamError(const QString &error);
     void onCoordinatesConfirmed(bool success, const QString &message);
     void onStatusUpdated(const QString &status);
+    void onLineBatchResult(const QList<LineUploadResult> &results);
 
 private:
     void setupUI();
@@ -94,7 +105,9 @@ private:
     QString getWarningButtonStyle(bool isActive);
     void updateWarningButtonStyles();
     void clearImageGrid();
-    void displayImages(const QList<ImageData> &images);
+    void appendImages(const QList<ImageData> &images);
+    void fetchNextImagePage();
+    void showFullImage(const QString &imagePath, const QString &timestamp, const QString &logText);
     void sendMultipleLineCoordinates(const QList<QPair<QPoint, QPoint>> &lines);
     void sendSingleLineCoordinates(int x1, int y1, int x2, int y2);
     void sendCategorizedCoordinates(const QList<RoadLineData> &roadLines, const QList<DetectionLineData> &detectionLines);
@@ -137,21 +150,35 @@ private:
     QString m_tcpHost;
     int m_tcpPort;
     bool m_isConnected;
+    bool m_hasConnectedOnce;        // 자동 재연결 때는 연결 성공 안내창을 다시 띄우지 않음
 
     // 네트워크 관련
     TcpCommunicator *m_tcpCommunicator;
     QNetworkAccessManager *m_networkManager;
     QTimer *m_updateTimer;
-    QTimer *m_requestTimeoutTimer;
 
     // 다이얼로그
     ImageViewerDialog *m_imageViewerDialog;
     NetworkConfigDialog *m_networkDialog;
     LineDrawingDialog *m_lineDrawingDialog;
+    DiagnosticsDialog *m_diagnosticsDialog;
 
     // 상태 관리
     QList<bool> m_warningStates;
     QDate m_selectedDate;
+
+    // 캡처 이미지 페이지 조회 (첫 페이지는 바로, 이후는 스크롤이 끝에 가까워지면)
+    int m_imagePageSize;
+    QString m_imageQueryDate;
+    int m_imageQueryHour;
+    QString m_imageNextCursor;      // 비어 있으면 더 받을 페이지 없음
+    bool m_imagePageLoading;
+    quint64 m_imageQueryGeneration; // 새 조회를 시작하면 이전 조회의 늦은 응답은 버림
+    int m_displayedImageCount;
+    int m_imageTotal;
+    // 클릭해서 받아 온 원본 (imageId → 파일 경로, 새 조회 시 비움)
+    QHash<QString, QString> m_fullImagePaths;
+    QSet<QString> m_fullImageRequests;
 };
 
 #endif // MAINWINDOW_H
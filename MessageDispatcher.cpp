@@ -0,0 +1,43 @@
+#include "MessageDispatcher.h"
+
+int MessageDispatcher::subscribe(int messageId, QObject *context, Handler handler)
+{
+    int id = m_nextId++;
+    m_subscriptions.append(Subscription{id, messageId, context, context != nullptr, std::move(handler)});
+    return id;
+}
+
+void MessageDispatcher::unsubscribe(int subscriptionId)
+{
+    m_subscriptions.removeIf([subscriptionId](const Subscription &subscription) {
+        return subscription.id == subscriptionId;
+    });
+}
+
+void MessageDispatcher::unsubscribeAll(QObject *context)
+{
+    m_subscriptions.removeIf([context](const Subscription &subscription) {
+        return subscription.context == context;
+    });
+}
+
+bool MessageDispatcher::dispatch(int messageId, const QVariant &payload)
+{
+    // 사라진 context의 구독은 정리
+    m_subscriptions.removeIf([](const Subscription &subscription) {
+        return subscription.hasContext && subscription.context.isNull();
+    });
+
+    // 핸들러 안에서 구독이 바뀔 수 있으므로 대상 목록을 먼저 복사
+    QList<Handler> handlers;
+    for (const Subscription &subscription : std::as_const(m_subscriptions)) {
+        if (subscription.messageId == messageId) {
+            handlers.append(subscription.handler);
+        }
+    }
+
+    for (const Handler &handler : std::as_const(handlers)) {
+        handler(payload);
+    }
+    return !handlers.isEmpty();
+}
@@ -0,0 +1,49 @@
+#ifndef MESSAGEDISPATCHER_H
+#define MESSAGEDISPATCHER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QList>
+#include <QVariant>
+#include <functional>
+
+// 응답 타입별 구독자 목록 (GUI 스레드 전용)
+// 네트워크 스레드가 한 번 디코딩한 결과(QVariant)를 같은 타입의 구독자 모두에게 넘긴다.
+// 구독자는 switch에 고정되지 않고 subscribe()로 등록하며, context 객체가 사라지면 자동으로 빠진다.
+class MessageDispatcher
+{
+public:
+    using Handler = std::function<void(const QVariant &payload)>;
+
+    // 구독 등록 (반환값은 unsubscribe()에 사용)
+    int subscribe(int messageId, QObject *context, Handler handler);
+
+    // 결과 타입을 지정한 구독 (QList 등은 암시적 공유라 구독자 수만큼 복사되지 않음)
+    template <typename T, typename Func>
+    int subscribe(int messageId, QObject *context, Func func)
+    {
+        return subscribe(messageId, context, Handler([func](const QVariant &payload) {
+            func(payload.value<T>());
+        }));
+    }
+
+    void unsubscribe(int subscriptionId);
+    void unsubscribeAll(QObject *context);
+
+    // 구독자가 하나라도 있었으면 true
+    bool dispatch(int messageId, const QVariant &payload);
+
+private:
+    struct Subscription {
+        int id;
+        int messageId;
+        QPointer<QObject> context;
+        bool hasContext;            // context 없이 등록하면 unsubscribe 전까지 유지
+        Handler handler;
+    };
+
+    QList<Subscription> m_subscriptions;
+    int m_nextId = 1;
+};
+
+#endif // MESSAGEDISPATCHER_H
@@ -0,0 +1,181 @@
+#include "NetworkMetrics.h"
+#include <QJsonArray>
+
+NetworkMetrics::NetworkMetrics()
+    : m_types(std::make_unique<TypeCounters[]>(SlotCount))
+{
+}
+
+int NetworkMetrics::slotFor(int messageId)
+{
+    return (messageId >= 0 && messageId < OtherSlot) ? messageId : OtherSlot;
+}
+
+int NetworkMetrics::bucketFor(qint64 usecs)
+{
+    int bucket = 0;
+    while (bucket < BucketCount - 1 && usecs > bucketUpperBound(bucket)) {
+        ++bucket;
+    }
+    return bucket;
+}
+
+qint64 NetworkMetrics::bucketUpperBound(int bucket)
+{
+    if (bucket >= BucketCount - 1) {
+        return -1;
+    }
+    return qint64(1) << bucket;
+}
+
+void NetworkMetrics::recordInbound(int messageId, qint64 bytes)
+{
+    TypeCounters &counters = m_types[slotFor(messageId)];
+    counters.framesIn.fetch_add(1, std::memory_order_relaxed);
+    counters.bytesIn.fetch_add(quint64(bytes), std::memory_order_relaxed);
+}
+
+void NetworkMetrics::recordOutbound(int messageId, qint64 bytes)
+{
+    TypeCounters &counters = m_types[slotFor(messageId)];
+    counters.framesOut.fetch_add(1, std::memory_order_relaxed);
+    counters.bytesOut.fetch_add(quint64(bytes), std::memory_order_relaxed);
+}
+
+void NetworkMetrics::recordTiming(Timing timing, int messageId, qint64 usecs)
+{
+    quint64 value = quint64(qMax<qint64>(usecs, 0));
+    Histogram &histogram = m_types[slotFor(messageId)].timings[timing];
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+    histogram.sumUs.fetch_add(value, std::memory_order_relaxed);
+    histogram.buckets[bucketFor(qint64(value))].fetch_add(1, std::memory_order_relaxed);
+
+    quint64 current = histogram.maxUs.load(std::memory_order_relaxed);
+    while (value > current && !histogram.maxUs.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+void NetworkMetrics::reset()
+{
+    for (int slot = 0; slot < SlotCount; ++slot) {
+        TypeCounters &counters = m_types[slot];
+        counters.framesIn.store(0, std::memory_order_relaxed);
+        counters.bytesIn.store(0, std::memory_order_relaxed);
+        counters.framesOut.store(0, std::memory_order_relaxed);
+        counters.bytesOut.store(0, std::memory_order_relaxed);
+        for (Histogram &histogram : counters.timings) {
+            histogram.count.store(0, std::memory_order_relaxed);
+            histogram.sumUs.store(0, std::memory_order_relaxed);
+            histogram.maxUs.store(0, std::memory_order_relaxed);
+            for (std::atomic<quint64> &bucket : histogram.buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+NetworkMetrics::TimingSnapshot NetworkMetrics::summarize(const Histogram &histogram)
+{
+    TimingSnapshot summary;
+    std::array<quint64, BucketCount> buckets;
+    quint64 total = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        buckets[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+        total += buckets[i];
+    }
+    if (total == 0) {
+        return summary;
+    }
+
+    summary.count = total;
+    summary.maxUs = qint64(histogram.maxUs.load(std::memory_order_relaxed));
+    summary.averageUs = qint64(histogram.sumUs.load(std::memory_order_relaxed) / qMax<quint64>(histogram.count.load(std::memory_order_relaxed), 1));
+
+    auto percentile = [&](double fraction) -> qint64 {
+        quint64 target = qMax<quint64>(1, quint64(fraction * total + 0.5));
+        quint64 seen = 0;
+        for (int i = 0; i < BucketCount; ++i) {
+            seen += buckets[i];
+            if (seen >= target) {
+                qint64 bound = bucketUpperBound(i);
+                return (bound < 0 || bound > summary.maxUs) ? summary.maxUs : bound;
+            }
+        }
+        return summary.maxUs;
+    };
+    summary.p50Us = percentile(0.50);
+    summary.p95Us = percentile(0.95);
+    return summary;
+}
+
+QList<NetworkMetrics::MessageTypeSnapshot> NetworkMetrics::snapshot() const
+{
+    QList<MessageTypeSnapshot> result;
+    for (int slot = 0; slot < SlotCount; ++slot) {
+        const TypeCounters &counters = m_types[slot];
+
+        MessageTypeSnapshot entry;
+        entry.messageId = slot == OtherSlot ? -1 : slot;
+        entry.framesIn = counters.framesIn.load(std::memory_order_relaxed);
+        entry.bytesIn = counters.bytesIn.load(std::memory_order_relaxed);
+        entry.framesOut = counters.framesOut.load(std::memory_order_relaxed);
+        entry.bytesOut = counters.bytesOut.load(std::memory_order_relaxed);
+
+        bool hasTimings = false;
+        for (int timing = 0; timing < TimingCount; ++timing) {
+            entry.timings[timing] = summarize(counters.timings[timing]);
+            hasTimings = hasTimings || entry.timings[timing].count > 0;
+        }
+
+        if (entry.framesIn > 0 || entry.framesOut > 0 || hasTimings) {
+            result.append(entry);
+        }
+    }
+    return result;
+}
+
+QString NetworkMetrics::timingName(Timing timing)
+{
+    switch (timing) {
+    case DecodeTime:
+        return "decode";
+    case HandlerTime:
+        return "handler";
+    case QueueWait:
+        return "queue_wait";
+    case ResponseLatency:
+        return "latency";
+    default:
+        return QString();
+    }
+}
+
+QJsonObject NetworkMetrics::toJson() const
+{
+    QJsonArray messages;
+    const QList<MessageTypeSnapshot> entries = snapshot();
+    for (const MessageTypeSnapshot &entry : entries) {
+        QJsonObject message{
+            { "message_id", entry.messageId },
+            { "frames_in", qint64(entry.framesIn) },
+            { "bytes_in", qint64(entry.bytesIn) },
+            { "frames_out", qint64(entry.framesOut) },
+            { "bytes_out", qint64(entry.bytesOut) },
+        };
+        for (int timing = 0; timing < TimingCount; ++timing) {
+            const TimingSnapshot &summary = entry.timings[timing];
+            if (summary.count == 0) {
+                continue;
+            }
+            message[timingName(static_cast<Timing>(timing))] = QJsonObject{
+                { "count", qint64(summary.count) },
+                { "avg_us", summary.averageUs },
+                { "p50_us", summary.p50Us },
+                { "p95_us", summary.p95Us },
+                { "max_us", summary.maxUs },
+            };
+        }
+        messages.append(message);
+    }
+    return QJsonObject{ { "messages", messages } };
+}
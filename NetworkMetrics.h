@@ -0,0 +1,84 @@
+#ifndef NETWORKMETRICS_H
+#define NETWORKMETRICS_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <array>
+#include <atomic>
+#include <memory>
+
+// 메시지 타입(request_id/response_id)별 송수신 통계
+//
+// 네트워크 스레드와 GUI 스레드가 잠금 없이 기록하도록 모든 값은 relaxed 원자 변수이며,
+// 시간은 1µs, 2µs, 4µs ... 단위(2의 거듭제곱) 버킷에 누적한다 (평균/백분위는 버킷 상한 기준).
+// snapshot()은 기록 중에도 읽을 수 있지만 항목 간 일관성은 보장하지 않는다 (진단용).
+class NetworkMetrics
+{
+public:
+    static constexpr int SlotCount = 256;       // 0~254는 메시지 ID 그대로, 그 밖의 ID는 마지막 슬롯
+    static constexpr int OtherSlot = SlotCount - 1;
+    static constexpr int BucketCount = 24;      // ~1µs ... ~8.4s, 마지막 버킷은 그 이상
+
+    enum Timing {
+        DecodeTime,         // 네트워크 스레드: 프레임 완성 → 구조체로 변환해 전달할 때까지
+        HandlerTime,        // GUI 스레드: 응답/BBox 구독자 처리
+        QueueWait,          // 송신 큐에서 소켓에 넘겨질 때까지
+        ResponseLatency,    // 요청 전송 → 응답 도착 (요청 ID 기준)
+        TimingCount
+    };
+
+    struct TimingSnapshot {
+        quint64 count = 0;
+        qint64 averageUs = 0;
+        qint64 p50Us = 0;
+        qint64 p95Us = 0;
+        qint64 maxUs = 0;
+    };
+
+    struct MessageTypeSnapshot {
+        int messageId = 0;          // OtherSlot이면 -1
+        quint64 framesIn = 0;
+        quint64 bytesIn = 0;
+        quint64 framesOut = 0;
+        quint64 bytesOut = 0;
+        std::array<TimingSnapshot, TimingCount> timings;
+    };
+
+    NetworkMetrics();
+
+    void recordInbound(int messageId, qint64 bytes);
+    void recordOutbound(int messageId, qint64 bytes);
+    void recordTiming(Timing timing, int messageId, qint64 usecs);
+    void reset();
+
+    // 기록이 있는 메시지 타입만 (ID 순)
+    QList<MessageTypeSnapshot> snapshot() const;
+    QJsonObject toJson() const;
+
+    static QString timingName(Timing timing);
+    static qint64 bucketUpperBound(int bucket);  // µs, 마지막 버킷은 -1 (상한 없음)
+
+private:
+    struct Histogram {
+        std::atomic<quint64> count;
+        std::atomic<quint64> sumUs;
+        std::atomic<quint64> maxUs;
+        std::array<std::atomic<quint64>, BucketCount> buckets;
+    };
+    struct TypeCounters {
+        std::atomic<quint64> framesIn;
+        std::atomic<quint64> bytesIn;
+        std::atomic<quint64> framesOut;
+        std::atomic<quint64> bytesOut;
+        std::array<Histogram, TimingCount> timings;
+    };
+
+    static int slotFor(int messageId);
+    static int bucketFor(qint64 usecs);
+    static TimingSnapshot summarize(const Histogram &histogram);
+
+    std::unique_ptr<TypeCounters[]> m_types;     // 값 초기화(0)된 고정 배열, 기록 중 재할당 없음
+};
+
+#endif // NETWORKMETRICS_H
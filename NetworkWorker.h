@@ -0,0 +1,354 @@
+#ifndef NETWORKWORKER_H
+#define NETWORKWORKER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QJsonArray>
+
+#include <QSslSocket>
+#include <QSslError>
+#include <QSslConfiguration>
+#include <QCborStreamReader>
+#include <QNetworkInformation>
+#include <QElapsedTimer>
+
+#include "TcpCommunicator.h"
+#include "FrameDecoder.h"
+#include "FrameCompressor.h"
+#include "RttHistogram.h"
+#include "SessionRecorder.h"
+#include "NetworkMetrics.h"
+#include <memory>
+
+class JsonStreamReader;
+class CaptureCache;
+
+// 네트워크 스레드에서 동작하는 TcpCommunicator의 작업자 객체
+// QSslSocket, 길이 기반 프레이밍, JSON 디코딩을 모두 이 스레드에서 처리하고
+// GUI 스레드에는 타입이 정해진 결과만 시그널(Queued)로 전달한다.
+class NetworkWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit NetworkWorker(QObject *parent = nullptr);
+    ~NetworkWorker();
+
+    // 스레드 시작 전에 설정 (여러 워커가 같은 통계를 공유할 수 있음)
+    void setMetrics(NetworkMetrics *metrics);
+    // 받은 이미지를 캐시 디렉터리에 바로 저장하고 등록 (TcpCommunicator 소유, 닫혀 있으면 임시 폴더)
+    void setCaptureCache(CaptureCache *cache);
+
+public slots:
+    // 네트워크 스레드 시작 시 호출 (소켓/타이머는 반드시 이 스레드에서 생성)
+    void initialize();
+    void shutdown();
+
+    // 연결 관리 (모두 비동기, 대기 없음)
+    void connectToServer(const QString &host, quint16 port);
+    void disconnectFromServer();
+
+    // 메시지 전송 (우선순위 레인에 넣고 이벤트 루프에서 모아서 기록, messageId != 0이면 완료 시 messageSent)
+    void sendJsonMessage(const QJsonObject &message, quint64 messageId = 0,
+                         MessagePriority priority = MessagePriority::Control);
+
+    // 설정
+    void setConnectionTimeout(int timeoutMs);
+    void setReconnectEnabled(bool enabled);
+    // 협상을 마친 대기 연결을 하나 더 유지 (끊기면 핸드셰이크 없이 교체)
+    void setStandbyConnectionEnabled(bool enabled);
+    void setMaxFrameSize(qint64 bytes);
+    void setMaxFrameSizeForType(int responseId, qint64 bytes);
+    void setLargeFrameThreshold(qint64 bytes);
+    // 하트비트 (ping 간격, 0이면 끔 / 연속으로 놓친 pong이 이 수에 이르면 끊긴 것으로 보고 재연결)
+    void setHeartbeatInterval(int intervalMs);
+    void setMaxMissedPongs(int count);
+
+    // 대용량 전송용 보조 연결로 동작 (hello에 주 연결의 세션 ID를 실어 인증을 이어받음)
+    void setChannelSession(const QString &sessionId);
+
+    // 송수신 프레임 기록 / 기록 재생 (재생은 연결이 없을 때만, 같은 디코딩·전달 경로 사용)
+    void startRecording(const QString &path);
+    void stopRecording();
+    void startReplay(const QString &path, bool realTime);
+    void stopReplay();
+    // 다른 연결에서 받은 TLS 세션 티켓을 공유 (첫 연결부터 세션 재개)
+    void setSessionTicket(const QByteArray &ticket);
+    // 서버가 썸네일을 주지 않을 때 조회 응답(10)의 원본으로 만들 썸네일 크기 (빈 크기면 만들지 않음)
+    void setThumbnailSize(const QSize &size);
+
+signals:
+    void connected();               // TLS 협상까지 끝나 메시지를 보낼 수 있는 상태
+    void disconnected();
+    void connectionStateChanged(ConnectionState state);
+    void reconnected(qint64 outageMs);     // 예기치 않은 끊김 후 복구까지 걸린 시간
+    void rttUpdated(int rttMs, int jitterMs);   // pong을 받을 때마다
+    void outboundMetricsUpdated(const QList<OutboundLaneMetrics> &lanes);   // 레인 순서는 MessagePriority
+    void errorOccurred(const QString &error);
+    void messageReceived(const QString &message);
+    void imagesReceived(const QList<ImageData> &images);
+    void coordinatesConfirmed(bool success, const QString &message);
+    void detectionLineConfirmed(bool success, const QString &message);
+    void statusUpdated(const QString &status);
+    void messageSent(quint64 messageId, bool success);
+    void replayFinished(qint64 frames, qint64 elapsedMs);
+    void serverCapabilitiesReceived(const QStringList &capabilities, const QString &sessionId);
+    void sessionTicketUpdated(const QByteArray &ticket);
+    void lineBatchResult(const QList<LineUploadResult> &results);
+
+    // 모든 응답을 타입이 정해진 payload와 함께 한 번 더 알림 (요청/응답 매칭용)
+    void responseReceived(int responseId, quint64 seq, const QVariant &payload);
+
+    void roadLineConfirmed(bool success, const QString &message);
+    void perpendicularLineConfirmed(bool success, const QString &message);
+
+    void categorizedCoordinatesConfirmed(bool success, const QString &message, int roadLinesProcessed, int detectionLinesProcessed);
+
+    // BBox 관련 시그널
+    void bboxFrameReceived(const BBoxFrameSnapshot &frame);
+
+private slots:
+    // 연결 상태 머신: Idle → Resolving → Connecting → TlsHandshake → Authenticated → (Draining) → Idle
+    void onSocketStateChanged(QAbstractSocket::SocketState socketState);
+    void onEncrypted();
+    void onDisconnected();
+    void onError(QAbstractSocket::SocketError error);
+    void onConnectionTimeout();
+    void onReconnectTimer();
+    void onReachabilityChanged(QNetworkInformation::Reachability reachability);
+    void onSslErrors(const QList<QSslError> &errors);
+    void onSessionTicketReceived();
+    void openStandby();
+    void onStandbyLost();
+    void onHeartbeatTimer();
+    void onReplayTimer();
+
+    void onReadyRead();
+
+    void flushOutbound();
+    void onBytesWritten(qint64 bytes);
+
+private:
+    // 수신 프레임 처리
+    bool drainFrames();
+    static int frameMessageId(QByteArrayView frame);
+    void processFrame(QByteArrayView frame);
+    void processSpilledFrame(QIODevice *device, int messageId);
+    void processCborFrame(QByteArrayView frame);
+    // 첨부 프레임 (JSON/CBOR 헤더 + offset으로 참조하는 바이너리 블롭)
+    struct Attachment {
+        QString timestamp;
+        QString imageId;
+        bool thumbnail = false;
+        qint64 offset = 0;          // 블롭 영역 시작 기준
+        qint64 length = 0;
+    };
+    bool readAttachmentHeader(QByteArrayView header, qint64 blobBytes, int &messageId, quint64 &seq,
+                              ImagePage &page, QList<Attachment> &attachments);
+    // 프레임 경계가 잘못되었으면 false (연결을 끊음), 헤더만 해석할 수 없으면 빈 페이지로 응답
+    bool processAttachmentFrame(QByteArrayView frame);
+    bool processSpilledAttachmentFrame(QIODevice *device, qint64 frameSize);
+    void rejectAttachmentFrame(int messageId, quint64 seq);
+    // 압축 프레임을 풀어 처리 (풀린 크기가 크거나 임시 파일로 받은 프레임은 조각 단위로 임시 파일에 풂)
+    bool processCompressedFrame(QByteArrayView frame, bool attachment, int &messageId);
+    void recordCompression(int messageId, qint64 rawBytes, qint64 wireBytes, qint64 nsecs);
+    void logCompressionStats();
+
+    // JSON 메시지 처리
+    void processJsonMessage(const QJsonObject &jsonObj);
+    // 조회 응답(10)과 원본 이미지 응답(25)은 같은 형식
+    static bool isImageResponse(int messageId) { return messageId == 10 || messageId == 25; }
+    void handleImagesJson(JsonStreamReader &reader, int responseId);
+    void handleImagesCbor(QCborStreamReader &reader, int responseId);
+    void publishImages(ImagePage &page, quint64 seq, int responseId);
+    void emitImages(const ImagePage &page, quint64 seq, int responseId);
+    void emitReadyImagePages();
+    void publishSavedRoadLines(const QList<RoadLineData> &roadLines, quint64 seq);
+    void publishSavedDetectionLines(const QList<DetectionLineData> &detectionLines, quint64 seq);
+    void handleCoordinatesResponse(const QJsonObject &jsonObj);
+    void handleDetectionLineResponse(const QJsonObject &jsonObj);
+    void handleCategorizedCoordinatesResponse(const QJsonObject &jsonObj);
+    void handleStatusUpdate(const QJsonObject &jsonObj);
+    void handleErrorResponse(const QJsonObject &jsonObj);
+    void handleRoadLineResponse(const QJsonObject &jsonObj);
+    void handlePerpendicularLineResponse(const QJsonObject &jsonObj);
+
+    // 저장된 선 데이터 응답 처리 함수들
+    void handleSavedRoadLinesResponse(const QJsonObject &jsonObj);
+    void handleSavedDetectionLinesResponse(const QJsonObject &jsonObj);
+
+    static quint64 seqOf(const QJsonObject &jsonObj);
+    void emitResponse(const QJsonObject &jsonObj, int responseId, const QVariant &payload);
+
+    // 지원 기능 교환 / 선 일괄 업로드
+    void sendHello();
+    void handleHelloResponse(const QJsonObject &jsonObj);
+    void handleLineBatchResponse(const QJsonObject &jsonObj);
+
+    // 하트비트 (request_id 60 → response_id 61)
+    void startHeartbeat();
+    void stopHeartbeat();
+    void handlePong(const QJsonObject &jsonObj);
+
+    // BBox 처리 함수 (DOM 없이 풀의 프레임에 바로 디코딩)
+    void handleBBoxFrame(QByteArrayView frame);
+
+    // Base64 이미지 처리 함수
+    // base64는 프레임의 UTF-8 바이트를 그대로 받아 조각 단위로 디코딩 (파일 또는 버퍼로)
+    QString saveBase64Image(QByteArrayView base64Data, const QString &filePath);
+    QByteArray decodeBase64Image(QByteArrayView base64Data);
+    void logBase64Throughput(qint64 encodedBytes, qint64 nsecs) const;
+    QString captureCamera() const;
+    QString imageFilePath(const QString &timestamp, bool thumbnail = false) const;
+    QString saveImageFile(QByteArrayView imageData, const QString &filePath);
+    // 임시 파일로 받은 프레임의 현재 위치부터 length 바이트를 조각 단위로 복사
+    QString saveImageFile(QIODevice *device, qint64 length, const QString &filePath);
+    // 서버가 준 썸네일이면 thumbnailPath로 (원본은 imageId로 나중에 요청)
+    ImageData makeImageData(const QString &imagePath, const QString &timestamp,
+                            const QString &imageId = QString(), bool thumbnail = false) const;
+    // 원본에서 그리드용 썸네일 생성 (JPEG는 축소 디코딩이라 원본 전체를 풀지 않음)
+    // 멤버를 건드리지 않으므로 스레드 풀에서 실행
+    struct ThumbnailJob {
+        qsizetype index;        // page.images 안의 위치
+        QString imagePath;
+        QString thumbnailPath;  // 경로는 캐시 상태를 읽으므로 워커 스레드에서 미리 정함
+    };
+    static QString createThumbnail(const QString &imagePath, const QString &thumbnailPath, const QSize &size);
+
+    // 유틸리티 함수
+    void logJsonMessage(const QJsonObject &jsonObj, bool outgoing) const;
+    static const QSslConfiguration &baseSslConfiguration();
+    void applySslConfiguration(QSslSocket *socket);
+    void rememberSessionTicket(QSslSocket *socket);
+    QSslSocket *createSocket();
+    void attachSocket(QSslSocket *socket);
+    bool promoteStandby();
+    void closeStandby();
+    void failPendingMessages();
+
+    // 연결 관리
+    void setState(ConnectionState state);
+    void startConnectAttempt();
+    void handleConnectionLost();
+    void resetSession();
+    void scheduleReconnect();
+    static int reconnectDelayMs(int attempt);
+
+    // 네트워크 관련
+    QSslSocket *m_socket;
+    FrameDecoder m_frameDecoder;
+    BBoxFramePool m_bboxFramePool;
+    QTimer *m_connectionTimer;
+    QTimer *m_reconnectTimer;
+    QTimer *m_flushTimer;
+    QSslSocket *m_standbySocket;    // TLS까지 맺어 둔 예비 연결 (옵션)
+    QTimer *m_standbyTimer;
+    bool m_standbyEnabled;
+    int m_standbyFailures;
+    QByteArray m_sessionTicket;     // 마지막으로 받은 TLS 세션 티켓 (재연결 시 세션 재개)
+    QString m_channelSessionId;     // 보조 연결이면 붙을 주 연결의 세션 ID
+    QElapsedTimer m_handshakeTimer;
+    QElapsedTimer m_clock;          // 하트비트 RTT와 송신 대기 시간 측정용 (initialize에서 시작)
+    QString m_host;
+    quint16 m_port;
+    ConnectionState m_state;
+    bool m_disconnectRequested;     // 사용자가 직접 끊은 경우 재연결하지 않음
+    bool m_useCbor;                 // 서버와 합의한 송신 인코딩 (연결마다 초기화)
+    bool m_useCompression;          // 서버와 zlib 프레임 압축을 합의함 (연결마다 초기화)
+    bool m_useAttachments;          // 서버가 이미지를 첨부 프레임으로 보냄 (연결마다 초기화)
+    QSize m_thumbnailSize;
+
+    // 이미지 응답은 도착 순서대로 전달 (seq를 돌려주지 않는 서버는 응답 타입 순서로 요청과 매칭됨)
+    // 썸네일을 만드는 중인 페이지가 있으면 뒤에 온 응답도 그 페이지가 전달될 때까지 기다림
+    struct PendingImagePage {
+        quint64 ticket;
+        ImagePage page;
+        quint64 seq;
+        int responseId;
+        bool ready;                 // 썸네일 생성이 끝남
+        bool rejected;              // 헤더를 해석하지 못한 응답 - 기다리는 요청만 빈 페이지로 끝냄
+    };
+    QList<PendingImagePage> m_pendingImagePages;
+    quint64 m_nextImageTicket;
+
+    // 프레임 압축 - 이 크기 이상인 페이로드만 압축하고, 줄어든 경우에만 압축본을 보냄
+    static constexpr qsizetype CompressionThreshold = 1024;
+    static constexpr int CompressionLevel = 6;
+    struct CompressionStats {
+        quint64 frames = 0;
+        qint64 rawBytes = 0;
+        qint64 wireBytes = 0;
+        qint64 nsecs = 0;           // 압축/해제에 쓴 시간
+    };
+    QHash<int, CompressionStats> m_compressionStats;    // 메시지 타입별 (세션이 끝날 때 로그로 남김)
+    FrameCompressor m_compressor;   // zlib 상태를 연결 내내 재사용
+    QByteArray m_compressBuffer;    // 송신 압축 결과 (용량 재사용)
+
+    // 설정
+    int m_connectionTimeoutMs;
+    bool m_reconnectEnabled;
+    int m_reconnectAttempts;        // 연속 실패 횟수 (백오프 계산용, 제한 없음)
+    static constexpr int InitialReconnectDelayMs = 500;
+    static constexpr int MaxReconnectDelayMs = 30000;
+    QElapsedTimer m_outageTimer;    // 예기치 않게 끊긴 시점부터 (복구 시간 측정)
+    QNetworkInformation::Reachability m_lastReachability;
+
+    // 하트비트 - hello 응답에 "heartbeat"가 있는 서버에만 사용
+    struct PendingPing {
+        quint32 id;
+        qint64 sentAt;              // m_clock 기준 (ms)
+    };
+    QTimer *m_heartbeatTimer;
+    int m_heartbeatIntervalMs;
+    int m_maxMissedPongs;
+    quint32 m_nextPingId;
+    QList<PendingPing> m_pendingPings;
+    qint64 m_lastActivityAt;        // 마지막으로 데이터를 받은 시각 (m_clock 기준)
+    RttHistogram m_rtt;
+
+    // 메시지 타입별 통계 (TcpCommunicator 소유, 잠금 없이 기록)
+    NetworkMetrics *m_metrics;
+    CaptureCache *m_captureCache;
+
+    // 세션 기록 / 재생
+    std::unique_ptr<SessionRecorder> m_recorder;
+    std::unique_ptr<SessionRecordReader> m_replayReader;
+    QTimer *m_replayTimer;
+    bool m_replayRealTime;
+    bool m_replayHasRecord;         // 헤더를 읽었지만 아직 재생하지 않은 레코드
+    SessionRecord::Header m_replayHeader;
+    QElapsedTimer m_replayClock;
+    qint64 m_replayFrames;
+
+    // 송신 큐 - 우선순위별 레인, 메시지 경계에서만 높은 레인이 먼저 나감
+    struct OutboundFrame {
+        quint64 messageId;
+        int requestId;              // 메시지 타입 (통계용)
+        QByteArray data;            // 헤더+페이로드
+        qint64 enqueuedAt;          // m_clock 기준 (µs)
+        qint64 written = 0;         // 이미 소켓에 넘긴 바이트 (부분 기록 후 나머지부터 이어서 씀)
+    };
+    struct OutboundLane {
+        QList<OutboundFrame> frames;
+        OutboundLaneMetrics metrics;
+    };
+    struct UnackedMessage {
+        quint64 messageId;
+        qint64 endOffset;           // 이 메시지가 끝나는 누적 바이트 위치
+    };
+    static constexpr int LaneCount = 3;
+    static constexpr qint64 WriteHighWatermark = 1024 * 1024;
+    static constexpr qint64 WriteLowWatermark = 256 * 1024;
+    OutboundLane m_lanes[LaneCount];
+    QList<UnackedMessage> m_unackedMessages;
+    int m_partialLane;              // 일부만 기록된 프레임이 맨 앞에 있는 레인 (-1이면 없음)
+    qint64 m_bytesQueued;           // 이번 연결에서 소켓에 넘긴 누적 바이트
+    qint64 m_bytesWrittenTotal;     // 이번 연결에서 소켓이 내보낸 누적 바이트
+
+    bool hasOutbound() const;
+    void publishOutboundMetrics();
+};
+
+#endif // NETWORKWORKER_H
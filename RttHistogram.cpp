@@ -0,0 +1,83 @@
+#include "RttHistogram.h"
+#include <algorithm>
+
+RttHistogram::RttHistogram()
+{
+    clear();
+}
+
+void RttHistogram::addSample(qint64 rttMs)
+{
+    rttMs = qMax<qint64>(rttMs, 0);
+
+    // 창이 가득 차면 가장 오래된 샘플을 버킷에서도 뺌
+    if (m_count == WindowSize) {
+        m_buckets[bucketFor(m_samples[m_next])]--;
+    } else {
+        m_count++;
+    }
+
+    if (m_count > 1) {
+        double delta = static_cast<double>(qAbs(rttMs - m_last));
+        m_jitter += (delta - m_jitter) / 16.0;
+    }
+
+    m_samples[m_next] = rttMs;
+    m_next = (m_next + 1) % WindowSize;
+    m_buckets[bucketFor(rttMs)]++;
+    m_last = rttMs;
+}
+
+void RttHistogram::clear()
+{
+    m_samples.fill(0);
+    m_buckets.fill(0);
+    m_next = 0;
+    m_count = 0;
+    m_last = 0;
+    m_jitter = 0.0;
+}
+
+qint64 RttHistogram::average() const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+
+    qint64 sum = 0;
+    for (int i = 0; i < m_count; ++i) {
+        sum += m_samples[i];
+    }
+    return sum / m_count;
+}
+
+qint64 RttHistogram::percentile(double fraction) const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+
+    // 샘플이 최대 64개라 복사해서 정렬해도 충분히 가벼움
+    std::array<qint64, WindowSize> sorted = m_samples;
+    std::sort(sorted.begin(), sorted.begin() + m_count);
+
+    int index = qBound(0, static_cast<int>(fraction * m_count + 0.5) - 1, m_count - 1);
+    return sorted[index];
+}
+
+qint64 RttHistogram::bucketUpperBound(int bucket)
+{
+    if (bucket >= BucketCount - 1) {
+        return -1;
+    }
+    return qint64(1) << bucket;
+}
+
+int RttHistogram::bucketFor(qint64 rttMs)
+{
+    int bucket = 0;
+    while (bucket < BucketCount - 1 && rttMs > (qint64(1) << bucket)) {
+        ++bucket;
+    }
+    return bucket;
+}
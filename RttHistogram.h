@@ -0,0 +1,41 @@
+#ifndef RTTHISTOGRAM_H
+#define RTTHISTOGRAM_H
+
+#include <QtGlobal>
+#include <array>
+
+// 하트비트 왕복 시간(RTT) 통계
+// 최근 WindowSize개 샘플만 유지하는 이동 창이며, 버킷은 1ms, 2ms, 4ms ... 단위(2의 거듭제곱)로 나눈다.
+// 지터는 RFC 3550 방식(연속 샘플 차이의 지수 평활)으로 계산한다.
+class RttHistogram
+{
+public:
+    static constexpr int WindowSize = 64;
+    static constexpr int BucketCount = 13;      // ~1ms ... ~2048ms, 마지막 버킷은 그 이상
+
+    RttHistogram();
+
+    void addSample(qint64 rttMs);
+    void clear();
+
+    int sampleCount() const { return m_count; }
+    qint64 last() const { return m_last; }
+    qint64 jitter() const { return qRound64(m_jitter); }
+    qint64 average() const;
+    qint64 percentile(double fraction) const;   // 예: 0.95 → p95 (창 안의 샘플 기준)
+
+    int bucketCount(int bucket) const { return m_buckets[bucket]; }
+    static qint64 bucketUpperBound(int bucket);  // 마지막 버킷은 -1 (상한 없음)
+
+private:
+    static int bucketFor(qint64 rttMs);
+
+    std::array<qint64, WindowSize> m_samples;
+    std::array<int, BucketCount> m_buckets;
+    int m_next;
+    int m_count;
+    qint64 m_last;
+    double m_jitter;
+};
+
+#endif // RTTHISTOGRAM_H
@@ -0,0 +1,177 @@
+#include "SessionRecorder.h"
+#include <QDateTime>
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+// 기록 중에도 파일을 열어 볼 수 있도록 1초마다 디스크로 내보냄
+constexpr qint64 FlushIntervalMs = 1000;
+constexpr qint64 CopyChunkSize = 256 * 1024;
+}
+
+SessionRecorder::SessionRecorder()
+    : m_lastFlushMs(0)
+    , m_recordCount(0)
+{
+}
+
+SessionRecorder::~SessionRecorder()
+{
+    close();
+}
+
+bool SessionRecorder::open(const QString &path)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    char header[SessionRecord::FileHeaderSize];
+    std::memcpy(header, SessionRecord::Magic, 7);
+    header[7] = static_cast<char>(SessionRecord::Version);
+    qToBigEndian<qint64>(QDateTime::currentMSecsSinceEpoch(), header + 8);
+    m_file.write(header, sizeof(header));
+
+    m_clock.start();
+    m_lastFlushMs = 0;
+    m_recordCount = 0;
+    return true;
+}
+
+void SessionRecorder::close()
+{
+    if (m_file.isOpen()) {
+        m_file.flush();
+        m_file.close();
+    }
+}
+
+void SessionRecorder::writeHeader(SessionRecord::Direction direction, quint8 flags, qint64 length)
+{
+    char header[SessionRecord::RecordHeaderSize];
+    header[0] = static_cast<char>(direction);
+    header[1] = static_cast<char>(flags);
+    qToBigEndian<qint64>(m_clock.nsecsElapsed() / 1000, header + 2);
+    qToBigEndian<quint32>(static_cast<quint32>(length), header + 10);
+    m_file.write(header, sizeof(header));
+    m_recordCount++;
+}
+
+void SessionRecorder::record(SessionRecord::Direction direction, quint8 flags, QByteArrayView payload)
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    writeHeader(direction, flags, payload.size());
+    m_file.write(payload.data(), payload.size());
+    flushIfDue();
+}
+
+void SessionRecorder::record(SessionRecord::Direction direction, quint8 flags, QIODevice *device, qint64 length)
+{
+    if (!m_file.isOpen() || !device) {
+        return;
+    }
+
+    writeHeader(direction, flags, length);
+
+    QByteArray chunk;
+    qint64 copied = 0;
+    while (copied < length) {
+        chunk = device->read(qMin(CopyChunkSize, length - copied));
+        if (chunk.isEmpty()) {
+            break;
+        }
+        m_file.write(chunk);
+        copied += chunk.size();
+    }
+
+    // 레코드 길이를 맞춰 두어야 이후 레코드를 읽을 수 있음
+    if (copied < length) {
+        QByteArray zeros(qMin(CopyChunkSize, length - copied), '\0');
+        while (copied < length) {
+            qint64 size = qMin<qint64>(zeros.size(), length - copied);
+            m_file.write(zeros.constData(), size);
+            copied += size;
+        }
+    }
+
+    device->seek(0);
+    flushIfDue();
+}
+
+void SessionRecorder::flushIfDue()
+{
+    qint64 now = m_clock.elapsed();
+    if (now - m_lastFlushMs >= FlushIntervalMs) {
+        m_file.flush();
+        m_lastFlushMs = now;
+    }
+}
+
+bool SessionRecordReader::open(const QString &path)
+{
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = m_file.errorString();
+        return false;
+    }
+
+    QByteArray header = m_file.read(SessionRecord::FileHeaderSize);
+    if (header.size() != SessionRecord::FileHeaderSize || std::memcmp(header.constData(), SessionRecord::Magic, 7) != 0) {
+        m_error = "Not a session recording";
+        return false;
+    }
+    if (static_cast<quint8>(header[7]) != SessionRecord::Version) {
+        m_error = QString("Unsupported recording version %1").arg(static_cast<quint8>(header[7]));
+        return false;
+    }
+
+    m_startedAtMs = qFromBigEndian<qint64>(header.constData() + 8);
+    m_remaining = 0;
+    return true;
+}
+
+bool SessionRecordReader::readHeader(SessionRecord::Header &header)
+{
+    if (m_remaining > 0 && !skipPayload()) {
+        return false;
+    }
+
+    char bytes[SessionRecord::RecordHeaderSize];
+    if (m_file.read(bytes, sizeof(bytes)) != sizeof(bytes)) {
+        return false;
+    }
+
+    header.direction = static_cast<SessionRecord::Direction>(bytes[0]);
+    header.flags = static_cast<quint8>(bytes[1]);
+    header.timestampUs = qFromBigEndian<qint64>(bytes + 2);
+    header.length = qFromBigEndian<quint32>(bytes + 10);
+
+    // 기록 도중 끊긴 마지막 레코드는 재생하지 않음
+    if (m_file.size() - m_file.pos() < header.length) {
+        return false;
+    }
+    m_remaining = header.length;
+    return true;
+}
+
+QByteArray SessionRecordReader::readPayload(qint64 maxSize)
+{
+    QByteArray data = m_file.read(qMin(maxSize, m_remaining));
+    m_remaining -= data.size();
+    return data;
+}
+
+bool SessionRecordReader::skipPayload()
+{
+    if (!m_file.seek(m_file.pos() + m_remaining)) {
+        return false;
+    }
+    m_remaining = 0;
+    return true;
+}
@@ -0,0 +1,90 @@
+#ifndef SESSIONRECORDER_H
+#define SESSIONRECORDER_H
+
+#include <QByteArrayView>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+
+// 송수신 프레임 기록 파일 (.cctvrec)
+//
+// 파일 헤더: "CCTVREC" + 버전(1바이트) + 기록 시작 시각(8바이트, epoch ms)
+// 레코드:    방향(1바이트) + 플래그(1바이트) + 시작 후 경과 시간(8바이트, µs, 단조 시계) + 길이(4바이트) + 페이로드
+// 모든 정수는 빅엔디안이며, 페이로드는 길이 헤더를 뺀 와이어 그대로(압축 프레임은 압축된 채로) 기록한다.
+// 플래그는 길이 헤더의 프레임 종류 비트(압축, 첨부 이미지)를 그대로 옮긴 것이다.
+// 추가 전용이므로 프로그램이 비정상 종료되어도 마지막 레코드 전까지는 그대로 재생할 수 있다.
+namespace SessionRecord {
+constexpr char Magic[] = "CCTVREC";
+constexpr quint8 Version = 1;
+constexpr qsizetype FileHeaderSize = 7 + 1 + 8;
+constexpr qsizetype RecordHeaderSize = 1 + 1 + 8 + 4;
+
+enum Direction : quint8 {
+    Inbound = 0,
+    Outbound = 1
+};
+
+enum Flag : quint8 {
+    Compressed = 0x01,
+    Attachment = 0x02
+};
+
+struct Header {
+    Direction direction = Inbound;
+    quint8 flags = 0;
+    qint64 timestampUs = 0;
+    quint32 length = 0;
+};
+}
+
+// 네트워크 스레드에서 프레임을 파일 끝에 이어 씀
+class SessionRecorder
+{
+public:
+    SessionRecorder();
+    ~SessionRecorder();
+
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+    QString errorString() const { return m_file.errorString(); }
+
+    void record(SessionRecord::Direction direction, quint8 flags, QByteArrayView payload);
+    // 임시 파일로 받은 대용량 프레임 (조각 단위로 복사한 뒤 처음 위치로 되돌림)
+    void record(SessionRecord::Direction direction, quint8 flags, QIODevice *device, qint64 length);
+
+    quint64 recordCount() const { return m_recordCount; }
+
+private:
+    void writeHeader(SessionRecord::Direction direction, quint8 flags, qint64 length);
+    void flushIfDue();
+
+    QFile m_file;
+    QElapsedTimer m_clock;
+    qint64 m_lastFlushMs;
+    quint64 m_recordCount;
+};
+
+// 기록 파일을 레코드 단위로 읽음 (헤더 → 페이로드 조각 순서)
+class SessionRecordReader
+{
+public:
+    bool open(const QString &path);
+    QString errorString() const { return m_error; }
+    qint64 startedAtMs() const { return m_startedAtMs; }
+
+    // 다음 레코드 헤더 (파일 끝이거나 잘린 레코드면 false)
+    bool readHeader(SessionRecord::Header &header);
+    // 현재 레코드의 페이로드를 최대 maxSize 바이트씩 읽음 / 건너뜀
+    QByteArray readPayload(qint64 maxSize);
+    bool skipPayload();
+    qint64 remainingPayload() const { return m_remaining; }
+
+private:
+    QFile m_file;
+    QString m_error;
+    qint64 m_startedAtMs = 0;
+    qint64 m_remaining = 0;
+};
+
+#endif // SESSIONRECORDER_H
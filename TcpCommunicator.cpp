@@ -6,180 +6,664 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
 
 #include "LineDrawingDialog.h"
+#include "NetworkWorker.h"
+#include "CaptureCache.h"
+#include "Logging.h"
+#include "EventLoopWatchdog.h"
+
+namespace {
+// 서버 양식에 맞춘 선 데이터 JSON 변환 (개별 전송과 일괄 전송에서 공용)
+QJsonObject roadLineToJson(const RoadLineData &lineData)
+{
+    QJsonObject data;
+    data["index"] = lineData.index;
+    data["matrixNum1"] = lineData.matrixNum1;
+    data["x1"] = lineData.x1;
+    data["y1"] = lineData.y1;
+    data["matrixNum2"] = lineData.matrixNum2;
+    data["x2"] = lineData.x2;
+    data["y2"] = lineData.y2;
+    return data;
+}
+
+QJsonObject detectionLineToJson(const DetectionLineData &lineData)
+{
+    QJsonObject data;
+    data["index"] = lineData.index;
+    data["x1"] = lineData.x1;
+    data["x2"] = lineData.x2;
+    data["y1"] = lineData.y1;
+    data["y2"] = lineData.y2;
+    data["name"] = lineData.name;
+    data["mode"] = lineData.mode;
+    return data;
+}
+
+QJsonObject perpendicularLineToJson(const PerpendicularLineData &lineData)
+{
+    QJsonObject data;
+    data["index"] = lineData.index;
+    data["a"] = lineData.a;
+    data["b"] = lineData.b;
+    return data;
+}
+
+// 캐시에서 만든 페이지의 cursor (서버 cursor와 겹치지 않도록 접두어를 붙임)
+const QString CacheCursorPrefix = QStringLiteral("cache:");
+
+QFuture<TcpResponse> readyResponse(const TcpResponse &response)
+{
+    QPromise<TcpResponse> promise;
+    QFuture<TcpResponse> future = promise.future();
+    promise.start();
+    promise.addResult(response);
+    promise.finish();
+    return future;
+}
+}
 
 TcpCommunicator::TcpCommunicator(QObject *parent)
     : QObject(parent)
-    , m_socket(new QSslSocket(this))
-    , m_connectionTimer(nullptr)
-    , m_reconnectTimer(new QTimer(this))
+    , m_networkThread(new QThread(this))
+    , m_worker(new NetworkWorker())
     , m_host("")
     , m_port(0)
     , m_isConnected(false)
-    , m_receivedData("")
+    , m_connectionState(ConnectionState::Idle)
+    , m_rttMs(-1)
+    , m_jitterMs(-1)
+    , m_nextMessageId(0)
+    , m_categorizedUploadPending(false)
+    , m_inFlightTimer(new QTimer(this))
+    , m_metricsTimer(new QTimer(this))
+    , m_captureCache(std::make_unique<CaptureCache>())
+    , m_cacheSaveTimer(new QTimer(this))
+    , m_bulkThread(nullptr)
+    , m_bulkWorker(nullptr)
+    , m_bulkReady(false)
+    , m_bulkUnavailable(false)
+    , m_bulkIdleTimer(new QTimer(this))
     , m_videoView(nullptr)
-
-    , m_connectionTimeoutMs(10000)
-    , m_reconnectEnabled(true)
-    , m_reconnectAttempts(0)
-    , m_maxReconnectAttempts(5)
-    , m_reconnectDelayMs(3000)
-    , m_autoReconnect(true)
-
-    , m_roadLinesReceived(false)
-    , m_detectionLinesReceived(false)
 {
     qDebug() << "[TCP] TcpCommunicator 생성자 호출";
-    m_socket = new QSslSocket(this);
-    setupSslConfiguration();
-
-    // Keep-Alive settings
-    m_socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
-    m_socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
-
-    // TCP 소켓 시그널 연결
-    connect(m_socket, &QSslSocket::connected, this, &TcpCommunicator::onConnected);
-    connect(m_socket, &QSslSocket::disconnected, this, &TcpCommunicator::onDisconnected);
-    connect(m_socket, &QSslSocket::readyRead, this, &TcpCommunicator::onReadyRead);
-    connect(m_socket, QOverload<QAbstractSocket::SocketError>::of(&QSslSocket::errorOccurred),
-            this, &TcpCommunicator::onSocketError);
-
-    // Connect SSL signals
-    connect(m_socket, &QSslSocket::encrypted, this, &TcpCommunicator::onSslEncrypted);
-    connect(m_socket, QOverload<const QList<QSslError>&>::of(&QSslSocket::sslErrors),
-            this, &TcpCommunicator::onSslErrors);
-
-    // Connection timeout timer
-    m_connectionTimer = new QTimer(this);
-    m_connectionTimer->setSingleShot(true);
-    m_connectionTimer->setInterval(m_connectionTimeoutMs);
-    connect(m_connectionTimer, &QTimer::timeout, this, &TcpCommunicator::onConnectionTimeout);
-
-    // 재연결 타이머 설정
-    m_reconnectTimer->setSingleShot(true);
-    m_reconnectTimer->setInterval(m_reconnectDelayMs);
-    connect(m_reconnectTimer, &QTimer::timeout, this, &TcpCommunicator::onReconnectTimer);
+
+    qRegisterMetaType<ImageData>("ImageData");
+    qRegisterMetaType<DetectionLineData>("DetectionLineData");
+    qRegisterMetaType<RoadLineData>("RoadLineData");
+    qRegisterMetaType<QList<ImageData>>("QList<ImageData>");
+    qRegisterMetaType<ImagePage>("ImagePage");
+    qRegisterMetaType<QList<DetectionLineData>>("QList<DetectionLineData>");
+    qRegisterMetaType<QList<RoadLineData>>("QList<RoadLineData>");
+    qRegisterMetaType<BBoxFrameSnapshot>("BBoxFrameSnapshot");
+    qRegisterMetaType<LineUploadResult>("LineUploadResult");
+    qRegisterMetaType<QList<LineUploadResult>>("QList<LineUploadResult>");
+    qRegisterMetaType<ConnectionState>("ConnectionState");
+    qRegisterMetaType<OutboundLaneMetrics>("OutboundLaneMetrics");
+    qRegisterMetaType<QList<OutboundLaneMetrics>>("QList<OutboundLaneMetrics>");
+
+    // 진행 중 요청의 기한 검사 (가장 가까운 기한에 맞춰 한 번만 울림)
+    m_inFlightTimer->setSingleShot(true);
+    connect(m_inFlightTimer, &QTimer::timeout, this, &TcpCommunicator::onInFlightTimer);
+
+    m_bulkIdleTimer->setSingleShot(true);
+    m_bulkIdleTimer->setInterval(BulkIdleTimeoutMs);
+    connect(m_bulkIdleTimer, &QTimer::timeout, this, &TcpCommunicator::onBulkIdleTimeout);
+
+    m_metricsClock.start();
+    connect(m_metricsTimer, &QTimer::timeout, this, &TcpCommunicator::writeMetricsSnapshot);
+
+    // 캐시 목록 저장은 이미지 파일을 쓰는 네트워크 스레드에서 (GUI 스레드에서 파일을 쓰지 않음)
+    m_cacheSaveTimer->setInterval(CacheSaveIntervalMs);
+    connect(m_cacheSaveTimer, &QTimer::timeout, this, [this]() {
+        CaptureCache *cache = m_captureCache.get();
+        QMetaObject::invokeMethod(m_worker, [cache]() {
+            cache->flush();
+        }, Qt::QueuedConnection);
+    });
+
+    // 소켓, 프레이밍, JSON 파싱은 모두 네트워크 스레드에서 수행
+    m_networkThread->setObjectName("TcpNetworkThread");
+    m_worker->setMetrics(&m_metrics);
+    m_worker->setCaptureCache(m_captureCache.get());
+    m_worker->moveToThread(m_networkThread);
+    connect(m_networkThread, &QThread::started, m_worker, &NetworkWorker::initialize);
+
+    // 연결 상태는 GUI 측 사본을 갱신한 뒤 전달
+    connect(m_worker, &NetworkWorker::connected, this, &TcpCommunicator::onWorkerConnected);
+    connect(m_worker, &NetworkWorker::disconnected, this, &TcpCommunicator::onWorkerDisconnected);
+    connect(m_worker, &NetworkWorker::connectionStateChanged, this, &TcpCommunicator::onWorkerStateChanged);
+    connect(m_worker, &NetworkWorker::reconnected, this, &TcpCommunicator::reconnected);
+    connect(m_worker, &NetworkWorker::rttUpdated, this, &TcpCommunicator::onWorkerRttUpdated);
+    connect(m_worker, &NetworkWorker::outboundMetricsUpdated, this, &TcpCommunicator::onWorkerOutboundMetrics);
+    connect(m_worker, &NetworkWorker::replayFinished, this, &TcpCommunicator::replayFinished);
+
+    // 타입이 정해진 결과만 GUI 스레드로 전달 (Queued)
+    connect(m_worker, &NetworkWorker::errorOccurred, this, &TcpCommunicator::errorOccurred);
+    connect(m_worker, &NetworkWorker::messageReceived, this, &TcpCommunicator::messageReceived);
+    connect(m_worker, &NetworkWorker::imagesReceived, this, &TcpCommunicator::imagesReceived);
+    connect(m_worker, &NetworkWorker::coordinatesConfirmed, this, &TcpCommunicator::coordinatesConfirmed);
+    connect(m_worker, &NetworkWorker::detectionLineConfirmed, this, &TcpCommunicator::detectionLineConfirmed);
+    connect(m_worker, &NetworkWorker::statusUpdated, this, &TcpCommunicator::statusUpdated);
+    connect(m_worker, &NetworkWorker::messageSent, this, &TcpCommunicator::messageSent);
+    connect(m_worker, &NetworkWorker::messageSent, this, &TcpCommunicator::onWorkerMessageSent);
+    connect(m_worker, &NetworkWorker::lineBatchResult, this, &TcpCommunicator::lineBatchResult);
+    connect(this, &TcpCommunicator::lineBatchResult, this, &TcpCommunicator::onLineBatchResult);
+    connect(m_worker, &NetworkWorker::serverCapabilitiesReceived, this, &TcpCommunicator::onServerCapabilitiesReceived);
+    connect(m_worker, &NetworkWorker::responseReceived, this, &TcpCommunicator::onWorkerResponse);
+    connect(m_worker, &NetworkWorker::roadLineConfirmed, this, &TcpCommunicator::roadLineConfirmed);
+    connect(m_worker, &NetworkWorker::perpendicularLineConfirmed, this, &TcpCommunicator::perpendicularLineConfirmed);
+    connect(m_worker, &NetworkWorker::categorizedCoordinatesConfirmed, this, &TcpCommunicator::categorizedCoordinatesConfirmed);
+    connect(m_worker, &NetworkWorker::bboxFrameReceived, this, &TcpCommunicator::onWorkerBBoxFrame);
+    connect(m_worker, &NetworkWorker::sessionTicketUpdated, this, [this](const QByteArray &ticket) {
+        m_sessionTicket = ticket;
+    });
+
+    // 저장된 선 데이터: 한 번 디코딩된 결과를 다이얼로그 시그널과 VideoGraphicsView에 전달
+    subscribe<QList<RoadLineData>>(16, this, [this](const QList<RoadLineData> &roadLines) {
+        emit savedRoadLinesReceived(roadLines);
+    });
+    subscribe<QList<RoadLineData>>(16, this, [this](const QList<RoadLineData> &roadLines) {
+        handleRoadLinesFromServer(roadLines);
+    });
+    subscribe<QList<DetectionLineData>>(12, this, [this](const QList<DetectionLineData> &detectionLines) {
+        emit savedDetectionLinesReceived(detectionLines);
+    });
+    subscribe<QList<DetectionLineData>>(12, this, [this](const QList<DetectionLineData> &detectionLines) {
+        handleDetectionLinesFromServer(detectionLines);
+    });
+
+    m_networkThread->start();
 
     qDebug() << "[TCP] TcpCommunicator 초기화 완료";
 }
 
 TcpCommunicator::~TcpCommunicator()
 {
-    disconnectFromServer();
+    if (m_networkThread->isRunning()) {
+        // 소켓과 타이머는 소유 스레드에서 정리한 뒤 스레드 종료
+        QMetaObject::invokeMethod(m_worker, &NetworkWorker::shutdown, Qt::BlockingQueuedConnection);
+        m_networkThread->quit();
+        m_networkThread->wait();
+    }
+    if (m_bulkThread && m_bulkThread->isRunning()) {
+        QMetaObject::invokeMethod(m_bulkWorker, &NetworkWorker::shutdown, Qt::BlockingQueuedConnection);
+        m_bulkThread->quit();
+        m_bulkThread->wait();
+    }
+    delete m_bulkWorker;
+    delete m_worker;
+
+    // 마지막 통계를 남김 (캐시 목록은 m_captureCache가 소멸하며 close()에서 저장)
+    if (m_metricsTimer->isActive()) {
+        m_metricsTimer->stop();
+        writeMetricsSnapshot();
+    }
 }
 
 void TcpCommunicator::disconnectFromServer()
 {
-    if (m_connectionTimer->isActive()) {
-        m_connectionTimer->stop();
+    QMetaObject::invokeMethod(m_worker, &NetworkWorker::disconnectFromServer, Qt::QueuedConnection);
+}
+
+void TcpCommunicator::connectToServer(const QString &host, quint16 port)
+{
+    qDebug() << "[TCP] connectToServer 호출 - 호스트:" << host << "포트:" << port;
+
+    m_host = host;
+    m_port = port;
+
+    // 연결은 네트워크 스레드에서 비동기로 진행 - 결과는 connected/errorOccurred 시그널로 전달
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker, host, port]() {
+        worker->connectToServer(host, port);
+    }, Qt::QueuedConnection);
+}
+
+bool TcpCommunicator::isConnectedToServer() const
+{
+    return m_isConnected;
+}
+
+bool TcpCommunicator::sendJsonMessage(const QJsonObject &message, quint64 *messageId)
+{
+    if (!isConnectedToServer()) {
+        qDebug() << "[TCP] 메시지 전송 실패 - 서버에 연결되지 않음";
+        return false;
     }
-    if (m_reconnectTimer->isActive()) {
-        m_reconnectTimer->stop();
+
+    quint64 id = ++m_nextMessageId;
+    if (messageId) {
+        *messageId = id;
     }
 
-    if (m_socket && m_socket->state() != QAbstractSocket::UnconnectedState) {
-        m_socket->disconnectFromHost();
-        if (m_socket->state() != QAbstractSocket::UnconnectedState) {
-            m_socket->waitForDisconnected(3000);
-        }
+    // 모든 메시지에 상관 ID를 실어 보냄 (지원하는 서버는 응답에 그대로 돌려줌)
+    QJsonObject framed = message;
+    framed["seq"] = static_cast<qint64>(id);
+
+    int requestId = message["request_id"].toInt();
+    MessagePriority priority = priorityFor(requestId);
+
+    if (usesBulkChannel(requestId) && serverSupports("bulk_channel")
+        && !m_sessionId.isEmpty() && !m_bulkUnavailable) {
+        sendOnBulkChannel(framed, id, priority);
+        return true;
+    }
+
+    // 직렬화와 소켓 쓰기는 네트워크 스레드에서 수행
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker, framed, id, priority]() {
+        worker->sendJsonMessage(framed, id, priority);
+    }, Qt::QueuedConnection);
+    return true;
+}
+
+MessagePriority TcpCommunicator::priorityFor(int requestId)
+{
+    switch (requestId) {
+    case 8:     // 로그인
+    case 22:    // OTP 로그인
+    case 31:    // BBox 켜기
+    case 32:    // BBox 끄기
+    case 50:    // hello
+    case 60:    // 하트비트
+        return MessagePriority::Control;
+    case 1:     // 이미지 조회
+    case 2:     // 감지선 전송
+    case 5:     // 도로선 전송
+    case 6:     // 수직선 전송
+    case 40:    // 선 일괄 업로드
+        return MessagePriority::Bulk;
+    default:
+        return MessagePriority::Interactive;
+    }
+}
+
+bool TcpCommunicator::usesBulkChannel(int requestId)
+{
+    switch (requestId) {
+    case 1:     // 이미지 조회 (응답 10은 수십 MB까지 커짐)
+    case 24:    // 원본 이미지
+        return true;
+    default:
+        return false;
     }
 }
 
-void TcpCommunicator::setupSslConfiguration() {
-    // Register server's CA certificate (e.g., ca-cert.pem file)
-    QSslConfiguration sslConfiguration = QSslConfiguration::defaultConfiguration();
+void TcpCommunicator::sendOnBulkChannel(const QJsonObject &framed, quint64 id, MessagePriority priority)
+{
+    m_bulkSeqs.insert(id);
+    m_bulkIdleTimer->start();
 
-    // 2. Load server's CA certificate
-    QList<QSslCertificate> caCerts = QSslCertificate::fromPath(":/ca-cert.crt");
-    if (!caCerts.isEmpty()) {
-        qDebug() << "[TCP] CA certificates loaded:" << caCerts.size() << "items";
-        // 3. Add loaded CA certificates to SSL configuration
-        sslConfiguration.setCaCertificates(caCerts);
-    } else {
-        qDebug() << "[TCP] Warning: ca-cert.crt file not found or could not be read.";
-        qDebug() << "[TCP] SSL 인증서 검증을 완화하여 연결을 시도합니다.";
+    if (!m_bulkReady) {
+        // 연결이 준비되면 onBulkChannelReady에서 순서대로 전송
+        m_bulkPending.append(BulkMessage{ framed, id, priority });
+        ensureBulkChannel();
+        return;
     }
 
-    // 4. Apply SSL configuration to the socket
-    m_socket->setSslConfiguration(sslConfiguration);
+    NetworkWorker *worker = m_bulkWorker;
+    QMetaObject::invokeMethod(m_bulkWorker, [worker, framed, id, priority]() {
+        worker->sendJsonMessage(framed, id, priority);
+    }, Qt::QueuedConnection);
+}
 
-    // 5. Set server certificate verification mode
-    // 개발 환경에서는 VerifyNone으로 설정하여 연결 문제 해결
-    m_socket->setPeerVerifyMode(QSslSocket::VerifyNone);
-    qDebug() << "[TCP] SSL Peer verification mode set to VerifyNone for development";
+void TcpCommunicator::ensureBulkChannel()
+{
+    if (!m_bulkWorker) {
+        qDebug() << "[TCP] Opening bulk transfer channel";
+
+        // 응답 10의 스트림 파싱, 디코딩, 캐시 저장이 BBox 디코딩을 막지 않도록 별도 스레드에서 실행
+        m_bulkThread = new QThread(this);
+        m_bulkThread->setObjectName("TcpBulkThread");
+        m_bulkWorker = new NetworkWorker();
+        m_bulkWorker->setMetrics(&m_metrics);
+        m_bulkWorker->setCaptureCache(m_captureCache.get());
+        m_bulkWorker->moveToThread(m_bulkThread);
+
+        // 응답과 전송 완료는 주 연결과 같은 경로로 (seq는 두 연결이 공유)
+        connect(m_bulkWorker, &NetworkWorker::responseReceived, this, &TcpCommunicator::onWorkerResponse);
+        connect(m_bulkWorker, &NetworkWorker::responseReceived, this, [this]() {
+            m_bulkIdleTimer->start();
+        });
+        connect(m_bulkWorker, &NetworkWorker::messageSent, this, &TcpCommunicator::messageSent);
+        connect(m_bulkWorker, &NetworkWorker::messageSent, this, &TcpCommunicator::onWorkerMessageSent);
+        connect(m_bulkWorker, &NetworkWorker::imagesReceived, this, &TcpCommunicator::imagesReceived);
+        connect(m_bulkWorker, &NetworkWorker::messageReceived, this, &TcpCommunicator::messageReceived);
+        connect(m_bulkWorker, &NetworkWorker::serverCapabilitiesReceived, this, &TcpCommunicator::onBulkChannelReady);
+        connect(m_bulkWorker, &NetworkWorker::disconnected, this, &TcpCommunicator::onBulkChannelLost);
+        connect(m_bulkWorker, &NetworkWorker::connectionStateChanged, this, [this](ConnectionState state) {
+            // 연결 단계에서 실패하면 disconnected가 오지 않음
+            if (state == ConnectionState::Idle && !m_bulkReady) {
+                onBulkChannelLost();
+            }
+        });
+        connect(m_bulkWorker, &NetworkWorker::errorOccurred, this, [](const QString &error) {
+            // 보조 연결 오류는 주 연결로 되돌아가 처리하므로 사용자에게 띄우지 않음
+            qDebug() << "[TCP] Bulk channel error:" << error;
+        });
+
+        // 새 TLS 세션 티켓은 GUI 스레드를 거치지 않고 보조 스레드로 바로 전달
+        connect(m_worker, &NetworkWorker::sessionTicketUpdated, m_bulkWorker, &NetworkWorker::setSessionTicket);
+        connect(m_bulkThread, &QThread::started, m_bulkWorker, &NetworkWorker::initialize);
+
+        m_bulkThread->start();
+    }
+
+    // 유휴로 끊긴 뒤 다시 필요해지면 같은 워커로 다시 연결 (재연결은 이 함수가 필요할 때만)
+    NetworkWorker *worker = m_bulkWorker;
+    QString host = m_host;
+    quint16 port = m_port;
+    QString sessionId = m_sessionId;
+    QByteArray ticket = m_sessionTicket;
+    QSize thumbnailSize = m_thumbnailSize;
+    QMetaObject::invokeMethod(m_bulkWorker, [worker, host, port, sessionId, ticket, thumbnailSize]() {
+        worker->setReconnectEnabled(false);
+        worker->setChannelSession(sessionId);
+        worker->setSessionTicket(ticket);
+        worker->setThumbnailSize(thumbnailSize);
+        worker->connectToServer(host, port);
+    }, Qt::QueuedConnection);
 }
 
-void TcpCommunicator::connectToServer(const QString &host, quint16 port)
+void TcpCommunicator::onBulkChannelReady(const QStringList &capabilities, const QString &sessionId)
 {
-    qDebug() << "[TCP] connectToServer 호출 - 호스트:" << host << "포트:" << port;
+    Q_UNUSED(capabilities);
+
+    // 서버가 같은 세션으로 받아 주었을 때만 사용 (다른 세션이면 인증이 이어지지 않음)
+    if (sessionId.isEmpty() || sessionId != m_sessionId) {
+        qDebug() << "[TCP] Bulk channel was not attached to the session - using primary connection";
+        m_bulkUnavailable = true;
+        closeBulkChannel();
+        fallBackToPrimary();
+        return;
+    }
 
-    m_host = host;
-    m_port = port;
+    qDebug() << "[TCP] Bulk transfer channel ready - pending messages:" << m_bulkPending.size();
+    m_bulkReady = true;
+
+    const QList<BulkMessage> pending = std::exchange(m_bulkPending, {});
+    NetworkWorker *worker = m_bulkWorker;
+    for (const BulkMessage &message : pending) {
+        QJsonObject framed = message.message;
+        quint64 id = message.id;
+        MessagePriority priority = message.priority;
+        QMetaObject::invokeMethod(m_bulkWorker, [worker, framed, id, priority]() {
+            worker->sendJsonMessage(framed, id, priority);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void TcpCommunicator::onBulkChannelLost()
+{
+    bool wasReady = m_bulkReady;
+    m_bulkReady = false;
+    m_bulkIdleTimer->stop();
+
+    // 보조 연결로 보내고 응답을 기다리던 요청은 실패로 완료 (호출자가 다시 요청)
+    for (qsizetype i = m_inFlight.size() - 1; i >= 0; --i) {
+        if (m_bulkSeqs.contains(m_inFlight[i].seq)) {
+            finishRequest(i, TcpResponse::Disconnected);
+        }
+    }
+    armInFlightTimer();
+
+    // 한 번도 붙지 못했으면 이번 세션에서는 주 연결만 사용
+    if (!wasReady && !m_bulkPending.isEmpty()) {
+        qDebug() << "[TCP] Bulk channel could not be opened - using primary connection";
+        m_bulkUnavailable = true;
+        fallBackToPrimary();
+    }
+    m_bulkSeqs.clear();
+}
 
-    // 이미 연결되어 있으면 연결 해제 후 재연결
-    if (m_socket->state() != QSslSocket::UnconnectedState) {
-        qDebug() << "[TCP] 기존 연결 해제 중... 현재 상태:" << m_socket->state();
-        m_socket->disconnectFromHost();
-        if (m_socket->state() != QSslSocket::UnconnectedState) {
-            m_socket->waitForDisconnected(1000);
+void TcpCommunicator::onBulkIdleTimeout()
+{
+    // 다운로드 중인 요청이 남아 있으면 기다림
+    for (const PendingRequest &pending : std::as_const(m_inFlight)) {
+        if (m_bulkSeqs.contains(pending.seq)) {
+            m_bulkIdleTimer->start();
+            return;
         }
     }
 
-    qDebug() << "[TCP] 서버 연결 시도:" << host << ":" << port;
-    qDebug() << "[TCP] SSL 설정 확인 - Peer Verify Mode:" << m_socket->peerVerifyMode();
-    
-    m_socket->connectToHostEncrypted(m_host, static_cast<qint16>(m_port));
+    qDebug() << "[TCP] Bulk transfer channel idle - closing";
+    closeBulkChannel();
+}
+
+void TcpCommunicator::closeBulkChannel()
+{
+    m_bulkIdleTimer->stop();
+    m_bulkReady = false;
+    m_bulkSeqs.clear();
+    if (m_bulkWorker) {
+        QMetaObject::invokeMethod(m_bulkWorker, &NetworkWorker::disconnectFromServer, Qt::QueuedConnection);
+    }
+}
+
+void TcpCommunicator::fallBackToPrimary()
+{
+    const QList<BulkMessage> pending = std::exchange(m_bulkPending, {});
+    NetworkWorker *worker = m_worker;
+    for (const BulkMessage &message : pending) {
+        QJsonObject framed = message.message;
+        quint64 id = message.id;
+        MessagePriority priority = message.priority;
+        m_bulkSeqs.remove(id);
+        QMetaObject::invokeMethod(m_worker, [worker, framed, id, priority]() {
+            worker->sendJsonMessage(framed, id, priority);
+        }, Qt::QueuedConnection);
+    }
+}
+
+OutboundLaneMetrics TcpCommunicator::outboundLaneMetrics(MessagePriority lane) const
+{
+    return m_laneMetrics.value(static_cast<int>(lane));
+}
+
+void TcpCommunicator::onWorkerOutboundMetrics(const QList<OutboundLaneMetrics> &lanes)
+{
+    m_laneMetrics = lanes;
+    emit outboundMetricsUpdated();
+}
+
+QFuture<TcpResponse> TcpCommunicator::request(const QJsonObject &message, int responseId, int timeoutMs, quint64 *seq)
+{
+    auto promise = std::make_shared<QPromise<TcpResponse>>();
+    QFuture<TcpResponse> future = promise->future();
+    promise->start();
+
+    quint64 id = 0;
+    if (!sendJsonMessage(message, &id)) {
+        TcpResponse response;
+        response.status = TcpResponse::SendFailed;
+        response.responseId = responseId;
+        promise->addResult(response);
+        promise->finish();
+        return future;
+    }
+
+    if (seq) {
+        *seq = id;
+    }
+
+    PendingRequest pending{ id, message["request_id"].toInt(), responseId, QElapsedTimer(), QDeadlineTimer(timeoutMs), promise };
+    pending.sentAt.start();
+    m_inFlight.append(std::move(pending));
+    armInFlightTimer();
+    return future;
+}
+
+void TcpCommunicator::cancelRequest(quint64 seq)
+{
+    for (qsizetype i = 0; i < m_inFlight.size(); ++i) {
+        if (m_inFlight[i].seq == seq) {
+            finishRequest(i, TcpResponse::Cancelled);
+            armInFlightTimer();
+            return;
+        }
+    }
+}
 
-    // 연결 타임아웃 설정 (10초)
-    if (!m_socket->waitForConnected(10000)) {
-        qDebug() << "[TCP] 연결 타임아웃 또는 실패:" << m_socket->errorString();
-        emit errorOccurred("연결 타임아웃: " + m_socket->errorString());
+void TcpCommunicator::onWorkerResponse(int responseId, quint64 seq, const QVariant &payload)
+{
+    QElapsedTimer handlerTimer;
+    handlerTimer.start();
+    qsizetype index = -1;
+
+    // seq가 있으면 정확히 매칭, 없으면(seq를 돌려주지 않는 서버) 같은 응답 타입을 기다리는 가장 오래된 요청
+    // seq가 있는데 맞는 요청이 없으면 이미 타임아웃/취소된 요청의 늦은 응답이므로 다른 요청에 넘기지 않음
+    if (seq != 0) {
+        for (qsizetype i = 0; i < m_inFlight.size(); ++i) {
+            if (m_inFlight[i].seq == seq) {
+                index = i;
+                break;
+            }
+        }
+        if (index < 0) {
+            qDebug() << "[TCP] Late response without pending request - response_id:" << responseId << "seq:" << seq;
+        }
     } else {
-        qDebug() << "[TCP] TCP 연결 성공, SSL 핸드셰이크 대기 중...";
+        for (qsizetype i = 0; i < m_inFlight.size(); ++i) {
+            if (m_inFlight[i].responseId == responseId) {
+                index = i;
+                break;
+            }
+        }
+    }
+
+    if (index >= 0) {
+        finishRequest(index, TcpResponse::Ok, payload);
+        armInFlightTimer();
     }
+
+    // 요청한 쪽과 별개로 이 응답 타입을 구독한 모든 곳에 전달
+    m_dispatcher.dispatch(responseId, payload);
+    m_metrics.recordTiming(NetworkMetrics::HandlerTime, responseId, handlerTimer.nsecsElapsed() / 1000);
 }
 
-bool TcpCommunicator::isConnectedToServer() const
+void TcpCommunicator::onWorkerBBoxFrame(const BBoxFrameSnapshot &frame)
 {
-    return m_isConnected && m_socket && m_socket->state() == QAbstractSocket::ConnectedState;
+    // 오버레이 갱신은 직접 연결된 슬롯에서 바로 실행되므로 emit 시간이 곧 처리 시간
+    QElapsedTimer handlerTimer;
+    handlerTimer.start();
+    emit bboxFrameReceived(frame);
+    m_metrics.recordTiming(NetworkMetrics::HandlerTime, 200, handlerTimer.nsecsElapsed() / 1000);
 }
 
-bool TcpCommunicator::sendJsonMessage(const QJsonObject &message)
+void TcpCommunicator::resetNetworkMetrics()
 {
-    if (!isConnectedToServer()) {
-        qDebug() << "[TCP] 메시지 전송 실패 - 서버에 연결되지 않음";
-        return false;
+    m_metrics.reset();
+}
+
+QJsonObject TcpCommunicator::metricsSnapshot() const
+{
+    QJsonObject snapshot = m_metrics.toJson();
+    snapshot["generated_at"] = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
+    snapshot["uptime_ms"] = m_metricsClock.elapsed();
+    snapshot["connection_state"] = static_cast<int>(m_connectionState);
+    snapshot["rtt_ms"] = m_rttMs;
+    snapshot["jitter_ms"] = m_jitterMs;
+
+    QJsonArray lanes;
+    for (const OutboundLaneMetrics &lane : m_laneMetrics) {
+        lanes.append(QJsonObject{
+            { "queued_messages", lane.queuedMessages },
+            { "queued_bytes", lane.queuedBytes },
+            { "sent_messages", qint64(lane.sentMessages) },
+            { "max_wait_ms", lane.maxWaitMs },
+            { "average_wait_ms", lane.averageWaitMs },
+        });
+    }
+    snapshot["lanes"] = lanes;
+
+    // GUI 스레드 멈춤 기록도 같은 스냅샷에 (감시자가 켜져 있을 때)
+    if (EventLoopWatchdog *watchdog = EventLoopWatchdog::instance()) {
+        snapshot["gui_stalls"] = watchdog->toJson();
+    }
+    return snapshot;
+}
+
+void TcpCommunicator::setMetricsSnapshotFile(const QString &path, int intervalMs)
+{
+    m_metricsFile = path;
+    if (path.isEmpty() || intervalMs <= 0) {
+        m_metricsTimer->stop();
+        return;
+    }
+    qDebug() << "[TCP] Writing network metrics to" << path << "every" << intervalMs << "ms";
+    m_metricsTimer->start(intervalMs);
+}
+
+void TcpCommunicator::writeMetricsSnapshot()
+{
+    // 읽는 쪽이 쓰다 만 파일을 보지 않도록 임시 파일에 쓴 뒤 교체
+    QSaveFile file(m_metricsFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "[TCP] Failed to write network metrics:" << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(metricsSnapshot()).toJson(QJsonDocument::Indented));
+    if (!file.commit()) {
+        qDebug() << "[TCP] Failed to write network metrics:" << file.errorString();
+    }
+}
+
+void TcpCommunicator::onInFlightTimer()
+{
+    for (qsizetype i = m_inFlight.size() - 1; i >= 0; --i) {
+        const PendingRequest &pending = m_inFlight[i];
+        if (pending.promise->isCanceled()) {
+            finishRequest(i, TcpResponse::Cancelled);
+        } else if (pending.deadline.hasExpired()) {
+            qDebug() << "[TCP] 요청 타임아웃 - seq:" << pending.seq << "응답 대기:" << pending.responseId;
+            finishRequest(i, TcpResponse::Timeout);
+        }
+    }
+    armInFlightTimer();
+}
+
+void TcpCommunicator::finishRequest(qsizetype index, TcpResponse::Status status, const QVariant &payload)
+{
+    PendingRequest pending = m_inFlight.takeAt(index);
+    m_bulkSeqs.remove(pending.seq);
+    if (status == TcpResponse::Ok) {
+        m_metrics.recordTiming(NetworkMetrics::ResponseLatency, pending.requestId, pending.sentAt.nsecsElapsed() / 1000);
     }
 
-    QJsonDocument doc(message);
-    QByteArray data = doc.toJson(QJsonDocument::Compact);
+    TcpResponse response;
+    response.status = status;
+    response.responseId = pending.responseId;
+    response.payload = payload;
 
-    // qDebug() << "[TCP] JSON 메시지 전송 시도:" << data;
+    pending.promise->addResult(response);
+    pending.promise->finish();
+}
 
-    // 1. 데이터 길이(4바이트, 빅엔디안) 전송
-    quint32 dataLength = static_cast<quint32>(data.size());
-    QByteArray lengthBytes;
-    QDataStream lengthStream(&lengthBytes, QIODevice::WriteOnly);
-    lengthStream.setByteOrder(QDataStream::BigEndian);
-    lengthStream << dataLength;
-    
-    // 2. 길이 + 데이터 순서로 전송
-    qint64 bytesWritten = m_socket->write(lengthBytes);
-    if (bytesWritten != 4) {
-        qDebug() << "[TCP] 길이 정보 전송 실패:" << m_socket->errorString();
-        return false;
+void TcpCommunicator::failAllRequests(TcpResponse::Status status)
+{
+    while (!m_inFlight.isEmpty()) {
+        finishRequest(0, status);
     }
-    bytesWritten = m_socket->write(data);
-    bool flushed = m_socket->flush();
+    m_inFlightTimer->stop();
+}
 
-    if (bytesWritten == -1) {
-        qDebug() << "[TCP] 메시지 전송 실패:" << m_socket->errorString();
-        return false;
+void TcpCommunicator::armInFlightTimer()
+{
+    if (m_inFlight.isEmpty()) {
+        m_inFlightTimer->stop();
+        return;
     }
 
-    qDebug() << "[TCP] 메시지 전송 성공 - 바이트:" << bytesWritten << "플러시:" << flushed;
-    return true;
+    // 가장 가까운 기한에 맞춰 울리되, future.cancel()도 확인할 수 있도록 최대 1초 간격
+    qint64 nearest = 1000;
+    for (const PendingRequest &pending : std::as_const(m_inFlight)) {
+        nearest = qMin(nearest, pending.deadline.remainingTime());
+    }
+    m_inFlightTimer->start(static_cast<int>(qMax<qint64>(0, nearest)));
 }
 
 bool TcpCommunicator::sendMessage(const QString &message)
@@ -215,7 +699,7 @@ bool TcpCommunicator::sendLineCoordinates(int x1, int y1, int x2, int y2)
 
     bool success = sendJsonMessage(message);
     if (success) {
-        qDebug() << "[TCP] Coordinates sent successfully:" << x1 << y1 << x2 << y2;
+        qCDebug(lcProto) << "[TCP] Coordinates sent successfully:" << x1 << y1 << x2 << y2;
     } else {
         qDebug() << "[TCP] Failed to send coordinates.";
     }
@@ -238,21 +722,11 @@ bool TcpCommunicator::sendDetectionLine(const DetectionLineData &lineData)
 
     QJsonObject message;
     message["request_id"] = 2;
-
-    QJsonObject data;
-    data["index"] = lineData.index;
-    data["x1"] = lineData.x1;
-    data["x2"] = lineData.x2;
-    data["y1"] = lineData.y1;
-    data["y2"] = lineData.y2;
-    data["name"] = lineData.name;
-    data["mode"] = lineData.mode;
-
-    message["data"] = data;
+    message["data"] = detectionLineToJson(lineData);
 
     bool success = sendJsonMessage(message);
     if (success) {
-        qDebug() << "[TCP] Detection line sent successfully - index:" << lineData.index;
+        qCDebug(lcProto) << "[TCP] Detection line sent successfully - index:" << lineData.index;
     } else {
         qDebug() << "[TCP] Failed to send detection line.";
     }
@@ -270,21 +744,11 @@ bool TcpCommunicator::sendRoadLine(const RoadLineData &lineData)
 
     QJsonObject message;
     message["request_id"] = 5;
-
-    QJsonObject data;
-    data["index"] = lineData.index;
-    data["matrixNum1"] = lineData.matrixNum1;
-    data["x1"] = lineData.x1;
-    data["y1"] = lineData.y1;
-    data["matrixNum2"] = lineData.matrixNum2;
-    data["x2"] = lineData.x2;
-    data["y2"] = lineData.y2;
-
-    message["data"] = data;
+    message["data"] = roadLineToJson(lineData);
 
     bool success = sendJsonMessage(message);
     if (success) {
-        qDebug() << "[TCP] Road line sent successfully - index:" << lineData.index;
+        qCDebug(lcProto) << "[TCP] Road line sent successfully - index:" << lineData.index;
     } else {
         qDebug() << "[TCP] Failed to send road line.";
     }
@@ -302,17 +766,11 @@ bool TcpCommunicator::sendPerpendicularLine(const PerpendicularLineData &lineDat
 
     QJsonObject message;
     message["request_id"] = 6;
-
-    QJsonObject data;
-    data["index"] = lineData.index;
-    data["a"] = lineData.a;
-    data["b"] = lineData.b;
-
-    message["data"] = data;
+    message["data"] = perpendicularLineToJson(lineData);
 
     bool success = sendJsonMessage(message);
     if (success) {
-        qDebug() << "[TCP] 수직선 전송 성공 - index:" << lineData.index;
+        qCDebug(lcProto) << "[TCP] 수직선 전송 성공 - index:" << lineData.index;
     } else {
         qDebug() << "[TCP] 수직선 전송 실패.";
     }
@@ -388,8 +846,25 @@ bool TcpCommunicator::requestDeleteLines()
     return success;
 }
 
+QFuture<TcpResponse> TcpCommunicator::fetchSavedRoadLines()
+{
+    // 도로선 select all (request_id 7 → response_id 16)
+    QJsonObject message;
+    message["request_id"] = 7;
+    return request(message, 16);
+}
+
+QFuture<TcpResponse> TcpCommunicator::fetchSavedDetectionLines()
+{
+    // 감지선 select all (request_id 3 → response_id 12)
+    QJsonObject message;
+    message["request_id"] = 3;
+    return request(message, 12);
+}
+
 bool TcpCommunicator::sendMultipleRoadLines(const QList<RoadLineData> &roadLines)
 {
+    WATCHDOG_SCOPE("TcpCommunicator::sendMultipleRoadLines");
     if (!isConnectedToServer()) {
         qDebug() << "[TCP] Failed to send multiple road lines, no connection.";
         emit errorOccurred("Not connected to server");
@@ -399,13 +874,13 @@ bool TcpCommunicator::sendMultipleRoadLines(const QList<RoadLineData> &roadLines
     bool allSuccess = true;
     int successCount = 0;
 
+    // 전송 큐가 같은 이벤트 루프 차례의 메시지를 모아 보내므로 선마다 대기할 필요 없음
     for (const auto &line : roadLines) {
         if (sendRoadLine(line)) {
             successCount++;
         } else {
             allSuccess = false;
         }
-        QThread::msleep(100);
     }
 
     qDebug() << "[TCP] Multiple road lines sending complete - Success:" << successCount
@@ -416,6 +891,7 @@ bool TcpCommunicator::sendMultipleRoadLines(const QList<RoadLineData> &roadLines
 
 bool TcpCommunicator::sendMultipleDetectionLines(const QList<DetectionLineData> &detectionLines)
 {
+    WATCHDOG_SCOPE("TcpCommunicator::sendMultipleDetectionLines");
     if (!isConnectedToServer()) {
         qDebug() << "[TCP] Failed to send multiple detection lines, no connection.";
         emit errorOccurred("Not connected to server");
@@ -425,13 +901,13 @@ bool TcpCommunicator::sendMultipleDetectionLines(const QList<DetectionLineData>
     bool allSuccess = true;
     int successCount = 0;
 
+    // 전송 큐가 같은 이벤트 루프 차례의 메시지를 모아 보내므로 선마다 대기할 필요 없음
     for (const auto &line : detectionLines) {
         if (sendDetectionLine(line)) {
             successCount++;
         } else {
             allSuccess = false;
         }
-        QThread::msleep(50);
     }
 
     qDebug() << "[TCP] Multiple detection lines sending complete - Success:" << successCount
@@ -440,6 +916,135 @@ bool TcpCommunicator::sendMultipleDetectionLines(const QList<DetectionLineData>
     return allSuccess;
 }
 
+bool TcpCommunicator::sendLineBatch(const QList<RoadLineData> &roadLines,
+                                    const QList<DetectionLineData> &detectionLines,
+                                    const QList<PerpendicularLineData> &perpendicularLines)
+{
+    if (!isConnectedToServer()) {
+        qDebug() << "[TCP] Failed to send line batch, no connection.";
+        emit errorOccurred("Not connected to server");
+        return false;
+    }
+
+    if (serverSupports("line_batch")) {
+        // 한 번의 요청/응답으로 전체 설정을 업로드 (결과는 response_id 41)
+        QJsonArray roadArray;
+        for (const auto &line : roadLines) {
+            roadArray.append(roadLineToJson(line));
+        }
+        QJsonArray detectionArray;
+        for (const auto &line : detectionLines) {
+            detectionArray.append(detectionLineToJson(line));
+        }
+        QJsonArray perpendicularArray;
+        for (const auto &line : perpendicularLines) {
+            perpendicularArray.append(perpendicularLineToJson(line));
+        }
+
+        QJsonObject message;
+        message["request_id"] = 40;
+        message["road_lines"] = roadArray;
+        message["detection_lines"] = detectionArray;
+        message["perpendicular_lines"] = perpendicularArray;
+
+        // 응답이 오면 워커가 lineBatchResult를 보냄 - 응답 없이 끝나면 모든 선을 실패로 전달
+        QList<LineUploadResult> unconfirmed;
+        for (const auto &line : roadLines) {
+            unconfirmed.append(LineUploadResult{"road", line.index, false, QString()});
+        }
+        for (const auto &line : detectionLines) {
+            unconfirmed.append(LineUploadResult{"detection", line.index, false, QString()});
+        }
+        for (const auto &line : perpendicularLines) {
+            unconfirmed.append(LineUploadResult{"perpendicular", line.index, false, QString()});
+        }
+
+        quint64 seq = 0;
+        request(message, 41, DefaultRequestTimeoutMs, &seq)
+            .then(this, [this, unconfirmed](const TcpResponse &response) mutable {
+                if (response.isOk()) {
+                    return;
+                }
+                QString reason;
+                switch (response.status) {
+                case TcpResponse::Timeout:
+                    reason = "No response from server";
+                    break;
+                case TcpResponse::Disconnected:
+                    reason = "Connection lost before the server replied";
+                    break;
+                case TcpResponse::SendFailed:
+                    reason = "Not connected to server";
+                    break;
+                default:
+                    reason = "Request cancelled";
+                    break;
+                }
+                for (auto &result : unconfirmed) {
+                    result.message = reason;
+                }
+                emit lineBatchResult(unconfirmed);
+            });
+
+        bool success = seq != 0;
+        qDebug() << "[TCP] Line batch sent - road:" << roadLines.size()
+                 << "detection:" << detectionLines.size()
+                 << "perpendicular:" << perpendicularLines.size() << "success:" << success;
+        return success;
+    }
+
+    // 일괄 요청을 모르는 서버: 선마다 개별 메시지를 대기 없이 연속 전송하고
+    // 전송 완료(messageSent) 여부를 선별 결과로 모아 전달 (서버가 저장했는지는 알 수 없으므로 미확인으로 표시)
+    auto track = [this](bool sent, quint64 messageId, const QString &kind, int index) {
+        LineUploadResult result{kind, index, sent, sent ? QString() : QString("Not connected to server")};
+        if (sent) {
+            m_pendingLineSends.insert(messageId, result);
+        } else {
+            m_lineSendResults.append(result);
+        }
+        return sent;
+    };
+
+    bool allSuccess = true;
+    for (const auto &line : roadLines) {
+        QJsonObject message;
+        message["request_id"] = 5;
+        message["data"] = roadLineToJson(line);
+        quint64 messageId = 0;
+        allSuccess &= track(sendJsonMessage(message, &messageId), messageId, "road", line.index);
+    }
+    for (const auto &line : detectionLines) {
+        QJsonObject message;
+        message["request_id"] = 2;
+        message["data"] = detectionLineToJson(line);
+        quint64 messageId = 0;
+        allSuccess &= track(sendJsonMessage(message, &messageId), messageId, "detection", line.index);
+    }
+    for (const auto &line : perpendicularLines) {
+        QJsonObject message;
+        message["request_id"] = 6;
+        message["data"] = perpendicularLineToJson(line);
+        quint64 messageId = 0;
+        allSuccess &= track(sendJsonMessage(message, &messageId), messageId, "perpendicular", line.index);
+    }
+
+    qDebug() << "[TCP] Lines pipelined (server has no batch support) - count:"
+             << roadLines.size() + detectionLines.size() + perpendicularLines.size();
+
+    // 보낸 것이 없으면(빈 목록 또는 모두 즉시 실패) 전송 완료를 기다리지 않고 바로 결과 전달
+    if (m_pendingLineSends.isEmpty()) {
+        QList<LineUploadResult> results = m_lineSendResults;
+        m_lineSendResults.clear();
+        emit lineBatchResult(results);
+    }
+    return allSuccess;
+}
+
+bool TcpCommunicator::serverSupports(const QString &capability) const
+{
+    return m_serverCapabilities.contains(capability);
+}
+
 // Modified sendCategorizedLineCoordinates function
 bool TcpCommunicator::sendCategorizedLineCoordinates(const QList<CategorizedLineData> &roadLines, const QList<CategorizedLineData> &detectionLines)
 {
@@ -449,12 +1054,12 @@ bool TcpCommunicator::sendCategorizedLineCoordinates(const QList<CategorizedLine
         return false;
     }
 
-    bool roadSuccess = true;
-    bool detectionSuccess = true;
+    // 도로선과 감지선을 변환해 한 번의 일괄 요청으로 전송
+    QList<RoadLineData> serverRoadLines;
+    QList<DetectionLineData> serverDetectionLines;
 
-    // Convert and send road lines according to server format
+    // Convert road lines according to server format
     if (!roadLines.isEmpty()) {
-        QList<RoadLineData> serverRoadLines;
         for (int i = 0; i < roadLines.size(); ++i) {
             const auto &line = roadLines[i];
 
@@ -469,13 +1074,10 @@ bool TcpCommunicator::sendCategorizedLineCoordinates(const QList<CategorizedLine
 
             serverRoadLines.append(roadLineData);
         }
-
-        roadSuccess = sendMultipleRoadLines(serverRoadLines);
     }
 
-    // Convert and send detection lines according to server format
+    // Convert detection lines according to server format
     if (!detectionLines.isEmpty()) {
-        QList<DetectionLineData> serverDetectionLines;
         for (int i = 0; i < detectionLines.size(); ++i) {
             const auto &line = detectionLines[i];
 
@@ -492,17 +1094,18 @@ bool TcpCommunicator::sendCategorizedLineCoordinates(const QList<CategorizedLine
 
             serverDetectionLines.append(detectionLineData);
         }
-
-        detectionSuccess = sendMultipleDetectionLines(serverDetectionLines);
     }
 
-    bool overallSuccess = roadSuccess && detectionSuccess;
+    // 결과는 서버 응답(lineBatchResult)을 받은 뒤 onLineBatchResult에서 알림
+    m_categorizedUploadPending = true;
+    bool overallSuccess = sendLineBatch(serverRoadLines, serverDetectionLines);
 
     if (overallSuccess) {
-        qDebug() << "[TCP] Categorized coordinates sent successfully - Road lines:" << roadLines.size()
+        qDebug() << "[TCP] Categorized coordinates queued - Road lines:" << roadLines.size()
         << "items, Detection lines:" << detectionLines.size() << "items";
-        emit categorizedCoordinatesConfirmed(true, "Coordinates sent successfully", roadLines.size(), detectionLines.size());
-    } else {
+    } else if (m_categorizedUploadPending) {
+        // 결과가 오지 않는 실패 (연결 없음 등)
+        m_categorizedUploadPending = false;
         qDebug() << "[TCP] Failed to send categorized coordinates.";
         emit categorizedCoordinatesConfirmed(false, "Failed to send coordinates", 0, 0);
     }
@@ -510,737 +1113,500 @@ bool TcpCommunicator::sendCategorizedLineCoordinates(const QList<CategorizedLine
     return overallSuccess;
 }
 
-void TcpCommunicator::requestImageData(const QString &date, int hour)
+void TcpCommunicator::onLineBatchResult(const QList<LineUploadResult> &results)
 {
-    if (!isConnectedToServer()) {
-        qDebug() << "[TCP] Failed to request image data, no connection.";
-        emit errorOccurred("Not connected to server");
+    if (!m_categorizedUploadPending) {
         return;
     }
+    m_categorizedUploadPending = false;
 
-    QJsonObject message;
-    message["request_id"] = 1;
-
-    QJsonObject data;
-    QString requestDate = date.isEmpty() ? QDate::currentDate().toString("yyyy-MM-dd") : date;
-
-    if (hour >= 0 && hour <= 23) {
-        data["start_timestamp"] = QString("%1T%2").arg(requestDate).arg(hour, 2, 10, QChar('0'));
-        data["end_timestamp"] = QString("%1T%2").arg(requestDate).arg(hour + 1, 2, 10, QChar('0'));
-    } else {
-        data["start_timestamp"] = requestDate + "T00";
-        data["end_timestamp"] = requestDate + "T23";
+    int roadLines = 0;
+    int detectionLines = 0;
+    int failed = 0;
+    int unconfirmed = 0;
+    for (const auto &result : results) {
+        if (!result.success) {
+            ++failed;
+            continue;
+        }
+        if (!result.confirmed) {
+            ++unconfirmed;
+        }
+        if (result.kind == "road") {
+            ++roadLines;
+        } else if (result.kind == "detection") {
+            ++detectionLines;
+        }
     }
 
-    message["data"] = data;
-
-    bool success = sendJsonMessage(message);
-    if (success) {
-        qDebug() << "[TCP] Image request sent - request_id: 1, Date:" << requestDate << "Hour:" << hour;
-        emit statusUpdated("Requesting images...");
+    if (failed == 0) {
+        qDebug() << "[TCP] Categorized coordinates confirmed - Road lines:" << roadLines
+                 << "items, Detection lines:" << detectionLines << "items, unconfirmed:" << unconfirmed;
+        emit categorizedCoordinatesConfirmed(true, unconfirmed > 0 ? "Coordinates sent, not confirmed by server"
+                                                                   : "Coordinates sent successfully",
+                                             roadLines, detectionLines);
     } else {
-        qDebug() << "[TCP] Failed to request image data.";
-        emit errorOccurred("Failed to send image request");
+        qDebug() << "[TCP] Categorized coordinates rejected - failed lines:" << failed;
+        emit categorizedCoordinatesConfirmed(false, QString("Failed to set %1 of %2 lines").arg(failed).arg(results.size()),
+                                             roadLines, detectionLines);
     }
 }
 
-void TcpCommunicator::setConnectionTimeout(int timeoutMs)
+void TcpCommunicator::requestImageData(const QString &date, int hour)
 {
-    m_connectionTimeoutMs = timeoutMs;
+    requestImages(date, hour);
 }
 
-void TcpCommunicator::setReconnectEnabled(bool enabled)
+QFuture<TcpResponse> TcpCommunicator::requestImages(const QString &date, int hour)
 {
-    m_reconnectEnabled = enabled;
+    QString description = QString("Date: %1 Hour: %2").arg(date).arg(hour);
+    QString camera = captureCamera();
+    QDateTime start;
+    QDateTime end;
+    imageQueryRange(date, hour, start, end);
+    if (camera.isEmpty() || !start.isValid() || !m_captureCache->isOpen()) {
+        return sendImageQuery(imageQueryData(date, hour), description);
+    }
+
+    const QList<QPair<QDateTime, QDateTime>> missing = m_captureCache->missingRanges(camera, start, end);
+    if (missing.isEmpty()) {
+        qDebug() << "[Cache] Image query served from capture cache -" << description;
+        return cachedImagePage(camera, start, end, -1, 0);
+    }
+    if (missing.size() == 1 && missing.first().first == start && missing.first().second == end) {
+        return markCompleteWhenDone(sendImageQuery(imageQueryData(date, hour), description), camera, start, end, true);
+    }
+
+    // 캐시에 다 있는 시간대는 바로 보여 주고, 빠진 구간만 서버에 요청
+    QList<ImageData> cached;
+    QList<QFuture<TcpResponse>> requests;
+    QDateTime from = start;
+    for (const auto &range : missing) {
+        if (from < range.first) {
+            cached += m_captureCache->images(camera, from, range.first);
+        }
+        QFuture<TcpResponse> future = sendImageQuery(imageQueryData(range.first, range.second),
+                                                     QString("%1 (missing %2 - %3)").arg(description,
+                                                         range.first.toString("HH:mm"), range.second.toString("HH:mm")));
+        requests.append(markCompleteWhenDone(future, camera, range.first, range.second, true));
+        from = range.second;
+    }
+    if (from < end) {
+        cached += m_captureCache->images(camera, from, end);
+    }
+
+    qDebug() << "[Cache]" << cached.size() << "images from capture cache," << requests.size()
+             << "ranges requested from server -" << description;
+    if (!cached.isEmpty()) {
+        emit imagesReceived(cached);
+    }
+
+    // future 결과는 캐시와 서버 응답을 합친 한 페이지 (하나라도 실패하면 그 상태)
+    return QtFuture::whenAll(requests.begin(), requests.end())
+        .then(this, [cached](const QList<QFuture<TcpResponse>> &results) {
+            TcpResponse merged;
+            merged.responseId = 10;
+            ImagePage page;
+            page.images = cached;
+            for (const QFuture<TcpResponse> &result : results) {
+                if (!result.isValid() || result.isCanceled()) {
+                    merged.status = TcpResponse::Cancelled;
+                    continue;
+                }
+                TcpResponse response = result.result();
+                if (!response.isOk()) {
+                    if (merged.isOk()) {
+                        merged.status = response.status;
+                    }
+                    continue;
+                }
+                page.images += response.payload.value<ImagePage>().images;
+            }
+            std::sort(page.images.begin(), page.images.end(), [](const ImageData &a, const ImageData &b) {
+                return a.timestamp < b.timestamp;
+            });
+            page.total = page.images.size();
+            merged.payload = QVariant::fromValue(page);
+            return merged;
+        });
 }
 
-void TcpCommunicator::onConnected()
+QFuture<TcpResponse> TcpCommunicator::requestImagePage(const QString &date, int hour, int pageSize, const QString &cursor)
 {
-    m_connectionTimer->stop();
-    m_isConnected = true;
-    m_reconnectAttempts = 0;
-
-    qDebug() << "[TCP] Server connection successful.";
-    emit connected();
-    emit statusUpdated("Connected to server");
+    // 캐시에 다 있는 지난 시간대는 서버 대신 캐시에서 페이지를 만듦 (이후 페이지도 캐시 cursor로)
+    QString camera = captureCamera();
+    QDateTime start;
+    QDateTime end;
+    imageQueryRange(date, hour, start, end);
+    bool cacheUsable = !camera.isEmpty() && start.isValid();
+    if (cacheUsable && cursor.startsWith(CacheCursorPrefix)) {
+        return cachedImagePage(camera, start, end, pageSize, cursor.mid(CacheCursorPrefix.size()).toInt());
+    }
+    if (cacheUsable && cursor.isEmpty() && m_captureCache->isComplete(camera, start, end)) {
+        qDebug() << "[Cache] Image page served from capture cache - Date:" << date << "Hour:" << hour;
+        return cachedImagePage(camera, start, end, pageSize, 0);
+    }
+
+    // cursor는 서버가 준 값을 해석하지 않고 그대로 돌려줌
+    QJsonObject data = imageQueryData(date, hour);
+    data["page_size"] = pageSize;
+    if (!cursor.isEmpty()) {
+        data["cursor"] = cursor;
+    }
+    // 원본 대신 썸네일을 받고 원본은 클릭할 때 requestFullImage로
+    if (m_thumbnailSize.isValid() && serverSupports("thumbnails")) {
+        data["thumbnail_size"] = QJsonArray{ m_thumbnailSize.width(), m_thumbnailSize.height() };
+    }
+    QFuture<TcpResponse> future = sendImageQuery(data, QString("Date: %1 Hour: %2 Page size: %3%4")
+                                    .arg(date).arg(hour).arg(pageSize).arg(cursor.isEmpty() ? " (first page)" : ""));
+    return cacheUsable ? markCompleteWhenDone(future, camera, start, end, cursor.isEmpty()) : future;
 }
 
-void TcpCommunicator::onDisconnected()
+QFuture<TcpResponse> TcpCommunicator::requestImageCount(const QString &date, int hour)
 {
-    m_isConnected = false;
-    qDebug() << "[TCP] Disconnected from server.";
-
-    // Add log for socket state
-    qDebug() << "[TCP] Socket state:" << m_socket->state();
-    qDebug() << "[TCP] Socket error:" << m_socket->errorString();
-
-    emit disconnected();
-    emit statusUpdated("Disconnected from server");
-
-    // Attempt reconnection only on unexpected disconnections
-    if (m_reconnectEnabled && m_reconnectAttempts < m_maxReconnectAttempts) {
-        qDebug() << "[TCP] Scheduling reconnection attempt...";
-        m_reconnectTimer->setInterval(m_reconnectDelayMs);
-        m_reconnectTimer->start();
-    }
+    // 이미지 없이 total만 돌려받음 (응답 payload는 빈 ImagePage)
+    QJsonObject data = imageQueryData(date, hour);
+    data["count_only"] = true;
+    return sendImageQuery(data, QString("Date: %1 Hour: %2 (count only)").arg(date).arg(hour));
 }
 
-void TcpCommunicator::onReadyRead()
+void TcpCommunicator::setThumbnailSize(const QSize &size)
 {
-    static QByteArray buffer;
-    static quint32 expectedLength = 0;
-    static bool lengthReceived = false;
-
-    // Read all available data from the socket
-    QByteArray newData = m_socket->readAll();
-    buffer.append(newData);
-
-    qDebug() << "[TCP] Data received:" << newData.size() << "bytes, Total buffer size:" << buffer.size();
-
-    while (true) {
-        // Step 1: Read message length (4 bytes)
-        if (!lengthReceived) {
-            if (buffer.size() < 4) {
-                // Length information has not fully arrived
-                break;
-            }
-
-            // Extract length information
-            QDataStream lengthStream(buffer.left(4));
-            lengthStream.setByteOrder(QDataStream::BigEndian);
-            lengthStream >> expectedLength;
-
-            buffer.remove(0, 4); // Remove length information
-            lengthReceived = true;
-
-            qDebug() << "[TCP] Message length received:" << expectedLength << "bytes";
-        }
-
-        // Step 2: Read the actual message data
-        if (lengthReceived) {
-            if (buffer.size() < expectedLength) {
-                // The message has not fully arrived
-                qDebug() << "[TCP] Waiting for message... Current:" << buffer.size() << "/ Required:" << expectedLength;
-                break;
-            }
-
-            // Extract the complete message
-            QByteArray messageData = buffer.left(expectedLength);
-            buffer.remove(0, expectedLength);
-
-            // Reset state
-            lengthReceived = false;
-            expectedLength = 0;
-
-            qDebug() << "[TCP] Complete message received:" << messageData.size() << "bytes";
-
-            // JSON parsing and processing
-            QString messageString = QString::fromUtf8(messageData);
-            QJsonParseError error;
-            QJsonDocument doc = QJsonDocument::fromJson(messageData, &error);
-
-            if (error.error == QJsonParseError::NoError && doc.isObject()) {
-                QJsonObject jsonObj = doc.object();
-                logJsonMessage(jsonObj, false);
-                processJsonMessage(jsonObj);
-            } else {
-                qDebug() << "[TCP] JSON parsing error:" << error.errorString();
-                qDebug() << "[TCP] Original message:" << messageString.left(200) << "...";
-                emit messageReceived(messageString);
-            }
-        }
+    m_thumbnailSize = size;
+
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker, size]() {
+        worker->setThumbnailSize(size);
+    }, Qt::QueuedConnection);
+    if (m_bulkWorker) {
+        NetworkWorker *bulkWorker = m_bulkWorker;
+        QMetaObject::invokeMethod(m_bulkWorker, [bulkWorker, size]() {
+            bulkWorker->setThumbnailSize(size);
+        }, Qt::QueuedConnection);
     }
 }
 
-void TcpCommunicator::onError(QAbstractSocket::SocketError error)
+bool TcpCommunicator::openCaptureCache(const QString &directory, qint64 maxBytes)
 {
-    m_connectionTimer->stop();
-    m_isConnected = false;
-
-    QString errorString;
-    switch (error) {
-    case QAbstractSocket::ConnectionRefusedError:
-        errorString = "Connection refused. Please check if the server is running.";
-        break;
-    case QAbstractSocket::RemoteHostClosedError:
-        errorString = "The remote host closed the connection.";
-        break;
-    case QAbstractSocket::HostNotFoundError:
-        errorString = "Host not found. Please check the IP address.";
-        break;
-    case QAbstractSocket::SocketTimeoutError:
-        errorString = "Connection timed out.";
-        break;
-    case QAbstractSocket::NetworkError:
-        errorString = "A network error occurred.";
-        break;
-    default:
-        errorString = QString("Socket error: %1").arg(m_socket->errorString());
-        break;
+    if (maxBytes <= 0) {
+        m_cacheSaveTimer->stop();
+        m_captureCache->close();
+        qDebug() << "[Cache] Capture cache disabled";
+        return false;
     }
-
-    qDebug() << "[TCP] Socket error:" << errorString;
-    emit errorOccurred(errorString);
-
-    if (m_reconnectEnabled && m_reconnectAttempts < m_maxReconnectAttempts) {
-        m_reconnectTimer->setInterval(m_reconnectDelayMs);
-        m_reconnectTimer->start();
+    if (!m_captureCache->open(directory, maxBytes)) {
+        m_cacheSaveTimer->stop();
+        return false;
     }
+    m_cacheSaveTimer->start();
+    return true;
 }
 
-void TcpCommunicator::onConnectionTimeout()
-{
-    qDebug() << "[TCP] Connection timeout.";
-    m_socket->abort();
-    emit errorOccurred("Connection timed out.");
-}
-
-void TcpCommunicator::attemptReconnection()
+QFuture<TcpResponse> TcpCommunicator::requestFullImage(const QString &imageId)
 {
-    if (m_reconnectAttempts >= m_maxReconnectAttempts) {
-        qDebug() << "[TCP] Maximum reconnection attempts exceeded.";
-        emit errorOccurred("Exceeded maximum reconnection attempts.");
-        return;
-    }
-
-    m_reconnectAttempts++;
-    qDebug() << "[TCP] Reconnection attempt" << m_reconnectAttempts << "/" << m_maxReconnectAttempts;
+    QJsonObject data;
+    data["image_id"] = imageId;
 
-    emit statusUpdated(QString("Reconnecting... (%1/%2)").arg(m_reconnectAttempts).arg(m_maxReconnectAttempts));
+    QJsonObject message;
+    message["request_id"] = 24;
+    message["data"] = data;
 
-    m_connectionTimer->start();
-    m_socket->connectToHostEncrypted(m_host, static_cast<qint16>(m_port));
+    qDebug() << "[TCP] Full image request - image_id:" << imageId;
+    return request(message, 25);
 }
 
-void TcpCommunicator::onSslEncrypted() {
-    qDebug() << "[TCP] SSL encrypted connection established.";
-}
+QJsonObject TcpCommunicator::imageQueryData(const QString &date, int hour)
+{
+    QJsonObject data;
+    QString requestDate = date.isEmpty() ? QDate::currentDate().toString("yyyy-MM-dd") : date;
 
-void TcpCommunicator::onSslErrors(const QList<QSslError> &errors) {
-    qDebug() << "[TCP] SSL 오류 발생 - 총" << errors.size() << "개의 오류";
-    for (const auto &err : errors) {
-        qDebug() << "[TCP] SSL Error:" << err.errorString();
+    if (hour >= 0 && hour <= 23) {
+        data["start_timestamp"] = QString("%1T%2").arg(requestDate).arg(hour, 2, 10, QChar('0'));
+        data["end_timestamp"] = QString("%1T%2").arg(requestDate).arg(hour + 1, 2, 10, QChar('0'));
+    } else {
+        data["start_timestamp"] = requestDate + "T00";
+        data["end_timestamp"] = requestDate + "T23";
     }
-    
-    // 개발/테스트 환경에서는 SSL 오류를 무시하여 연결 진행
-    // 프로덕션 환경에서는 적절한 인증서를 설정해야 함
-    qDebug() << "[TCP] SSL 오류 무시하고 연결 계속 진행";
-    m_socket->ignoreSslErrors();
+    return data;
 }
 
-void TcpCommunicator::onSocketConnected()
+QJsonObject TcpCommunicator::imageQueryData(const QDateTime &start, const QDateTime &end)
 {
-    qDebug() << "[TCP] 소켓 연결 성공";
-
-    m_isConnected = true;
-    m_reconnectAttempts = 0;
-    stopReconnectTimer();
-
-    emit connected();
+    QJsonObject data;
+    data["start_timestamp"] = start.toString("yyyy-MM-ddTHH");
+    data["end_timestamp"] = end.toString("yyyy-MM-ddTHH");
+    return data;
 }
 
-void TcpCommunicator::onSocketDisconnected()
+void TcpCommunicator::imageQueryRange(const QString &date, int hour, QDateTime &start, QDateTime &end)
 {
-    qDebug() << "[TCP] 소켓 연결 해제";
-
-    m_isConnected = false;
-    emit disconnected();
-
-    // 자동 재연결 시도
-    if (m_autoReconnect && !m_host.isEmpty() && m_port > 0) {
-        startReconnectTimer();
+    // imageQueryData와 같은 범위 [start, end)
+    QDate requestDate = date.isEmpty() ? QDate::currentDate() : QDate::fromString(date, "yyyy-MM-dd");
+    if (hour >= 0 && hour <= 23) {
+        start = QDateTime(requestDate, QTime(hour, 0));
+        end = start.addSecs(3600);
+    } else {
+        start = QDateTime(requestDate, QTime(0, 0));
+        end = QDateTime(requestDate, QTime(23, 0));
     }
 }
 
-void TcpCommunicator::onSocketReadyRead()
+QString TcpCommunicator::captureCamera() const
 {
-    while (m_socket->canReadLine()) {
-        QByteArray data = m_socket->readLine();
-        QString message = QString::fromUtf8(data).trimmed();
-
-        if (!message.isEmpty()) {
-            qDebug() << "[TCP] 메시지 수신:" << message;
+    return CaptureCache::cameraKey(m_host, m_port);
+}
 
-            QJsonParseError error;
-            QJsonDocument jsonDoc = QJsonDocument::fromJson(data, &error);
+QFuture<TcpResponse> TcpCommunicator::cachedImagePage(const QString &camera, const QDateTime &start,
+                                                      const QDateTime &end, int pageSize, int offset)
+{
+    // pageSize가 0 이하면 나누지 않고 전체
+    QList<ImageData> images = m_captureCache->images(camera, start, end);
+    ImagePage page;
+    page.total = images.size();
+    offset = qBound(0, offset, int(images.size()));
+    int count = pageSize > 0 ? qMin<int>(pageSize, images.size() - offset) : images.size() - offset;
+    page.images = images.mid(offset, count);
+    if (offset + count < images.size()) {
+        page.nextCursor = CacheCursorPrefix + QString::number(offset + count);
+    }
+
+    emit imagesReceived(page.images);
+    emit statusUpdated(QString("Loaded %1 images.").arg(page.images.size()));
+
+    TcpResponse response;
+    response.responseId = 10;
+    response.payload = QVariant::fromValue(page);
+    return readyResponse(response);
+}
 
-            if (error.error == QJsonParseError::NoError && jsonDoc.isObject()) {
-                processJsonMessage(jsonDoc.object());
-            } else {
-                qDebug() << "[TCP] JSON 파싱 오류:" << error.errorString();
-                emit messageReceived(message);
-            }
+QFuture<TcpResponse> TcpCommunicator::markCompleteWhenDone(const QFuture<TcpResponse> &future, const QString &camera,
+                                                           const QDateTime &start, const QDateTime &end, bool firstPage)
+{
+    CaptureCache *cache = m_captureCache.get();
+    return future.then(this, [cache, camera, start, end, firstPage](const TcpResponse &response) {
+        ImagePage page = response.payload.value<ImagePage>();
+        if (!response.isOk() || page.hasMore()) {
+            return response;
         }
-    }
+        // 마지막 페이지 - 전체 개수를 모르면 한 번에 다 받은 경우만 (중간에 지워진 페이지를 확인할 수 없음)
+        int expected = page.total >= 0 ? page.total : (firstPage ? int(page.images.size()) : -1);
+        cache->markComplete(camera, start, end, expected);
+        return response;
+    });
 }
 
-void TcpCommunicator::onSocketError(QAbstractSocket::SocketError error)
+QFuture<TcpResponse> TcpCommunicator::sendImageQuery(const QJsonObject &data, const QString &description)
 {
-    QString errorString = m_socket->errorString();
-    qDebug() << "[TCP] 소켓 오류:" << error << "-" << errorString;
+    if (!isConnectedToServer()) {
+        qDebug() << "[TCP] Failed to request image data, no connection.";
+        emit errorOccurred("Not connected to server");
+    }
 
-    m_isConnected = false;
-    emit errorOccurred(errorString);
+    QJsonObject message;
+    message["request_id"] = 1;
+    message["data"] = data;
 
-    // 자동 재연결 시도 (연결 오류인 경우)
-    if (m_autoReconnect && !m_host.isEmpty() && m_port > 0) {
-        startReconnectTimer();
+    // 이미지 응답은 response_id 10
+    QFuture<TcpResponse> future = request(message, 10);
+    if (!future.isFinished()) {
+        qDebug() << "[TCP] Image request sent - request_id: 1," << description;
+        emit statusUpdated("Requesting images...");
+    } else if (isConnectedToServer()) {
+        qDebug() << "[TCP] Failed to request image data.";
+        emit errorOccurred("Failed to send image request");
     }
+    return future;
 }
 
-void TcpCommunicator::onReconnectTimer()
+void TcpCommunicator::setConnectionTimeout(int timeoutMs)
 {
-    if (m_reconnectAttempts >= m_maxReconnectAttempts) {
-        qDebug() << "[TCP] Maximum reconnection attempts exceeded.";
-        emit errorOccurred("Exceeded maximum reconnection attempts.");
-        return;
-    }
-
-    m_reconnectAttempts++;
-    qDebug() << "[TCP] Reconnection attempt" << m_reconnectAttempts << "/" << m_maxReconnectAttempts;
-
-    emit statusUpdated(QString("Reconnecting... (%1/%2)").arg(m_reconnectAttempts).arg(m_maxReconnectAttempts));
-
-    m_connectionTimer->start();
-    m_socket->connectToHostEncrypted(m_host, static_cast<qint16>(m_port));
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker, timeoutMs]() {
+        worker->setConnectionTimeout(timeoutMs);
+    }, Qt::QueuedConnection);
 }
 
-void TcpCommunicator::startReconnectTimer()
+void TcpCommunicator::setReconnectEnabled(bool enabled)
 {
-    if (!m_reconnectTimer->isActive() && m_reconnectAttempts < m_maxReconnectAttempts) {
-        qDebug() << "[TCP] 재연결 타이머 시작 (" << m_reconnectDelayMs << "ms 후)";
-        m_reconnectTimer->start();
-    }
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker, enabled]() {
+        worker->setReconnectEnabled(enabled);
+    }, Qt::QueuedConnection);
 }
 
-void TcpCommunicator::stopReconnectTimer()
+void TcpCommunicator::setStandbyConnectionEnabled(bool enabled)
 {
-    if (m_reconnectTimer->isActive()) {
-        qDebug() << "[TCP] 재연결 타이머 중지";
-        m_reconnectTimer->stop();
-    }
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker, enabled]() {
+        worker->setStandbyConnectionEnabled(enabled);
+    }, Qt::QueuedConnection);
 }
 
-void TcpCommunicator::processJsonMessage(const QJsonObject &jsonObj)
+void TcpCommunicator::setHeartbeatInterval(int intervalMs)
 {
-    // request_id 또는 response_id 확인 (서버 호환성)
-    int requestId = jsonObj["request_id"].toInt();
-    if (requestId == 0) {
-        requestId = jsonObj["response_id"].toInt();
-    }
-
-    qDebug() << "[TCP] JSON 메시지 처리 - request_id/response_id:" << requestId;
-
-    // 기타 응답 처리
-    switch (requestId) {
-    case 10: // 이미지 요청 응답
-        handleImagesResponse(jsonObj);
-        break;
-    case 12:
-        handleSavedDetectionLinesResponse(jsonObj);
-        handleDetectionLinesFromServer(jsonObj);
-        break;
-    case 16:
-        handleSavedRoadLinesResponse(jsonObj);
-        handleRoadLinesFromServer(jsonObj);
-        break;
-    case 200: // BBox 데이터 응답
-        handleBBoxResponse(jsonObj);
-        break;
-    default:
-        qDebug() << "[TCP] 알 수 없는 request_id:" << requestId;
-        QJsonDocument doc(jsonObj);
-        emit messageReceived(doc.toJson(QJsonDocument::Compact));
-        break;
-    }
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker, intervalMs]() {
+        worker->setHeartbeatInterval(intervalMs);
+    }, Qt::QueuedConnection);
 }
 
-// request_id 12: 감지선 데이터 처리 핸들러
-void TcpCommunicator::handleDetectionLinesFromServer(const QJsonObject &jsonObj)
-{
-    qDebug() << "[TCP] handleDetectionLinesFromServer 호출됨 (request_id: 12)";
-    QList<DetectionLineData> detectionLines;
-
-    if (jsonObj.contains("data") && jsonObj["data"].isArray()) {
-        QJsonArray dataArray = jsonObj["data"].toArray();
-        for (int i = 0; i < dataArray.size(); ++i) {
-            QJsonObject detectionLineObj = dataArray[i].toObject();
-            DetectionLineData detectionLine;
-            detectionLine.index = detectionLineObj["index"].toInt();
-            detectionLine.x1 = detectionLineObj["x1"].toInt();
-            detectionLine.y1 = detectionLineObj["y1"].toInt();
-            detectionLine.x2 = detectionLineObj["x2"].toInt();
-            detectionLine.y2 = detectionLineObj["y2"].toInt();
-            detectionLine.name = detectionLineObj["name"].toString();
-            detectionLine.mode = detectionLineObj["mode"].toString();
-            // detectionLine.leftMatrixNum = detectionLineObj["leftMatrixNum"].toInt();
-            // detectionLine.rightMatrixNum = detectionLineObj["rightMatrixNum"].toInt();
-            detectionLines.append(detectionLine);
-        }
-    }
-
-    // VideoGraphicsView 인스턴스에 감지선 데이터 전달
-    if (m_videoView) {
-        m_videoView->loadSavedDetectionLines(detectionLines);
-    } else {
-        qDebug() << "[TCP] m_videoView가 nullptr입니다. 감지선 데이터를 전달할 수 없습니다.";
-    }
+void TcpCommunicator::setMaxMissedPongs(int count)
+{
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker, count]() {
+        worker->setMaxMissedPongs(count);
+    }, Qt::QueuedConnection);
 }
 
-void TcpCommunicator::handleRoadLinesFromServer(const QJsonObject &jsonObj)
+void TcpCommunicator::startRecording(const QString &path)
 {
-    qDebug() << "[TCP] handleRoadLinesFromServer 호출됨 (request_id: 16)";
-    QList<RoadLineData> roadLines;
-
-    if (jsonObj.contains("data") && jsonObj["data"].isArray()) {
-        QJsonArray dataArray = jsonObj["data"].toArray();
-        for (int i = 0; i < dataArray.size(); ++i) {
-            QJsonObject roadLineObj = dataArray[i].toObject();
-            RoadLineData roadLine;
-            roadLine.index = roadLineObj["index"].toInt();
-            roadLine.x1 = roadLineObj["x1"].toInt();
-            roadLine.y1 = roadLineObj["y1"].toInt();
-            roadLine.x2 = roadLineObj["x2"].toInt();
-            roadLine.y2 = roadLineObj["y2"].toInt();
-            roadLine.matrixNum1 = roadLineObj["matrixNum1"].toInt();
-            roadLine.matrixNum2 = roadLineObj["matrixNum2"].toInt();
-            roadLines.append(roadLine);
-        }
-    }
-
-    // VideoGraphicsView 인스턴스에 감지선 데이터 전달
-    if (m_videoView) {
-        m_videoView->loadSavedRoadLines(roadLines);
-    } else {
-        qDebug() << "[TCP] m_videoView가 nullptr입니다. 도로기준선 데이터를 전달할 수 없습니다.";
-    }
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker, path]() {
+        worker->startRecording(path);
+    }, Qt::QueuedConnection);
 }
 
-QString TcpCommunicator::saveBase64Image(const QString &base64Data, const QString &timestamp)
+void TcpCommunicator::stopRecording()
 {
-    QString cleanBase64 = base64Data;
-    if (cleanBase64.contains(",")) {
-        cleanBase64 = cleanBase64.split(",").last();
-    }
-
-    QByteArray imageData = QByteArray::fromBase64(cleanBase64.toUtf8());
-
-    QString tempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
-    QString cleanTimestamp = timestamp;
-    cleanTimestamp.replace(":", "_").replace("-", "_");
-    QString fileName = QString("CCTVImage%1.jpg").arg(cleanTimestamp);
-    QString filePath = QDir(tempDir).absoluteFilePath(fileName);
-
-    QFile file(filePath);
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(imageData);
-        file.close();
-        qDebug() << "[TCP] Base64 image saved successfully:" << filePath;
-        return filePath;
-    } else {
-        qDebug() << "[TCP] Failed to save Base64 image:" << filePath;
-        return QString();
-    }
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker]() {
+        worker->stopRecording();
+    }, Qt::QueuedConnection);
 }
 
-void TcpCommunicator::handleImagesResponse(const QJsonObject &jsonObj)
+void TcpCommunicator::startReplay(const QString &path, bool realTime)
 {
-    qDebug() << "[TCP] Processing image response...";
-
-    if (!jsonObj.contains("data")) {
-        qDebug() << "[TCP] 'data' field not found in response.";
-        emit errorOccurred("The 'data' field is missing in the server response.");
-        return;
-    }
-
-    QJsonArray dataArray = jsonObj["data"].toArray();
-    qDebug() << "[TCP] Size of data array:" << dataArray.size();
-
-    QList<ImageData> images;
-
-    for (int i = 0; i < dataArray.size(); ++i) {
-        QJsonValue value = dataArray[i];
-        if (!value.isObject()) {
-            qDebug() << "[TCP] data[" << i << "] is not an object.";
-            continue;
-        }
-
-        QJsonObject imageObj = value.toObject();
-
-        if (!imageObj.contains("image") || !imageObj.contains("timestamp")) {
-            qDebug() << "[TCP] Image object[" << i << "] is missing required fields.";
-            continue;
-        }
-
-        ImageData imageData;
-        QString base64Image = imageObj["image"].toString();
-        imageData.timestamp = imageObj["timestamp"].toString();
-
-        imageData.imagePath = saveBase64Image(base64Image, imageData.timestamp);
-        imageData.logText = QString("Detection time: %1").arg(imageData.timestamp);
-        imageData.detectionType = "vehicle";
-        imageData.direction = "unknown";
-
-        if (!imageData.imagePath.isEmpty()) {
-            images.append(imageData);
-        }
-    }
-
-    qDebug() << "[TCP] Number of parsed images:" << images.size();
-    emit imagesReceived(images);
-    emit statusUpdated(QString("Loaded %1 images.").arg(images.size()));
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker, path, realTime]() {
+        worker->startReplay(path, realTime);
+    }, Qt::QueuedConnection);
 }
 
-void TcpCommunicator::handleCoordinatesResponse(const QJsonObject &jsonObj)
+void TcpCommunicator::stopReplay()
 {
-    bool success = jsonObj["success"].toBool();
-    QString message = jsonObj["message"].toString();
-
-    qDebug() << "[TCP] Coordinates response - Success:" << success << "Message:" << message;
-    emit coordinatesConfirmed(success, message);
-
-    if (success) {
-        emit statusUpdated("Coordinates sent successfully");
-    } else {
-        emit errorOccurred("Failed to send coordinates: " + message);
-    }
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker]() {
+        worker->stopReplay();
+    }, Qt::QueuedConnection);
 }
 
-void TcpCommunicator::handleDetectionLineResponse(const QJsonObject &jsonObj)
+void TcpCommunicator::setMaxFrameSize(qint64 bytes)
 {
-    bool success = true;
-    QString message = "Detection line setup complete";
-
-    if (jsonObj.contains("success")) {
-        success = jsonObj["success"].toBool();
-    }
-
-    if (jsonObj.contains("message")) {
-        message = jsonObj["message"].toString();
-    }
-
-    // Extract additional information from the data field
-    if (jsonObj.contains("data") && jsonObj["data"].isObject()) {
-        QJsonObject data = jsonObj["data"].toObject();
-        int index = data["index"].toInt();
-        QString name = data["name"].toString();
-        QString mode = data["mode"].toString();
-
-        qDebug() << "[TCP] Detection line response - index:" << index
-                 << "name:" << name << "mode:" << mode << "Success:" << success;
-
-        message = QString("Detection line '%1' (index: %2, mode: %3) setup %4")
-                      .arg(name).arg(index).arg(mode).arg(success ? "succeeded" : "failed");
-    }
-
-    emit detectionLineConfirmed(success, message);
-
-    if (success) {
-        emit statusUpdated("Detection line setup complete");
-    } else {
-        emit errorOccurred("Failed to set up detection line: " + message);
-    }
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker, bytes]() {
+        worker->setMaxFrameSize(bytes);
+    }, Qt::QueuedConnection);
 }
 
-void TcpCommunicator::handleRoadLineResponse(const QJsonObject &jsonObj)
+void TcpCommunicator::setMaxFrameSize(int responseId, qint64 bytes)
 {
-    bool success = true;
-    QString message = "Road line setup complete";
-
-    if (jsonObj.contains("success")) {
-        success = jsonObj["success"].toBool();
-    }
-
-    if (jsonObj.contains("message")) {
-        message = jsonObj["message"].toString();
-    }
-
-    if (jsonObj.contains("data") && jsonObj["data"].isObject()) {
-        QJsonObject data = jsonObj["data"].toObject();
-        int index = data["index"].toInt();
-        int matrixNum1 = data["matrixNum1"].toInt();
-        int x1 = data["x1"].toInt();
-        int y1 = data["y1"].toInt();
-        int matrixNum2 = data["matrixNum2"].toInt();
-        int x2 = data["x2"].toInt();
-        int y2 = data["y2"].toInt();
-
-        qDebug() << "[TCP] Road line response - index:" << index
-                 << "start:(" << x1 << "," << y1 << ") matrix:" << matrixNum1
-                 << "end:(" << x2 << "," << y2 << ") matrix:" << matrixNum2
-                 << "Success:" << success;
-
-        message = QString("Road line #%1 (start:(%2,%3) Matrix:%4, end:(%5,%6) Matrix:%7) setup %8")
-                      .arg(index).arg(x1).arg(y1).arg(matrixNum1)
-                      .arg(x2).arg(y2).arg(matrixNum2)
-                      .arg(success ? "succeeded" : "failed");
-    }
-
-    emit roadLineConfirmed(success, message);
-
-    if (success) {
-        emit statusUpdated("Road line setup complete");
-    } else {
-        emit errorOccurred("Failed to set up road line: " + message);
-    }
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker, responseId, bytes]() {
+        worker->setMaxFrameSizeForType(responseId, bytes);
+    }, Qt::QueuedConnection);
 }
 
-void TcpCommunicator::handlePerpendicularLineResponse(const QJsonObject &jsonObj)
+void TcpCommunicator::setLargeFrameThreshold(qint64 bytes)
 {
-    bool success = true;
-    QString message = "수직선 설정 완료";
-
-    if (jsonObj.contains("success")) {
-        success = jsonObj["success"].toBool();
-    }
-
-    if (jsonObj.contains("message")) {
-        message = jsonObj["message"].toString();
-    }
-
-    // data 필드에서 추가 정보 추출
-    if (jsonObj.contains("data") && jsonObj["data"].isObject()) {
-        QJsonObject data = jsonObj["data"].toObject();
-        int index = data["index"].toInt();
-        double a = data["a"].toDouble();
-        double b = data["b"].toDouble();
-
-        qDebug() << "[TCP] 수직선 응답 - index:" << index
-                 << "y = " << a << "x + " << b << "성공:" << success;
-
-        message = QString("수직선 (index: %1, y = %2x + %3) 설정 %4")
-                      .arg(index).arg(a).arg(b).arg(success ? "성공" : "실패");
-    }
-
-    emit perpendicularLineConfirmed(success, message);
-
-    if (success) {
-        emit statusUpdated("수직선 설정 완료");
-    } else {
-        emit errorOccurred("수직선 설정 실패: " + message);
-    }
+    NetworkWorker *worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker, bytes]() {
+        worker->setLargeFrameThreshold(bytes);
+    }, Qt::QueuedConnection);
 }
 
-// 저장된 도로선 데이터 응답 처리 함수 (request_id: 7)
-void TcpCommunicator::handleSavedRoadLinesResponse(const QJsonObject &jsonObj)
+void TcpCommunicator::onWorkerConnected()
 {
-    qDebug() << "[TCP] 저장된 도로선 데이터 응답 처리 중... (request_id: 7)";
-    qDebug() << "[TCP] Full JSON:" << QJsonDocument(jsonObj).toJson(QJsonDocument::Compact);
-
-    m_receivedRoadLines.clear();
-
-    if (jsonObj.contains("data") && jsonObj["data"].isArray()) {
-        QJsonArray dataArray = jsonObj["data"].toArray();
-
-        for (int i = 0; i < dataArray.size(); ++i) {
-            QJsonObject roadLineObj = dataArray[i].toObject();
-
-            RoadLineData roadLine;
-            roadLine.index = roadLineObj["index"].toInt();
-            roadLine.matrixNum1 = roadLineObj["matrixNum1"].toInt();
-            roadLine.x1 = roadLineObj["x1"].toInt();
-            roadLine.y1 = roadLineObj["y1"].toInt();
-            roadLine.matrixNum2 = roadLineObj["matrixNum2"].toInt();
-            roadLine.x2 = roadLineObj["x2"].toInt();
-            roadLine.y2 = roadLineObj["y2"].toInt();
-
-            m_receivedRoadLines.append(roadLine);
-
-            qDebug() << "[TCP] 도로선 로드됨 - index:" << roadLine.index
-                     << "start:(" << roadLine.x1 << "," << roadLine.y1 << ") matrix:" << roadLine.matrixNum1
-                     << "end:(" << roadLine.x2 << "," << roadLine.y2 << ") matrix:" << roadLine.matrixNum2;
-        }
-    }
-
-    qDebug() << "[TCP] 저장된 도로선 데이터 로드 완료 - 도로선:" << m_receivedRoadLines.size() << "개";
-
-    m_roadLinesReceived = true;
-    emit savedRoadLinesReceived(m_receivedRoadLines);
-
+    m_isConnected = true;
+    emit connected();
 }
 
-// 저장된 감지선 데이터 응답 처리 함수 (request_id: 3)
-void TcpCommunicator::handleSavedDetectionLinesResponse(const QJsonObject &jsonObj)
+void TcpCommunicator::onWorkerDisconnected()
 {
-    qDebug() << "[TCP] 저장된 감지선 데이터 응답 처리 중... (request_id: 3)";
-    qDebug() << "[TCP] Full JSON:" << QJsonDocument(jsonObj).toJson(QJsonDocument::Compact);
-
-    m_receivedDetectionLines.clear();
-
-    if (jsonObj.contains("data") && jsonObj["data"].isArray()) {
-        QJsonArray dataArray = jsonObj["data"].toArray();
-
-        for (int i = 0; i < dataArray.size(); ++i) {
-            QJsonObject detectionLineObj = dataArray[i].toObject();
+    m_isConnected = false;
+    m_serverCapabilities.clear();
+
+    // 보조 연결은 주 연결의 세션에 묶여 있으므로 함께 정리
+    m_sessionId.clear();
+    m_bulkUnavailable = false;
+    closeBulkChannel();
+    fallBackToPrimary();
+    m_rttMs = -1;
+    m_jitterMs = -1;
+    failAllRequests(TcpResponse::Disconnected);
+    emit disconnected();
+}
 
-            DetectionLineData detectionLine;
-            detectionLine.index = detectionLineObj["index"].toInt();
-            detectionLine.x1 = detectionLineObj["x1"].toInt();
-            detectionLine.y1 = detectionLineObj["y1"].toInt();
-            detectionLine.x2 = detectionLineObj["x2"].toInt();
-            detectionLine.y2 = detectionLineObj["y2"].toInt();
-            detectionLine.name = detectionLineObj["name"].toString();
-            detectionLine.mode = detectionLineObj["mode"].toString();
+void TcpCommunicator::onWorkerRttUpdated(int rttMs, int jitterMs)
+{
+    m_rttMs = rttMs;
+    m_jitterMs = jitterMs;
+    emit rttUpdated(rttMs, jitterMs);
+}
 
-            m_receivedDetectionLines.append(detectionLine);
+void TcpCommunicator::onWorkerStateChanged(ConnectionState state)
+{
+    m_connectionState = state;
+    emit connectionStateChanged(state);
+}
 
-            qDebug() << "[TCP] 감지선 로드됨 - index:" << detectionLine.index
-                     << "name:" << detectionLine.name << "mode:" << detectionLine.mode
-                     << "좌표:(" << detectionLine.x1 << "," << detectionLine.y1 << ") → ("
-                     << detectionLine.x2 << "," << detectionLine.y2 << ")";
+void TcpCommunicator::onWorkerMessageSent(quint64 messageId, bool success)
+{
+    if (!success) {
+        for (qsizetype i = 0; i < m_inFlight.size(); ++i) {
+            if (m_inFlight[i].seq == messageId) {
+                finishRequest(i, TcpResponse::SendFailed);
+                armInFlightTimer();
+                break;
+            }
         }
     }
 
-    qDebug() << "[TCP] 저장된 감지선 데이터 로드 완료 - 감지선:" << m_receivedDetectionLines.size() << "개";
+    auto it = m_pendingLineSends.find(messageId);
+    if (it == m_pendingLineSends.end()) {
+        return;
+    }
 
-    m_detectionLinesReceived = true;
-    emit savedDetectionLinesReceived(m_receivedDetectionLines);
+    LineUploadResult result = it.value();
+    m_pendingLineSends.erase(it);
+    result.success = success;
+    result.message = success ? QString("Sent, not confirmed by server")
+                             : QString("Connection lost before the line was sent");
+    m_lineSendResults.append(result);
 
+    // 개별 전송한 선이 모두 끝나면 한 번에 결과 전달
+    if (m_pendingLineSends.isEmpty()) {
+        QList<LineUploadResult> results = m_lineSendResults;
+        m_lineSendResults.clear();
+        emit lineBatchResult(results);
+    }
 }
 
-void TcpCommunicator::handleCategorizedCoordinatesResponse(const QJsonObject &jsonObj)
+void TcpCommunicator::onServerCapabilitiesReceived(const QStringList &capabilities, const QString &sessionId)
 {
-    bool success = jsonObj["success"].toBool();
-    QString message = jsonObj["message"].toString();
-
-    qDebug() << "[TCP] Categorized coordinates response - Success:" << success << "Message:" << message;
-
-    if (jsonObj.contains("data") && jsonObj["data"].isObject()) {
-        QJsonObject data = jsonObj["data"].toObject();
-        int roadLinesProcessed = data["road_lines_processed"].toInt();
-        int detectionLinesProcessed = data["detection_lines_processed"].toInt();
-        int totalProcessed = data["total_processed"].toInt();
-
-        qDebug() << "[TCP] Processed coordinates - Road lines:" << roadLinesProcessed << "items, Detection lines:" << detectionLinesProcessed << "items, Total:" << totalProcessed << "items";
-
-        emit categorizedCoordinatesConfirmed(success, message, roadLinesProcessed, detectionLinesProcessed);
-    } else {
-        emit categorizedCoordinatesConfirmed(success, message, 0, 0);
-    }
-
-    if (success) {
-        emit statusUpdated("Categorized coordinates sent successfully");
-    } else {
-        emit errorOccurred("Failed to send categorized coordinates: " + message);
-    }
+    qDebug() << "[TCP] 서버 지원 기능:" << capabilities;
+    m_serverCapabilities = capabilities;
+    m_sessionId = sessionId;
 }
 
-void TcpCommunicator::handleStatusUpdate(const QJsonObject &jsonObj)
+// request_id 12: 감지선 데이터 처리 핸들러
+void TcpCommunicator::handleDetectionLinesFromServer(const QList<DetectionLineData> &detectionLines)
 {
-    QString status = jsonObj["status"].toString();
-    QString message = jsonObj["message"].toString();
-
-    qDebug() << "[TCP] Status update - Status:" << status << "Message:" << message;
-    emit statusUpdated(message.isEmpty() ? status : message);
+    // VideoGraphicsView 인스턴스에 감지선 데이터 전달
+    if (m_videoView) {
+        m_videoView->loadSavedDetectionLines(detectionLines);
+    } else {
+        qDebug() << "[TCP] m_videoView가 nullptr입니다. 감지선 데이터를 전달할 수 없습니다.";
+    }
 }
 
-void TcpCommunicator::handleErrorResponse(const QJsonObject &jsonObj)
+void TcpCommunicator::handleRoadLinesFromServer(const QList<RoadLineData> &roadLines)
 {
-    QString errorMsg = jsonObj["message"].toString("Unknown error");
-    QString errorCode = jsonObj["error_code"].toString();
-
-    qDebug() << "[TCP] Server error - Code:" << errorCode << "Message:" << errorMsg;
-    emit errorOccurred(errorMsg);
+    // VideoGraphicsView 인스턴스에 감지선 데이터 전달
+    if (m_videoView) {
+        m_videoView->loadSavedRoadLines(roadLines);
+    } else {
+        qDebug() << "[TCP] m_videoView가 nullptr입니다. 도로기준선 데이터를 전달할 수 없습니다.";
+    }
 }
 
 QJsonObject TcpCommunicator::createBaseMessage(const QString &type) const
@@ -1275,62 +1641,3 @@ MessageType TcpCommunicator::stringToMessageType(const QString &typeStr) const
     if (typeStr == "error_response") return MessageType::ERROR_RESPONSE;
     return MessageType::ERROR_RESPONSE; // Default
 }
-
-void TcpCommunicator::logJsonMessage(const QJsonObject &jsonObj, bool outgoing) const
-{
-    QString direction = outgoing ? "Sent" : "Received";
-    int requestId = jsonObj["request_id"].toInt();
-
-    qDebug() << QString("[TCP] JSON %1 - request_id: %2").arg(direction).arg(requestId);
-
-// Only print full JSON in debug mode
-#ifdef QT_DEBUG
-    QJsonDocument doc(jsonObj);
-    qDebug() << "JSON Content:" << doc.toJson(QJsonDocument::Compact);
-#endif
-}
-
-void TcpCommunicator::setupSocket()
-{
-    // 소켓 설정이 필요한 경우 여기에 구현
-}
-
-// BBox 데이터 처리 함수
-void TcpCommunicator::handleBBoxResponse(const QJsonObject &jsonObj)
-{
-    qDebug() << "[TCP] handleBBoxResponse 호출됨 (response_id: 200)";
-    
-    QList<BBox> bboxes;
-    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
-    
-    if (jsonObj.contains("bboxes") && jsonObj["bboxes"].isArray()) {
-        QJsonArray bboxArray = jsonObj["bboxes"].toArray();
-        
-        for (int i = 0; i < bboxArray.size(); ++i) {
-            QJsonObject bboxObj = bboxArray[i].toObject();
-            
-            BBox bbox;
-            bbox.object_id = bboxObj["id"].toInt();
-            bbox.type = bboxObj["type"].toString();
-            bbox.confidence = bboxObj["confidence"].toDouble();
-            bbox.rect = QRect(
-                bboxObj["x"].toInt(),
-                bboxObj["y"].toInt(),
-                bboxObj["width"].toInt(),
-                bboxObj["height"].toInt()
-            );
-            
-            bboxes.append(bbox);
-        }
-    }
-    
-    // 타임스탬프가 JSON에 포함되어 있다면 사용
-    if (jsonObj.contains("timestamp")) {
-        timestamp = jsonObj["timestamp"].toVariant().toLongLong();
-    }
-    
-    qDebug() << QString("[TCP] BBox 데이터 파싱 완료 - 총 %1개 객체").arg(bboxes.size());
-    
-    // BBox 데이터를 시그널로 전달
-    emit bboxesReceived(bboxes, timestamp);
-}
@@ -10,13 +10,29 @@
 #include <QDateTime>
 #include <QThread>
 #include <QRect>
+#include <QSize>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <QFuture>
+#include <QPromise>
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QVariant>
+#include <memory>
 
 #include <QSslSocket>
 #include <QSslError>
 #include <QSslConfiguration>
 
+#include "BBoxFrame.h"
+#include "MessageDispatcher.h"
+#include "NetworkMetrics.h"
+
 // Forward declarations
 class VideoGraphicsView;
+class NetworkWorker;
+class CaptureCache;
 
 
 // 메시지 타입 열거형
@@ -31,13 +47,26 @@ enum class MessageType {
 
 // 이미지 데이터 구조체
 struct ImageData {
-    QString imagePath;
+    QString imagePath;          // 원본 (썸네일만 받은 경우 비어 있고, 클릭할 때 imageId로 받아 옴)
+    QString thumbnailPath;      // 그리드용 축소 이미지 (없으면 imagePath 사용)
+    QString imageId;            // 서버의 이미지 ID (원본 요청 request_id 24에 사용)
     QString timestamp;
     QString logText;
     QString detectionType;
     QString direction;
 };
 
+// 캡처 이미지 조회 결과 한 페이지 (response_id 10, 원본 요청 응답 25도 같은 형식)
+// nextCursor는 서버가 주는 불투명한 값으로 다음 페이지 요청에 그대로 돌려주며, 비어 있으면 마지막 페이지다.
+// 페이지를 모르는 서버는 nextCursor 없이 전체를 한 번에 보낸다.
+struct ImagePage {
+    QList<ImageData> images;
+    QString nextCursor;
+    int total = -1;         // 조건에 맞는 전체 이미지 수 (서버가 알려 준 경우만)
+
+    bool hasMore() const { return !nextCursor.isEmpty(); }
+};
+
 // 객체 탐지선 데이터 구조체
 struct DetectionLineData {
     int index;              // 선 인덱스
@@ -55,14 +84,6 @@ struct PerpendicularLineData {
     double b;               // y = ax + b에서 b값 (y절편)
 };
 
-// BBox 데이터 구조체
-struct BBox {
-    int object_id;          // 객체 ID
-    QString type;           // 객체 타입 (예: "Vehicle", "Person" 등)
-    double confidence;      // 신뢰도 (0.0 ~ 1.0)
-    QRect rect;            // 바운딩 박스 영역 (x, y, width, height)
-};
-
 // 서버 양식에 맞춘 도로 기준선 데이터 구조체 수정
 struct RoadLineData {
     int index;              // 기준선 번호
@@ -80,6 +101,71 @@ struct CategorizedLineData {
     int y2;
 };
 
+// 선 일괄 업로드 결과 (선 하나당 하나)
+struct LineUploadResult {
+    QString kind;           // "road", "detection", "perpendicular"
+    int index;              // 선 번호
+    bool success;
+    QString message;
+    bool confirmed = false; // 서버 응답(41)으로 확인된 결과 (개별 전송은 보낸 것까지만 알 수 있음)
+};
+
+// 요청에 대한 응답 (TcpCommunicator::request가 돌려주는 future의 결과)
+struct TcpResponse {
+    enum Status {
+        Ok,
+        Timeout,            // 기한 안에 응답 없음
+        Cancelled,          // cancelRequest 또는 future.cancel()
+        Disconnected,       // 응답 전에 연결 끊김
+        SendFailed          // 연결이 없어 보내지 못함
+    };
+
+    Status status = Ok;
+    int responseId = 0;
+    QVariant payload;       // 10/25: ImagePage, 12: QList<DetectionLineData>, 16: QList<RoadLineData>,
+                            // 41: QList<LineUploadResult>, 그 외: QJsonObject
+
+    bool isOk() const { return status == Ok; }
+};
+
+// 서버 연결 상태 (NetworkWorker의 상태 머신)
+enum class ConnectionState {
+    Idle,                   // 연결 없음 (재연결 대기 포함)
+    Resolving,              // 호스트 이름 조회
+    Connecting,             // TCP 연결 중
+    TlsHandshake,           // TLS 협상 중
+    Authenticated,          // 협상 완료, 메시지 송수신 가능
+    Draining                // 사용자 요청으로 남은 송신 데이터를 보내고 종료 중
+};
+
+// 송신 우선순위 (레인). 높은 레인의 메시지는 메시지 경계에서 낮은 레인보다 먼저 나간다.
+enum class MessagePriority {
+    Control,                // 로그인/OTP, BBox on/off, hello, 하트비트
+    Interactive,            // 그 밖의 작은 요청 (저장된 선 조회 등)
+    Bulk                    // 선 업로드, 이미지 조회
+};
+
+// 송신 레인별 지표
+struct OutboundLaneMetrics {
+    int queuedMessages = 0;         // 아직 소켓에 넘기지 않은 메시지 수
+    qint64 queuedBytes = 0;
+    quint64 sentMessages = 0;
+    qint64 lastWaitMs = 0;          // 큐에 들어와서 소켓에 넘어가기까지 기다린 시간
+    qint64 maxWaitMs = 0;
+    double averageWaitMs = 0.0;     // 지수 평활 평균
+};
+
+// 스레드 간(Queued) 시그널 전달을 위한 메타타입 등록
+Q_DECLARE_METATYPE(ImageData)
+Q_DECLARE_METATYPE(ImagePage)
+Q_DECLARE_METATYPE(DetectionLineData)
+Q_DECLARE_METATYPE(RoadLineData)
+Q_DECLARE_METATYPE(LineUploadResult)
+Q_DECLARE_METATYPE(ConnectionState)
+Q_DECLARE_METATYPE(OutboundLaneMetrics)
+
+// GUI 스레드에서 사용하는 TCP 통신 인터페이스
+// 실제 소켓 I/O와 메시지 파싱은 전용 네트워크 스레드의 NetworkWorker가 담당한다.
 class TcpCommunicator : public QObject
 {
     Q_OBJECT
@@ -92,11 +178,35 @@ public:
     void connectToServer(const QString &host, quint16 port);
     void disconnectFromServer();
     bool isConnectedToServer() const;
+    ConnectionState connectionState() const { return m_connectionState; }
+    // 하트비트로 측정한 최근 왕복 시간과 지터 (측정 전이거나 서버가 지원하지 않으면 -1)
+    int rttMs() const { return m_rttMs; }
+    int jitterMs() const { return m_jitterMs; }
 
     // 메시지 전송
-    bool sendJsonMessage(const QJsonObject &message);
+    // 전송 큐에 넣고 바로 반환. messageId를 주면 할당된 ID를 돌려주고 완료 시 messageSent로 알림
+    // 우선순위는 request_id로 정함 (priorityFor)
+    bool sendJsonMessage(const QJsonObject &message, quint64 *messageId = nullptr);
+    static MessagePriority priorityFor(int requestId);
+    // 대용량 응답을 받는 요청 - 서버가 "bulk_channel"을 지원하면 보조 연결로 보냄
+    static bool usesBulkChannel(int requestId);
+    OutboundLaneMetrics outboundLaneMetrics(MessagePriority lane) const;
+
+    // 메시지 타입별 송수신/처리 시간 통계 (진단 창과 주기적 JSON 스냅샷)
+    const NetworkMetrics &networkMetrics() const { return m_metrics; }
+    void resetNetworkMetrics();
+    QJsonObject metricsSnapshot() const;
+    // intervalMs마다 스냅샷을 path에 덮어씀 (빈 경로면 중지)
+    void setMetricsSnapshotFile(const QString &path, int intervalMs = 10000);
     bool sendMessage(const QString &message);
 
+    // 응답을 기다리는 요청 - 모든 메시지에는 seq(상관 ID)가 붙고, 응답/타임아웃/취소 시 future가 완료됨
+    static constexpr int DefaultRequestTimeoutMs = 30000;
+    QFuture<TcpResponse> request(const QJsonObject &message, int responseId,
+                                 int timeoutMs = DefaultRequestTimeoutMs, quint64 *seq = nullptr);
+    void cancelRequest(quint64 seq);
+    int pendingRequestCount() const { return m_inFlight.size(); }
+
     // 데이터 전송 메서드들
     bool sendLineCoordinates(int x1, int y1, int x2, int y2);
     bool sendDetectionLine(const DetectionLineData &lineData);
@@ -106,27 +216,85 @@ public:
     bool sendRoadLine(const RoadLineData &lineData);
     bool sendMultipleRoadLines(const QList<RoadLineData> &roadLines);
     bool sendPerpendicularLine(const PerpendicularLineData &lineData);
+
+    // 도로선/감지선/수직선을 한 번에 업로드 (결과는 lineBatchResult로 선마다 전달)
+    // 서버가 "line_batch"를 지원하면 하나의 메시지(request_id 40), 아니면 대기 없이 연속 전송
+    // (개별 저장에는 서버 응답이 없으므로 그 경우 success는 전송 완료, confirmed는 false)
+    bool sendLineBatch(const QList<RoadLineData> &roadLines,
+                       const QList<DetectionLineData> &detectionLines,
+                       const QList<PerpendicularLineData> &perpendicularLines = QList<PerpendicularLineData>());
+    bool serverSupports(const QString &capability) const;
     void requestImageData(const QString &date = QString(), int hour = -1);
+    QFuture<TcpResponse> requestImages(const QString &date = QString(), int hour = -1);
+    // 페이지 단위 조회 (첫 페이지는 cursor 없이, 이후는 이전 응답의 nextCursor로) / 개수만 조회
+    QFuture<TcpResponse> requestImagePage(const QString &date, int hour, int pageSize,
+                                          const QString &cursor = QString());
+    QFuture<TcpResponse> requestImageCount(const QString &date = QString(), int hour = -1);
+    // 캡처 이미지 디스크 캐시 (빈 경로면 앱 데이터 위치) - 열려 있으면 이미 다 받은 지난 시간대는
+    // 서버에 묻지 않고 캐시에서 돌려주고, 일부만 있으면 빠진 시간대만 요청한다
+    bool openCaptureCache(const QString &directory, qint64 maxBytes);
+    CaptureCache *captureCache() const { return m_captureCache.get(); }
+
+    // 그리드 썸네일 크기 - 서버가 "thumbnails"를 지원하면 조회 응답이 이 크기의 썸네일로 오고,
+    // 아니면 받은 원본으로 네트워크 스레드에서 만듦 (빈 크기면 썸네일 없이 원본만)
+    void setThumbnailSize(const QSize &size);
+    // 썸네일만 받은 이미지의 원본 (request_id 24 → response_id 25, payload는 이미지 1장의 ImagePage)
+    QFuture<TcpResponse> requestFullImage(const QString &imageId);
 
     // 저장된 선 데이터 요청
     bool requestSavedRoadLines();
     bool requestSavedDetectionLines();
     bool requestDeleteLines();
+    QFuture<TcpResponse> fetchSavedRoadLines();
+    QFuture<TcpResponse> fetchSavedDetectionLines();
 
     // 설정
     void setConnectionTimeout(int timeoutMs);
     void setReconnectEnabled(bool enabled);
+    void setStandbyConnectionEnabled(bool enabled);
+    // 하트비트 ping(60) 간격 (0이면 끔)과 끊긴 것으로 판단할 연속 pong 누락 횟수
+    void setHeartbeatInterval(int intervalMs);
+    void setMaxMissedPongs(int count);
+
+    // 송수신 프레임을 파일로 기록 / 기록 파일을 같은 디코딩·전달 경로로 재생 (연결되지 않은 상태에서만)
+    // realTime이 false면 기록된 간격을 무시하고 최대한 빨리 재생 (파싱·렌더링 프로파일링용)
+    void startRecording(const QString &path);
+    void stopRecording();
+    void startReplay(const QString &path, bool realTime = true);
+    void stopReplay();
+
+    // 수신 프레임 크기 제한 (기본값 / 응답 타입별). 초과 시 오류를 알리고 연결을 끊음
+    void setMaxFrameSize(qint64 bytes);
+    void setMaxFrameSize(int responseId, qint64 bytes);
+    // 이 크기를 넘는 응답은 메모리 대신 임시 파일로 받아 처리
+    void setLargeFrameThreshold(qint64 bytes);
     void setVideoView(VideoGraphicsView* videoView);
 
+    // 응답 타입별 구독 (응답은 네트워크 스레드에서 한 번만 디코딩되어 모든 구독자에게 전달됨)
+    // 예: subscribe<QList<RoadLineData>>(16, this, [](const QList<RoadLineData> &lines) { ... });
+    template <typename T, typename Func>
+    int subscribe(int responseId, QObject *context, Func func)
+    {
+        return m_dispatcher.subscribe<T>(responseId, context, std::move(func));
+    }
+    void unsubscribe(int subscriptionId) { m_dispatcher.unsubscribe(subscriptionId); }
+
 signals:
     void connected();
     void disconnected();
+    void connectionStateChanged(ConnectionState state);
+    void reconnected(qint64 outageMs);     // 끊긴 뒤 복구까지 걸린 시간
+    void rttUpdated(int rttMs, int jitterMs);
+    void outboundMetricsUpdated();
+    void replayFinished(qint64 frames, qint64 elapsedMs);
     void errorOccurred(const QString &error);
     void messageReceived(const QString &message);
-    void imagesReceived(const QList<ImageData> &images);
+    void imagesReceived(const QList<ImageData> &images);   // 캐시와 서버에서 나눠 받으면 여러 번
     void coordinatesConfirmed(bool success, const QString &message);
     void detectionLineConfirmed(bool success, const QString &message);
     void statusUpdated(const QString &status);
+    void messageSent(quint64 messageId, bool success);
+    void lineBatchResult(const QList<LineUploadResult> &results);
 
     // signals 섹션에 시그널 추가
     void roadLineConfirmed(bool success, const QString &message);
@@ -137,90 +305,127 @@ signals:
     void categorizedCoordinatesConfirmed(bool success, const QString &message, int roadLinesProcessed, int detectionLinesProcessed);
 
     // BBox 관련 시그널
-    void bboxesReceived(const QList<BBox> &bboxes, qint64 timestamp);
+    void bboxFrameReceived(const BBoxFrameSnapshot &frame);
 
 
 private slots:
-    void onConnected();
-    void onDisconnected();
-    void onReadyRead();
-    void onError(QAbstractSocket::SocketError error);
-
-    void onConnectionTimeout();
-    void attemptReconnection();
-    void onSslEncrypted();
-    void onSslErrors(const QList<QSslError> &errors);
-
-    void onSocketConnected();
-    void onSocketDisconnected();
-    void onSocketReadyRead();
-    void onSocketError(QAbstractSocket::SocketError error);
-    void onReconnectTimer();
+    void onWorkerConnected();
+    void onWorkerDisconnected();
+    void onWorkerStateChanged(ConnectionState state);
+    void onWorkerRttUpdated(int rttMs, int jitterMs);
+    void onWorkerOutboundMetrics(const QList<OutboundLaneMetrics> &lanes);
+    void onWorkerMessageSent(quint64 messageId, bool success);
+    void onLineBatchResult(const QList<LineUploadResult> &results);
+    void onServerCapabilitiesReceived(const QStringList &capabilities, const QString &sessionId);
+    void onBulkChannelReady(const QStringList &capabilities, const QString &sessionId);
+    void onBulkChannelLost();
+    void onBulkIdleTimeout();
+    void onWorkerResponse(int responseId, quint64 seq, const QVariant &payload);
+    void onInFlightTimer();
+    void onWorkerBBoxFrame(const BBoxFrameSnapshot &frame);
+    void writeMetricsSnapshot();
 
 private:
-    // JSON 메시지 처리
-    void processJsonMessage(const QJsonObject &jsonObj);
-    void handleImagesResponse(const QJsonObject &jsonObj);
-    void handleCoordinatesResponse(const QJsonObject &jsonObj);
-    void handleDetectionLineResponse(const QJsonObject &jsonObj);
-    void handleCategorizedCoordinatesResponse(const QJsonObject &jsonObj);
-    void handleStatusUpdate(const QJsonObject &jsonObj);
-    void handleErrorResponse(const QJsonObject &jsonObj);
-
-    // Base64 이미지 처리 함수 추가
-    QString saveBase64Image(const QString &base64Data, const QString &timestamp);
+    // 서버에서 받은 저장된 선 데이터를 VideoGraphicsView에 반영 (12/16 구독자)
+    void handleDetectionLinesFromServer(const QList<DetectionLineData> &detectionLines);
+    void handleRoadLinesFromServer(const QList<RoadLineData> &roadLines);
+
+    // 이미지 조회 요청 (request_id 1) 공통 부분
+    static QJsonObject imageQueryData(const QString &date, int hour);
+    static QJsonObject imageQueryData(const QDateTime &start, const QDateTime &end);
+    static void imageQueryRange(const QString &date, int hour, QDateTime &start, QDateTime &end);
+    QFuture<TcpResponse> sendImageQuery(const QJsonObject &data, const QString &description);
+
+    // 캡처 캐시 (카메라는 접속한 서버 주소)
+    QString captureCamera() const;
+    QFuture<TcpResponse> cachedImagePage(const QString &camera, const QDateTime &start, const QDateTime &end,
+                                         int pageSize, int offset);
+    // 응답이 범위 전체를 담고 있으면 캐시에 그 시간대를 완전하다고 기록
+    QFuture<TcpResponse> markCompleteWhenDone(const QFuture<TcpResponse> &future, const QString &camera,
+                                              const QDateTime &start, const QDateTime &end, bool firstPage);
 
     // 유틸리티 함수
     QJsonObject createBaseMessage(const QString &type) const;
     QString messageTypeToString(MessageType type) const;
     MessageType stringToMessageType(const QString &typeStr) const;
-    void logJsonMessage(const QJsonObject &jsonObj, bool outgoing) const;
-    void setupSocket();
-    void startReconnectTimer();
-    void stopReconnectTimer();
-
-    // 네트워크 관련
-    QSslSocket *m_socket;
-    QTimer *m_connectionTimer;
-    QTimer *m_reconnectTimer;
+
+    // 대용량 전송 보조 연결
+    void sendOnBulkChannel(const QJsonObject &framed, quint64 id, MessagePriority priority);
+    void ensureBulkChannel();
+    void closeBulkChannel();
+    void fallBackToPrimary();
+
+    // 진행 중 요청 관리
+    void finishRequest(qsizetype index, TcpResponse::Status status, const QVariant &payload = QVariant());
+    void failAllRequests(TcpResponse::Status status);
+    void armInFlightTimer();
+
+    // 네트워크 스레드
+    QThread *m_networkThread;
+    NetworkWorker *m_worker;
+
+    // 연결 상태 (워커의 connected/disconnected 시그널로 갱신되는 GUI 측 사본)
     QString m_host;
     quint16 m_port;
     bool m_isConnected;
-    QString m_receivedData;
-
-    bool m_autoReconnect;
+    ConnectionState m_connectionState;
+    int m_rttMs;
+    int m_jitterMs;
+    QList<OutboundLaneMetrics> m_laneMetrics;
+    quint64 m_nextMessageId;
+    QStringList m_serverCapabilities;
+    QSize m_thumbnailSize;          // 워커에 전달하는 그리드 썸네일 크기 (보조 연결을 만들 때도 전달)
+
+    // 일괄 지원이 없는 서버에 선을 개별 전송할 때의 결과 수집
+    QHash<quint64, LineUploadResult> m_pendingLineSends;
+    QList<LineUploadResult> m_lineSendResults;
+    bool m_categorizedUploadPending;    // sendCategorizedLineCoordinates 결과를 lineBatchResult로 기다리는 중
+
+    // 응답을 기다리는 요청 (보낸 순서 유지 - seq를 돌려주지 않는 서버는 응답 타입 순서로 매칭)
+    struct PendingRequest {
+        quint64 seq;
+        int requestId;
+        int responseId;
+        QElapsedTimer sentAt;           // 응답 지연 통계용
+        QDeadlineTimer deadline;
+        std::shared_ptr<QPromise<TcpResponse>> promise;
+    };
+    QList<PendingRequest> m_inFlight;
+    QTimer *m_inFlightTimer;
+
+    MessageDispatcher m_dispatcher;
+
+    // 메시지 타입별 통계 (두 연결의 워커가 각자의 스레드에서 함께 기록)
+    NetworkMetrics m_metrics;
+    QElapsedTimer m_metricsClock;
+    QTimer *m_metricsTimer;
+    QString m_metricsFile;
+
+    // 캡처 이미지 캐시 (워커가 네트워크/보조 스레드에서 저장/등록, GUI 스레드에서 조회)
+    // 목록(index.dat)은 바뀐 경우에만 주기적으로, 그리고 닫을 때 저장
+    static constexpr int CacheSaveIntervalMs = 30000;
+    std::unique_ptr<CaptureCache> m_captureCache;
+    QTimer *m_cacheSaveTimer;
+
+    // 대용량 전송 전용 보조 연결 (전용 스레드, 처음 필요할 때 생성하고 유휴 시 끊음)
+    // 이미지 응답의 수신과 처리가 주 연결의 BBox 스트림과 디코딩을 막지 않도록 분리한다.
+    struct BulkMessage {
+        QJsonObject message;
+        quint64 id;
+        MessagePriority priority;
+    };
+    static constexpr int BulkIdleTimeoutMs = 60000;
+    QThread *m_bulkThread;
+    NetworkWorker *m_bulkWorker;
+    bool m_bulkReady;               // 세션에 붙어 메시지를 보낼 수 있음
+    bool m_bulkUnavailable;         // 이번 세션에서 붙기에 실패 → 주 연결 사용
+    QList<BulkMessage> m_bulkPending;   // 보조 연결 준비 전에 들어온 메시지
+    QSet<quint64> m_bulkSeqs;       // 보조 연결로 보낸 요청 (끊기면 실패 처리)
+    QTimer *m_bulkIdleTimer;
+    QString m_sessionId;            // 주 연결의 서버 세션 ID (hello 응답)
+    QByteArray m_sessionTicket;     // 주 연결의 TLS 세션 티켓 (보조 연결에서 재개)
 
     VideoGraphicsView *m_videoView;
-
-    // 설정
-    int m_connectionTimeoutMs;
-    bool m_reconnectEnabled;
-    int m_reconnectAttempts;
-    int m_maxReconnectAttempts;
-    int m_reconnectDelayMs;
-
-    // private 섹션에 함수 선언 추가
-    void handleRoadLineResponse(const QJsonObject &jsonObj);
-    void handlePerpendicularLineResponse(const QJsonObject &jsonObj);
-    void setupSslConfiguration();
-
-    // 저장된 선 데이터 응답 처리 함수들
-    void handleSavedRoadLinesResponse(const QJsonObject &jsonObj);
-    void handleSavedDetectionLinesResponse(const QJsonObject &jsonObj);
-
-    void handleDetectionLinesFromServer(const QJsonObject &jsonObj);
-    void handleRoadLinesFromServer(const QJsonObject &jsonObj);
-
-    // BBox 처리 함수
-    void handleBBoxResponse(const QJsonObject &jsonObj);
-
-    // 저장된 선 데이터 관리
-    QList<RoadLineData> m_receivedRoadLines;
-    QList<DetectionLineData> m_receivedDetectionLines;
-    bool m_roadLinesReceived;
-    bool m_detectionLinesReceived;
-
-    void checkAndEmitAllLinesReceived();
 };
 
 #endif // TCPCOMMUNICATOR_H
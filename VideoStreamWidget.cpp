@@ -1,4 +1,6 @@
 #include "VideoStreamWidget.h"
+#include "Logging.h"
+#include "EventLoopWatchdog.h"
 #include "custommessagebox.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -193,7 +195,8 @@ void VideoStreamWidget::mousePressEvent(QMouseEvent *event)
 
 void VideoStreamWidget::onMediaStatusChanged(QMediaPlayer::MediaStatus status)
 {
-    qDebug() << "미디어 상태 변경:" << status;
+    WATCHDOG_SCOPE("VideoStreamWidget::onMediaStatusChanged");
+    qCDebug(lcVideo) << "미디어 상태 변경:" << status;
     
     switch (status) {
     case QMediaPlayer::LoadingMedia:
@@ -224,7 +227,7 @@ void VideoStreamWidget::onMediaStatusChanged(QMediaPlayer::MediaStatus status)
         m_liveIndicator->setVisible(true);
         m_liveBlinkTimer->start();
         m_reconnectAttempts = 0;
-        qDebug() << "버퍼링 완료 - 스트림 재생 시작";
+        qCDebug(lcVideo) << "버퍼링 완료 - 스트림 재생 시작";
         break;
         
     case QMediaPlayer::EndOfMedia:
@@ -247,7 +250,7 @@ void VideoStreamWidget::onMediaStatusChanged(QMediaPlayer::MediaStatus status)
 
 void VideoStreamWidget::onPlaybackStateChanged(QMediaPlayer::PlaybackState state)
 {
-    qDebug() << "재생 상태 변경:" << state;
+    qCDebug(lcVideo) << "재생 상태 변경:" << state;
     
     switch (state) {
     case QMediaPlayer::PlayingState:
@@ -268,6 +271,7 @@ void VideoStreamWidget::onPlaybackStateChanged(QMediaPlayer::PlaybackState state
 
 void VideoStreamWidget::onErrorOccurred(QMediaPlayer::Error error, const QString &errorString)
 {
+    WATCHDOG_SCOPE("VideoStreamWidget::onErrorOccurred");
     qDebug() << "미디어 플레이어 에러:" << error << errorString;
     
     QString errorMsg;
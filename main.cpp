@@ -6,11 +6,18 @@
 #include "LoginWindow.h"
 #include "MainWindow.h"
 #include "TcpCommunicator.h"
+#include "EnvConfig.h"
+#include "Logging.h"
+#include "EventLoopWatchdog.h"
 
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
 
+    // 로그는 전용 스레드에서 출력 (QApplication 종료 시 남은 로그를 모두 쓰고 정리)
+    AsyncLogSink::install();
+    qAddPostRoutine(AsyncLogSink::shutdown);
+
     // 애플리케이션 아이콘 설정
     QIcon app_icon(":/icons/CCTV.png");
     app.setWindowIcon(app_icon);
@@ -61,6 +68,33 @@ int main(int argc, char *argv[])
     // LoginWindow에 공유 TcpCommunicator 설정
     loginWindow.setTcpCommunicator(sharedTcpCommunicator);
 
+    // 로그 카테고리 규칙(LOG_RULES)과 로그 파일(LOG_FILE)
+    AsyncLogSink::applyRules(EnvConfig::getValue("LOG_RULES"));
+    AsyncLogSink::setLogFile(EnvConfig::getValue("LOG_FILE"));
+
+    // GUI 이벤트 루프 멈춤 감시 (GUI_WATCHDOG_THRESHOLD_MS 이상 멈추면 기록, 0이면 끔)
+    int watchdogThresholdMs = EnvConfig::getIntValue("GUI_WATCHDOG_THRESHOLD_MS", 100);
+    EventLoopWatchdog watchdog(watchdogThresholdMs);
+    if (watchdogThresholdMs > 0) {
+        watchdog.start();
+    }
+
+    // .env의 TCP_STANDBY_CONNECTION=true면 예비 연결을 유지해 장애 시 바로 교체 (LoginWindow가 .env 로드)
+    sharedTcpCommunicator->setStandbyConnectionEnabled(EnvConfig::getBoolValue("TCP_STANDBY_CONNECTION", false));
+    // 하트비트 간격 (TCP_HEARTBEAT_INTERVAL_MS, 0이면 끔)
+    sharedTcpCommunicator->setHeartbeatInterval(EnvConfig::getIntValue("TCP_HEARTBEAT_INTERVAL_MS", 5000));
+    // TCP_RECORD_FILE이 있으면 송수신 프레임을 기록 (현장 문제 재현용)
+    QString recordFile = EnvConfig::getValue("TCP_RECORD_FILE");
+    if (!recordFile.isEmpty()) {
+        sharedTcpCommunicator->startRecording(recordFile);
+    }
+    // TCP_METRICS_FILE이 있으면 메시지 타입별 통계를 주기적으로 JSON으로 저장
+    sharedTcpCommunicator->setMetricsSnapshotFile(EnvConfig::getValue("TCP_METRICS_FILE"),
+                                                  EnvConfig::getIntValue("TCP_METRICS_INTERVAL_MS", 10000));
+    // 조회한 캡처 이미지 디스크 캐시 (CAPTURE_CACHE_DIR 없으면 앱 데이터 위치, CAPTURE_CACHE_MAX_MB=0이면 끔)
+    sharedTcpCommunicator->openCaptureCache(EnvConfig::getValue("CAPTURE_CACHE_DIR"),
+                                            qint64(EnvConfig::getIntValue("CAPTURE_CACHE_MAX_MB", 1024)) * 1024 * 1024);
+
     // 로그인 성공 시 메인 창으로 전환
     QObject::connect(&loginWindow, &LoginWindow::loginSuccessful, [&]() {
         qDebug() << "로그인 성공 - 메인 창 표시";
@@ -81,7 +115,10 @@ int main(int argc, char *argv[])
     // 로그인 창 표시
     if (loginWindow.exec() == QDialog::Accepted) {
         qDebug() << "로그인 다이얼로그가 성공적으로 완료되었습니다.";
-        return app.exec();
+        int result = app.exec();
+        // 이벤트 루프가 끝난 뒤 네트워크 스레드를 정리 (기록 파일 마무리, 통계/캐시 목록 저장)
+        delete sharedTcpCommunicator;
+        return result;
     } else {
         qDebug() << "로그인이 취소되었습니다.";
         delete sharedTcpCommunicator; // 로그인 실패 시 정리
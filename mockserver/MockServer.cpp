@@ -0,0 +1,135 @@
+#include "MockServer.h"
+#include "MockSession.h"
+#include <QDebug>
+#include <QFile>
+#include <QBuffer>
+#include <QImage>
+#include <QSslConfiguration>
+#include <QSslCertificate>
+#include <QSslKey>
+
+MockServer::MockServer(const MockServerConfig &config, QObject *parent)
+    : QObject(parent)
+    , m_config(config)
+    , m_nextSession(0)
+{
+    connect(&m_server, &QSslServer::pendingConnectionAvailable, this, &MockServer::onPendingConnection);
+    connect(&m_server, &QSslServer::errorOccurred, this, [](QSslSocket *, QAbstractSocket::SocketError error) {
+        qDebug() << "[Mock] Socket error during handshake:" << error;
+    });
+}
+
+bool MockServer::start()
+{
+    QFile certificateFile(m_config.certificatePath);
+    QFile keyFile(m_config.keyPath);
+    if (!certificateFile.open(QIODevice::ReadOnly) || !keyFile.open(QIODevice::ReadOnly)) {
+        qDebug() << "[Mock] Certificate or key not found:" << m_config.certificatePath << m_config.keyPath;
+        qDebug() << "[Mock] Run make-cert.sh to create a throwaway certificate.";
+        return false;
+    }
+
+    QSslConfiguration sslConfiguration = QSslConfiguration::defaultConfiguration();
+    sslConfiguration.setLocalCertificate(QSslCertificate(&certificateFile, QSsl::Pem));
+    sslConfiguration.setPrivateKey(QSslKey(&keyFile, QSsl::Rsa, QSsl::Pem));
+    sslConfiguration.setPeerVerifyMode(QSslSocket::VerifyNone);
+    m_server.setSslConfiguration(sslConfiguration);
+
+    if (!m_server.listen(QHostAddress::Any, m_config.port)) {
+        qDebug() << "[Mock] Failed to listen on port" << m_config.port << "-" << m_server.errorString();
+        return false;
+    }
+
+    qDebug() << "[Mock] Listening on port" << m_config.port
+             << "bbox:" << m_config.bboxRate << "fps x" << m_config.bboxObjects << "objects"
+             << "encoding:" << (m_config.cbor ? "cbor" : "json")
+             << "compression:" << (m_config.compression ? "zlib" : "none")
+             << "attachments:" << m_config.attachments;
+    return true;
+}
+
+void MockServer::onPendingConnection()
+{
+    while (m_server.hasPendingConnections()) {
+        QSslSocket *socket = qobject_cast<QSslSocket *>(m_server.nextPendingConnection());
+        if (!socket) {
+            continue;
+        }
+        qDebug() << "[Mock] Client connected:" << socket->peerAddress().toString() << socket->peerPort();
+        new MockSession(socket, this);
+    }
+}
+
+void MockServer::clearLines()
+{
+    m_roadLines.clear();
+    m_detectionLines.clear();
+    m_perpendicularLines.clear();
+}
+
+QString MockServer::createSession()
+{
+    QString sessionId = QString("mock-%1").arg(++m_nextSession);
+    m_sessions.insert(sessionId);
+    return sessionId;
+}
+
+void MockServer::setAuthenticated(const QString &sessionId)
+{
+    if (m_sessions.contains(sessionId)) {
+        m_authenticated.insert(sessionId);
+    }
+}
+
+QByteArray MockServer::imageJpeg()
+{
+    if (!m_imageJpeg.isEmpty()) {
+        return m_imageJpeg;
+    }
+
+    // 그라데이션 이미지 (실제 캡처와 비슷한 크기의 JPEG이 되도록)
+    int width = qMax(16, m_config.imageWidth);
+    int height = width * 9 / 16;
+    QImage image(width, height, QImage::Format_RGB32);
+    for (int y = 0; y < height; ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < width; ++x) {
+            line[x] = qRgb((x * 255) / width, (y * 255) / height, ((x ^ y) & 0xFF));
+        }
+    }
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    if (!image.save(&buffer, "JPG", 80)) {
+        image.save(&buffer, "PNG");
+    }
+    m_imageJpeg = buffer.data();
+    qDebug() << "[Mock] Synthetic image:" << width << "x" << height << "-" << buffer.size() << "bytes";
+    return m_imageJpeg;
+}
+
+QByteArray MockServer::thumbnailJpeg(const QSize &size)
+{
+    if (size == m_thumbnailSize && !m_thumbnailJpeg.isEmpty()) {
+        return m_thumbnailJpeg;
+    }
+
+    QImage image = QImage::fromData(imageJpeg());
+    QImage thumbnail = image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    thumbnail.save(&buffer, "JPG", 80);
+    m_thumbnailSize = size;
+    m_thumbnailJpeg = buffer.data();
+    qDebug() << "[Mock] Thumbnail:" << thumbnail.width() << "x" << thumbnail.height() << "-" << buffer.size() << "bytes";
+    return m_thumbnailJpeg;
+}
+
+QByteArray MockServer::imageBase64()
+{
+    if (m_imageBase64.isEmpty()) {
+        m_imageBase64 = imageJpeg().toBase64();
+    }
+    return m_imageBase64;
+}
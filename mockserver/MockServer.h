@@ -0,0 +1,85 @@
+#ifndef MOCKSERVER_H
+#define MOCKSERVER_H
+
+#include <QObject>
+#include <QSslServer>
+#include <QJsonObject>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QSize>
+
+// 목 서버 설정 (명령줄 옵션으로 지정)
+struct MockServerConfig {
+    quint16 port = 8080;
+    QString certificatePath = "mockserver.crt";
+    QString keyPath = "mockserver.key";
+
+    int bboxRate = 10;              // BBox 프레임 전송 빈도 (초당)
+    int bboxObjects = 5;            // 프레임당 객체 수
+    int bboxPadding = 0;            // 프레임마다 덧붙이는 바이트 (페이로드 크기 조절)
+    int imageCount = 20;            // 이미지 조회 응답의 이미지 수
+    int imageWidth = 640;           // 합성 JPEG 크기 (높이는 16:9)
+
+    bool requireOtp = false;        // 로그인 후 OTP(22) 단계를 요구
+    bool cbor = false;              // hello에서 CBOR 인코딩 선택
+    bool compression = false;       // hello에서 zlib 프레임 압축 선택
+    bool attachments = false;       // 클라이언트가 지원하면 이미지를 첨부 프레임(바이너리)으로 보냄
+    bool heartbeat = true;          // hello에서 "heartbeat" 지원을 알림
+    bool thumbnails = true;         // hello에서 "thumbnails" 지원을 알림 (조회 응답에 썸네일, 원본은 24→25)
+
+    int dropAfterSeconds = 0;       // 0이 아니면 접속 후 이 시간이 지나면 강제로 끊음 (재연결 측정)
+    int stallAfterSeconds = 0;      // 0이 아니면 이 시간이 지나면 연결은 둔 채 응답을 멈춤 (반쯤 열린 연결)
+    quint32 seed = 42;              // 합성 데이터 난수 시드 (같은 시드면 같은 데이터)
+};
+
+// 실제 서버의 TCP 프로토콜을 흉내 내는 로컬 서버
+// DB, 카메라, 도트 매트릭스 없이 클라이언트의 처리량/지연/재연결 동작을 재현하기 위한 것으로,
+// 선 데이터와 세션은 메모리에만 보관한다.
+class MockServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MockServer(const MockServerConfig &config, QObject *parent = nullptr);
+
+    bool start();
+    const MockServerConfig &config() const { return m_config; }
+
+    // 저장된 선 (index → 선 JSON)
+    QMap<int, QJsonObject> &roadLines() { return m_roadLines; }
+    QMap<int, QJsonObject> &detectionLines() { return m_detectionLines; }
+    QMap<int, QJsonObject> &perpendicularLines() { return m_perpendicularLines; }
+    void clearLines();
+
+    // 세션 (hello 시 발급, 로그인 성공 시 인증됨 → 보조 연결이 같은 세션에 붙을 수 있음)
+    QString createSession();
+    bool hasSession(const QString &sessionId) const { return m_sessions.contains(sessionId); }
+    void setAuthenticated(const QString &sessionId);
+    bool isAuthenticated(const QString &sessionId) const { return m_authenticated.contains(sessionId); }
+
+    // 합성 이미지 (한 번 만들어 재사용)
+    QByteArray imageJpeg();
+    QByteArray imageBase64();
+    // 요청한 크기 안에 들어가게 줄인 JPEG (마지막으로 요청된 크기만 보관)
+    QByteArray thumbnailJpeg(const QSize &size);
+
+private slots:
+    void onPendingConnection();
+
+private:
+    MockServerConfig m_config;
+    QSslServer m_server;
+    QMap<int, QJsonObject> m_roadLines;
+    QMap<int, QJsonObject> m_detectionLines;
+    QMap<int, QJsonObject> m_perpendicularLines;
+    QSet<QString> m_sessions;
+    QSet<QString> m_authenticated;
+    quint64 m_nextSession;
+    QByteArray m_imageJpeg;
+    QByteArray m_imageBase64;
+    QSize m_thumbnailSize;
+    QByteArray m_thumbnailJpeg;
+};
+
+#endif // MOCKSERVER_H
@@ -0,0 +1,543 @@
+#include "MockSession.h"
+#include "MockServer.h"
+#include <QDebug>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QCborValue>
+#include <QtEndian>
+
+MockSession::MockSession(QSslSocket *socket, MockServer *server)
+    : QObject(server)
+    , m_socket(socket)
+    , m_server(server)
+    , m_bboxTimer(new QTimer(this))
+    , m_random(server->config().seed)
+    , m_useCbor(false)
+    , m_useCompression(false)
+    , m_useAttachments(false)
+    , m_stalled(false)
+    , m_framesSent(0)
+    , m_bytesSent(0)
+    , m_bboxFramesSent(0)
+{
+    m_socket->setParent(this);
+    m_connectedTimer.start();
+
+    connect(m_socket, &QSslSocket::readyRead, this, &MockSession::onReadyRead);
+    connect(m_socket, &QSslSocket::disconnected, this, &MockSession::onDisconnected);
+
+    const MockServerConfig &config = m_server->config();
+    m_bboxTimer->setInterval(1000 / qMax(1, config.bboxRate));
+    connect(m_bboxTimer, &QTimer::timeout, this, &MockSession::onBBoxTimer);
+
+    // 재연결 측정: 정해진 시간 뒤 강제로 끊음
+    if (config.dropAfterSeconds > 0) {
+        QTimer::singleShot(config.dropAfterSeconds * 1000, this, [this]() {
+            qDebug() << "[Mock] Dropping connection (--drop-after)";
+            m_socket->abort();
+        });
+    }
+
+    // 하트비트 측정: 연결은 유지한 채 아무것도 보내지 않음
+    if (config.stallAfterSeconds > 0) {
+        QTimer::singleShot(config.stallAfterSeconds * 1000, this, [this]() {
+            qDebug() << "[Mock] Stalling connection (--stall-after)";
+            m_stalled = true;
+            m_bboxTimer->stop();
+        });
+    }
+
+    // 이미 버퍼에 들어온 데이터가 있을 수 있음
+    if (m_socket->bytesAvailable() > 0) {
+        QTimer::singleShot(0, this, &MockSession::onReadyRead);
+    }
+}
+
+MockSession::~MockSession()
+{
+}
+
+void MockSession::onReadyRead()
+{
+    if (m_stalled) {
+        return;
+    }
+
+    while (m_socket->bytesAvailable() > 0) {
+        if (m_decoder.readFrom(m_socket) < 0) {
+            break;
+        }
+
+        QByteArrayView frame;
+        while (m_decoder.nextFrame(frame)) {
+            QByteArray payload;
+            if (m_decoder.lastFrameSpilled()) {
+                payload = m_decoder.spilledFrame()->readAll();
+            } else {
+                payload = frame.toByteArray();
+            }
+            if (m_decoder.lastFrameCompressed()) {
+                payload = qUncompress(payload);
+            }
+
+            // 클라이언트는 합의 후 CBOR로 보낼 수 있음 (첫 바이트로 구분)
+            QJsonObject message;
+            if (!payload.isEmpty() && (static_cast<uchar>(payload.front()) & 0xE0) == 0xA0) {
+                message = QCborValue::fromCbor(payload).toJsonValue().toObject();
+            } else {
+                message = QJsonDocument::fromJson(payload).object();
+            }
+
+            if (message.isEmpty()) {
+                qDebug() << "[Mock] Unreadable frame:" << payload.left(80);
+                continue;
+            }
+            handleMessage(message);
+        }
+
+        if (m_decoder.hasError()) {
+            qDebug() << "[Mock] Frame error:" << m_decoder.errorString();
+            m_socket->abort();
+            return;
+        }
+    }
+}
+
+void MockSession::onDisconnected()
+{
+    qDebug() << "[Mock] Client disconnected after" << m_connectedTimer.elapsed() << "ms"
+             << "- frames:" << m_framesSent << "bytes:" << m_bytesSent << "bbox frames:" << m_bboxFramesSent;
+    m_bboxTimer->stop();
+    deleteLater();
+}
+
+void MockSession::handleMessage(const QJsonObject &message)
+{
+    int requestId = message["request_id"].toInt();
+
+    switch (requestId) {
+    case 50:
+        handleHello(message);
+        break;
+    case 60: // 하트비트
+        send(QJsonObject{ { "response_id", 61 }, { "ping_id", message["ping_id"] } }, message);
+        break;
+    case 8:
+        handleLogin(message);
+        break;
+    case 9:
+        handleSignUp(message);
+        break;
+    case 22:
+        handleOtpLogin(message);
+        break;
+    case 1:
+        handleImages(message);
+        break;
+    case 24:
+        handleFullImage(message);
+        break;
+    case 3:
+        handleSavedLines(message, false);
+        break;
+    case 7:
+        handleSavedLines(message, true);
+        break;
+    case 2:
+    case 5:
+    case 6:
+        handleUpsert(message);
+        break;
+    case 40:
+        handleLineBatch(message);
+        break;
+    case 4:
+        handleDelete(message);
+        break;
+    case 31:
+        setBBoxStreaming(true);
+        break;
+    case 32:
+        setBBoxStreaming(false);
+        break;
+    default:
+        qDebug() << "[Mock] Unhandled request_id:" << requestId;
+        break;
+    }
+}
+
+void MockSession::send(QJsonObject message, const QJsonObject &request)
+{
+    if (m_stalled || m_socket->state() != QAbstractSocket::ConnectedState) {
+        return;
+    }
+
+    // 클라이언트가 보낸 상관 ID를 그대로 돌려줌
+    if (request.contains("seq")) {
+        message["seq"] = request["seq"];
+    }
+
+    QByteArray payload = m_useCbor ? QCborValue::fromJsonValue(message).toCbor()
+                                   : QJsonDocument(message).toJson(QJsonDocument::Compact);
+
+    quint32 header = static_cast<quint32>(payload.size());
+    if (m_useCompression && payload.size() >= 1024) {
+        QByteArray compressed = qCompress(payload, 6);
+        if (compressed.size() < payload.size()) {
+            payload = compressed;
+            header = static_cast<quint32>(payload.size()) | FrameDecoder::CompressedFlag;
+        }
+    }
+
+    writeFrame(header, payload);
+}
+
+void MockSession::sendAttachments(QJsonObject header, const QList<QByteArray> &blobs, const QJsonObject &request)
+{
+    if (m_stalled || m_socket->state() != QAbstractSocket::ConnectedState) {
+        return;
+    }
+
+    if (request.contains("seq")) {
+        header["seq"] = request["seq"];
+    }
+
+    // 블롭은 이어 붙인 순서대로 offset 지정 (JPEG은 압축해도 줄지 않으므로 압축하지 않음)
+    QJsonArray entries = header["data"].toArray();
+    qint64 offset = 0;
+    for (int i = 0; i < entries.size() && i < blobs.size(); ++i) {
+        QJsonObject entry = entries[i].toObject();
+        entry["offset"] = offset;
+        entry["length"] = qint64(blobs[i].size());
+        entries[i] = entry;
+        offset += blobs[i].size();
+    }
+    header["data"] = entries;
+
+    QByteArray headerData = m_useCbor ? QCborValue::fromJsonValue(header).toCbor()
+                                      : QJsonDocument(header).toJson(QJsonDocument::Compact);
+
+    QByteArray payload;
+    payload.reserve(FrameDecoder::AttachmentHeaderPrefixSize + headerData.size() + offset);
+    char headerSize[FrameDecoder::AttachmentHeaderPrefixSize];
+    qToBigEndian(static_cast<quint32>(headerData.size()), headerSize);
+    payload.append(headerSize, sizeof(headerSize));
+    payload.append(headerData);
+    for (const QByteArray &blob : blobs) {
+        payload.append(blob);
+    }
+
+    writeFrame(static_cast<quint32>(payload.size()) | FrameDecoder::AttachmentFlag, payload);
+}
+
+void MockSession::writeFrame(quint32 header, const QByteArray &payload)
+{
+    char headerBytes[4];
+    qToBigEndian(header, headerBytes);
+    m_socket->write(headerBytes, sizeof(headerBytes));
+    m_socket->write(payload);
+
+    m_framesSent++;
+    m_bytesSent += sizeof(headerBytes) + payload.size();
+}
+
+void MockSession::handleHello(const QJsonObject &request)
+{
+    const MockServerConfig &config = m_server->config();
+
+    // 보조 연결은 기존 세션에 붙음 (인증 상태를 이어받음)
+    QString requested = request["session_id"].toString();
+    if (request["channel"].toString() == "bulk" && m_server->hasSession(requested)) {
+        m_sessionId = requested;
+        qDebug() << "[Mock] Bulk channel attached to" << m_sessionId;
+    } else {
+        m_sessionId = m_server->createSession();
+    }
+
+    QJsonArray capabilities{ "line_batch", "bulk_channel" };
+    if (config.heartbeat) {
+        capabilities.append("heartbeat");
+    }
+    if (config.thumbnails) {
+        capabilities.append("thumbnails");
+    }
+    bool attachments = config.attachments && request["capabilities"].toArray().contains(QJsonValue("attachments"));
+    if (attachments) {
+        capabilities.append("attachments");
+    }
+
+    QJsonObject response{
+        { "response_id", 51 },
+        { "capabilities", capabilities },
+        { "encoding", config.cbor ? "cbor" : "json" },
+        { "compression", config.compression ? "zlib" : "none" },
+        { "session_id", m_sessionId },
+    };
+    send(response, request);
+
+    // 응답을 보낸 뒤부터 합의한 형식 사용
+    m_useCbor = config.cbor;
+    m_useCompression = config.compression;
+    m_decoder.setCompressionEnabled(config.compression);
+    m_useAttachments = attachments;
+}
+
+void MockSession::handleLogin(const QJsonObject &request)
+{
+    QJsonObject data = request["data"].toObject();
+    QString id = data["id"].toString();
+    bool success = !id.isEmpty() && !data["passwd"].toString().isEmpty();
+    bool requiresOtp = success && m_server->config().requireOtp;
+
+    if (success && !requiresOtp) {
+        m_server->setAuthenticated(m_sessionId);
+    }
+    if (requiresOtp) {
+        m_pendingOtpUser = id;
+    }
+
+    send(QJsonObject{
+             { "request_id", 19 },
+             { "step1_success", success ? 1 : 0 },
+             { "requires_otp", requiresOtp ? 1 : 0 },
+             { "message", success ? "Login succeeded" : "Invalid id or password" },
+         }, request);
+}
+
+void MockSession::handleOtpLogin(const QJsonObject &request)
+{
+    QJsonObject data = request["data"].toObject();
+
+    // 6자리 숫자면 통과 (실제 TOTP 검증은 하지 않음)
+    QString input = data["input"].toString();
+    bool success = !m_pendingOtpUser.isEmpty() && data["id"].toString() == m_pendingOtpUser
+                   && input.size() == 6 && input.toInt() >= 0;
+    if (success) {
+        m_server->setAuthenticated(m_sessionId);
+        m_pendingOtpUser.clear();
+    }
+
+    send(QJsonObject{
+             { "request_id", 23 },
+             { "final_login_success", success ? 1 : 0 },
+             { "message", success ? "OTP verified" : "Invalid OTP" },
+         }, request);
+}
+
+void MockSession::handleSignUp(const QJsonObject &request)
+{
+    QJsonObject data = request["data"].toObject();
+    bool useOtp = data["use_otp"].toBool();
+
+    QJsonObject response{
+        { "request_id", 20 },
+        { "sign_up_success", data["id"].toString().isEmpty() ? 0 : 1 },
+        { "message", "Signed up" },
+        { "otp_uri", useOtp ? QString("otpauth://totp/CCTV:%1?secret=MOCKSECRET").arg(data["id"].toString()) : QString() },
+    };
+    if (useOtp) {
+        response["qr_code_svg"] = "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"8\" height=\"8\"/>";
+        response["recovery_codes"] = QJsonArray{ "mock-0001", "mock-0002", "mock-0003" };
+    }
+    send(response, request);
+}
+
+void MockSession::handleImages(const QJsonObject &request)
+{
+    const MockServerConfig &config = m_server->config();
+    QJsonObject data = request["data"].toObject();
+
+    // 요청한 시간대의 시작 (이미지는 그 안에서 고르게 분포)
+    QDateTime start = QDateTime::fromString(data["start_timestamp"].toString(), "yyyy-MM-ddTHH");
+    if (!start.isValid()) {
+        start = QDateTime(QDate::currentDate(), QTime(0, 0));
+    }
+
+    int total = qMax(0, config.imageCount);
+    if (data["count_only"].toBool()) {
+        send(QJsonObject{ { "response_id", 10 }, { "total", total } }, request);
+        return;
+    }
+
+    // 페이지 조회: cursor는 다음 이미지 위치를 감춘 값 (클라이언트는 그대로 돌려줌)
+    int pageSize = data["page_size"].toInt();
+    int first = QByteArray::fromBase64(data["cursor"].toString().toLatin1()).toInt();
+    first = qBound(0, first, total);
+    int last = pageSize > 0 ? qMin(total, first + pageSize) : total;
+
+    // 썸네일을 요청했으면 원본 대신 줄인 이미지 (원본은 image_id로 24 요청)
+    QJsonArray thumbnailSize = data["thumbnail_size"].toArray();
+    bool thumbnail = config.thumbnails && thumbnailSize.size() == 2;
+    QByteArray jpeg = thumbnail ? m_server->thumbnailJpeg(QSize(thumbnailSize[0].toInt(), thumbnailSize[1].toInt()))
+                                : m_server->imageJpeg();
+
+    // 첨부 프레임을 합의했으면 JPEG을 base64 없이 그대로 붙임
+    QJsonArray images;
+    QList<QByteArray> blobs;
+    QString imageString = m_useAttachments ? QString() : QString::fromLatin1(jpeg.toBase64());
+    for (int i = first; i < last; ++i) {
+        QJsonObject entry{
+            { "timestamp", imageTimestamp(start, i).toString("yyyy-MM-ddTHH:mm:ss") },
+            { "image_id", QString("%1/%2").arg(start.toString("yyyy-MM-ddTHH")).arg(i) },
+        };
+        if (thumbnail) {
+            entry["thumbnail"] = true;
+        }
+        if (m_useAttachments) {
+            blobs.append(jpeg);
+        } else {
+            entry["image"] = imageString;
+        }
+        images.append(entry);
+    }
+
+    QJsonObject response{ { "response_id", 10 }, { "data", images } };
+    if (pageSize > 0) {
+        response["total"] = total;
+        response["next_cursor"] = last < total ? QString::fromLatin1(QByteArray::number(last).toBase64()) : QString();
+    }
+
+    if (m_useAttachments) {
+        sendAttachments(response, blobs, request);
+    } else {
+        send(response, request);
+    }
+}
+
+void MockSession::handleFullImage(const QJsonObject &request)
+{
+    // image_id는 조회 응답에서 준 "시작 시각/순번"
+    QStringList parts = request["data"].toObject()["image_id"].toString().split('/');
+    QDateTime start = QDateTime::fromString(parts.value(0), "yyyy-MM-ddTHH");
+    bool ok = false;
+    int index = parts.value(1).toInt(&ok);
+    if (parts.size() != 2 || !start.isValid() || !ok) {
+        send(QJsonObject{ { "response_id", 25 }, { "data", QJsonArray() } }, request);
+        return;
+    }
+
+    QJsonObject entry{
+        { "timestamp", imageTimestamp(start, index).toString("yyyy-MM-ddTHH:mm:ss") },
+        { "image_id", parts.join('/') },
+    };
+    if (m_useAttachments) {
+        sendAttachments(QJsonObject{ { "response_id", 25 }, { "data", QJsonArray{ entry } } },
+                        QList<QByteArray>{ m_server->imageJpeg() }, request);
+    } else {
+        entry["image"] = QString::fromLatin1(m_server->imageBase64());
+        send(QJsonObject{ { "response_id", 25 }, { "data", QJsonArray{ entry } } }, request);
+    }
+}
+
+QDateTime MockSession::imageTimestamp(const QDateTime &start, int index) const
+{
+    // 요청한 시간대 안에서 고르게 분포
+    return start.addSecs(qint64(index) * 3600 / qMax(1, m_server->config().imageCount));
+}
+
+void MockSession::handleSavedLines(const QJsonObject &request, bool roadLines)
+{
+    const QMap<int, QJsonObject> &lines = roadLines ? m_server->roadLines() : m_server->detectionLines();
+
+    QJsonArray array;
+    for (const QJsonObject &line : lines) {
+        array.append(line);
+    }
+    send(QJsonObject{ { "response_id", roadLines ? 16 : 12 }, { "data", array } }, request);
+}
+
+void MockSession::handleUpsert(const QJsonObject &request)
+{
+    // 실제 서버처럼 개별 선 저장은 응답 없이 처리 (클라이언트는 전송 완료로 판단)
+    QJsonObject line = request["data"].toObject();
+    int index = line["index"].toInt();
+
+    switch (request["request_id"].toInt()) {
+    case 2:
+        m_server->detectionLines().insert(index, line);
+        break;
+    case 5:
+        m_server->roadLines().insert(index, line);
+        break;
+    case 6:
+        m_server->perpendicularLines().insert(index, line);
+        break;
+    }
+}
+
+void MockSession::handleLineBatch(const QJsonObject &request)
+{
+    QJsonArray results;
+    auto store = [&results](const QJsonArray &lines, QMap<int, QJsonObject> &target, const QString &kind) {
+        for (const QJsonValue &value : lines) {
+            QJsonObject line = value.toObject();
+            int index = line["index"].toInt();
+            target.insert(index, line);
+            results.append(QJsonObject{
+                { "type", kind },
+                { "index", index },
+                { "success", true },
+                { "message", "" },
+            });
+        }
+    };
+
+    store(request["road_lines"].toArray(), m_server->roadLines(), "road");
+    store(request["detection_lines"].toArray(), m_server->detectionLines(), "detection");
+    store(request["perpendicular_lines"].toArray(), m_server->perpendicularLines(), "perpendicular");
+
+    send(QJsonObject{ { "response_id", 41 }, { "results", results } }, request);
+}
+
+void MockSession::handleDelete(const QJsonObject &request)
+{
+    Q_UNUSED(request);
+    qDebug() << "[Mock] Deleting all saved lines";
+    m_server->clearLines();
+}
+
+void MockSession::setBBoxStreaming(bool enabled)
+{
+    qDebug() << "[Mock] BBox stream" << (enabled ? "on" : "off");
+    if (enabled) {
+        m_bboxTimer->start();
+    } else {
+        m_bboxTimer->stop();
+    }
+}
+
+void MockSession::onBBoxTimer()
+{
+    send(makeBBoxFrame());
+    m_bboxFramesSent++;
+}
+
+QJsonObject MockSession::makeBBoxFrame()
+{
+    const MockServerConfig &config = m_server->config();
+    static const char *types[] = { "vehicle", "person", "human", "bicycle" };
+
+    QJsonArray boxes;
+    for (int i = 0; i < config.bboxObjects; ++i) {
+        boxes.append(QJsonObject{
+            { "id", i + 1 },
+            { "type", types[m_random.bounded(4)] },
+            { "confidence", 0.5 + m_random.bounded(0.5) },
+            { "x", m_random.bounded(1600) },
+            { "y", m_random.bounded(900) },
+            { "width", 40 + m_random.bounded(200) },
+            { "height", 40 + m_random.bounded(200) },
+        });
+    }
+
+    QJsonObject frame{
+        { "response_id", 200 },
+        { "timestamp", QDateTime::currentMSecsSinceEpoch() },
+        { "bboxes", boxes },
+    };
+    if (config.bboxPadding > 0) {
+        frame["padding"] = QString(config.bboxPadding, QChar('x'));
+    }
+    return frame;
+}
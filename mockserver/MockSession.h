@@ -0,0 +1,74 @@
+#ifndef MOCKSESSION_H
+#define MOCKSESSION_H
+
+#include <QObject>
+#include <QSslSocket>
+#include <QTimer>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QElapsedTimer>
+#include <QDateTime>
+
+#include "FrameDecoder.h"
+
+class MockServer;
+
+// 클라이언트 연결 하나 (요청 처리와 BBox 스트림)
+// 소켓이 끊기면 스스로 삭제된다.
+class MockSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    MockSession(QSslSocket *socket, MockServer *server);
+    ~MockSession();
+
+private slots:
+    void onReadyRead();
+    void onDisconnected();
+    void onBBoxTimer();
+
+private:
+    void handleMessage(const QJsonObject &message);
+    void send(QJsonObject message, const QJsonObject &request = QJsonObject());
+    // 첨부 프레임: 헤더 길이 + 헤더(JSON/CBOR) + 블롭 (헤더의 data[i]에 offset/length를 채워 보냄)
+    void sendAttachments(QJsonObject header, const QList<QByteArray> &blobs, const QJsonObject &request);
+    void writeFrame(quint32 header, const QByteArray &payload);
+
+    // 요청별 처리
+    void handleHello(const QJsonObject &request);
+    void handleLogin(const QJsonObject &request);
+    void handleOtpLogin(const QJsonObject &request);
+    void handleSignUp(const QJsonObject &request);
+    void handleImages(const QJsonObject &request);
+    void handleFullImage(const QJsonObject &request);
+    // 조회 응답의 이미지 시각 (index번째 이미지, start는 조회 시작 시각)
+    QDateTime imageTimestamp(const QDateTime &start, int index) const;
+    void handleSavedLines(const QJsonObject &request, bool roadLines);
+    void handleUpsert(const QJsonObject &request);
+    void handleLineBatch(const QJsonObject &request);
+    void handleDelete(const QJsonObject &request);
+    void setBBoxStreaming(bool enabled);
+
+    QJsonObject makeBBoxFrame();
+
+    QSslSocket *m_socket;
+    MockServer *m_server;
+    FrameDecoder m_decoder;
+    QTimer *m_bboxTimer;
+    QRandomGenerator m_random;
+    QElapsedTimer m_connectedTimer;
+    QString m_sessionId;
+    QString m_pendingOtpUser;       // 1단계 로그인을 통과하고 OTP를 기다리는 사용자
+    bool m_useCbor;
+    bool m_useCompression;
+    bool m_useAttachments;
+    bool m_stalled;                 // 반쯤 열린 연결 흉내 (읽기/쓰기 중단)
+
+    // 세션 통계 (종료 시 로그)
+    quint64 m_framesSent;
+    qint64 m_bytesSent;
+    quint64 m_bboxFramesSent;
+};
+
+#endif // MOCKSESSION_H
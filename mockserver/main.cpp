@@ -0,0 +1,64 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include "MockServer.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("CCTVMockServer");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("CCTV Monitoring 클라이언트 개발/측정용 로컬 TCP 서버");
+    parser.addHelpOption();
+
+    MockServerConfig config;
+    QCommandLineOption portOption("port", "Listen port.", "port", QString::number(config.port));
+    QCommandLineOption certOption("cert", "PEM certificate (make-cert.sh).", "file", config.certificatePath);
+    QCommandLineOption keyOption("key", "PEM private key (make-cert.sh).", "file", config.keyPath);
+    QCommandLineOption bboxRateOption("bbox-rate", "BBox frames per second.", "fps", QString::number(config.bboxRate));
+    QCommandLineOption bboxObjectsOption("bbox-objects", "Objects per BBox frame.", "count", QString::number(config.bboxObjects));
+    QCommandLineOption bboxPaddingOption("bbox-padding", "Extra bytes added to every BBox frame.", "bytes", QString::number(config.bboxPadding));
+    QCommandLineOption imageCountOption("image-count", "Images per image query response.", "count", QString::number(config.imageCount));
+    QCommandLineOption imageWidthOption("image-width", "Width of the synthetic JPEG (16:9).", "pixels", QString::number(config.imageWidth));
+    QCommandLineOption otpOption("otp", "Require the OTP step (22) after login.");
+    QCommandLineOption cborOption("cbor", "Select CBOR encoding in the hello response.");
+    QCommandLineOption compressionOption("compression", "Select zlib frame compression in the hello response.");
+    QCommandLineOption attachmentsOption("attachments", "Send images as binary attachment frames when the client supports it.");
+    QCommandLineOption noHeartbeatOption("no-heartbeat", "Do not advertise heartbeat support (old server).");
+    QCommandLineOption noThumbnailsOption("no-thumbnails", "Do not advertise thumbnail support (client makes its own).");
+    QCommandLineOption dropAfterOption("drop-after", "Abort each connection after N seconds.", "seconds", "0");
+    QCommandLineOption stallAfterOption("stall-after", "Stop reading and writing after N seconds, keeping the socket open.", "seconds", "0");
+    QCommandLineOption seedOption("seed", "Random seed for synthetic data.", "seed", QString::number(config.seed));
+
+    parser.addOptions({ portOption, certOption, keyOption, bboxRateOption, bboxObjectsOption, bboxPaddingOption,
+                        imageCountOption, imageWidthOption, otpOption, cborOption, compressionOption,
+                        attachmentsOption, noHeartbeatOption, noThumbnailsOption, dropAfterOption, stallAfterOption,
+                        seedOption });
+    parser.process(app);
+
+    config.port = static_cast<quint16>(parser.value(portOption).toUInt());
+    config.certificatePath = parser.value(certOption);
+    config.keyPath = parser.value(keyOption);
+    config.bboxRate = parser.value(bboxRateOption).toInt();
+    config.bboxObjects = parser.value(bboxObjectsOption).toInt();
+    config.bboxPadding = parser.value(bboxPaddingOption).toInt();
+    config.imageCount = parser.value(imageCountOption).toInt();
+    config.imageWidth = parser.value(imageWidthOption).toInt();
+    config.requireOtp = parser.isSet(otpOption);
+    config.cbor = parser.isSet(cborOption);
+    config.compression = parser.isSet(compressionOption);
+    config.attachments = parser.isSet(attachmentsOption);
+    config.heartbeat = !parser.isSet(noHeartbeatOption);
+    config.thumbnails = !parser.isSet(noThumbnailsOption);
+    config.dropAfterSeconds = parser.value(dropAfterOption).toInt();
+    config.stallAfterSeconds = parser.value(stallAfterOption).toInt();
+    config.seed = parser.value(seedOption).toUInt();
+
+    MockServer server(config);
+    if (!server.start()) {
+        return 1;
+    }
+
+    return app.exec();
+}
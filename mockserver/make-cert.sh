@@ -0,0 +1,14 @@
+#!/bin/sh
+# 목 서버용 일회용 자체 서명 인증서 생성 (클라이언트는 개발 모드에서 VerifyNone으로 접속)
+# 사용법: ./make-cert.sh [출력 디렉토리]
+set -e
+
+OUT_DIR="${1:-.}"
+mkdir -p "$OUT_DIR"
+
+openssl req -x509 -newkey rsa:2048 -nodes -days 30 \
+    -subj "/CN=localhost" \
+    -keyout "$OUT_DIR/mockserver.key" \
+    -out "$OUT_DIR/mockserver.crt"
+
+echo "Created $OUT_DIR/mockserver.crt and $OUT_DIR/mockserver.key"
@@ -0,0 +1,28 @@
+QT = core gui network
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = CCTVMockServer
+TEMPLATE = app
+
+# 클라이언트와 같은 프레임 디코더 사용 (길이 헤더/압축 플래그 해석이 항상 일치하도록)
+INCLUDEPATH += ..
+
+# 소스 파일
+SOURCES += \
+    main.cpp \
+    MockServer.cpp \
+    MockSession.cpp \
+    ../FrameDecoder.cpp
+
+# 헤더 파일
+HEADERS += \
+    MockServer.h \
+    MockSession.h \
+    ../FrameDecoder.h
+
+# 빌드 디렉토리 설정
+DESTDIR = build/bin
+OBJECTS_DIR = build/obj
+MOC_DIR = build/moc
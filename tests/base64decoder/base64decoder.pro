@@ -0,0 +1,18 @@
+QT = core testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_base64decoder
+TEMPLATE = app
+
+INCLUDEPATH += ../..
+
+# 소스 파일
+SOURCES += \
+    tst_base64decoder.cpp \
+    ../../Base64Decoder.cpp
+
+# 헤더 파일
+HEADERS += \
+    ../../Base64Decoder.h
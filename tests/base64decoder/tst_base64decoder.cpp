@@ -0,0 +1,238 @@
+#include <QtTest>
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include "Base64Decoder.h"
+
+namespace {
+QByteArray randomBytes(qsizetype size, quint32 seed)
+{
+    QRandomGenerator random(seed);
+    QByteArray bytes(size, Qt::Uninitialized);
+    for (qsizetype i = 0; i < size; ++i) {
+        bytes[i] = char(random.bounded(256));
+    }
+    return bytes;
+}
+
+// MIME 형식처럼 76자마다 줄바꿈
+QByteArray withLineBreaks(const QByteArray &base64)
+{
+    QByteArray wrapped;
+    for (qsizetype pos = 0; pos < base64.size(); pos += 76) {
+        wrapped += base64.mid(pos, 76);
+        wrapped += "\r\n";
+    }
+    return wrapped;
+}
+
+bool decode(QByteArrayView input, QByteArray &output, QString *error = nullptr)
+{
+    output.resize(0);
+    Base64Decoder decoder(&output);
+    bool ok = decoder.feed(input) && decoder.finish();
+    if (error) {
+        *error = decoder.errorString();
+    }
+    return ok;
+}
+
+// 이미지 응답의 대표 크기 (썸네일, 화면용, 원본)
+void addImageRows()
+{
+    QTest::addColumn<QByteArray>("base64");
+
+    QTest::newRow("16 KB thumbnail") << randomBytes(16 * 1024, 1).toBase64();
+    QTest::newRow("256 KB image") << randomBytes(256 * 1024, 2).toBase64();
+    QTest::newRow("4 MB image") << randomBytes(4 * 1024 * 1024, 3).toBase64();
+    QTest::newRow("256 KB image, MIME line breaks") << withLineBreaks(randomBytes(256 * 1024, 4).toBase64());
+}
+
+double megabytesPerSecond(qint64 bytes, qint64 nsecs)
+{
+    return nsecs > 0 ? bytes * 1000.0 / nsecs : 0.0;
+}
+}
+
+// Base64Decoder가 QByteArray::fromBase64와 같은 결과를 내는지, 그리고 얼마나 빠른지 확인
+// 벤치마크만 보려면: ./tst_base64decoder decoder fromBase64 throughput
+class TestBase64Decoder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void matchesFromBase64_data();
+    void matchesFromBase64();
+    void splitAtEveryPosition();
+    void dataUriPrefix();
+    void writesToDevice();
+    void strictRejectsNonAlphabet_data();
+    void strictRejectsNonAlphabet();
+    void lenientFallback();
+    void decoder_data() { addImageRows(); }
+    void decoder();
+    void fromBase64_data() { addImageRows(); }
+    void fromBase64();
+    void throughput_data() { addImageRows(); }
+    void throughput();
+};
+
+void TestBase64Decoder::matchesFromBase64_data()
+{
+    QTest::addColumn<QByteArray>("base64");
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("one byte") << QByteArray("QQ==");
+    QTest::newRow("two bytes") << QByteArray("QUI=");
+    QTest::newRow("three bytes") << QByteArray("QUJD");
+    QTest::newRow("no padding") << QByteArray("QUJDRA");
+    QTest::newRow("line breaks") << withLineBreaks(randomBytes(1000, 5).toBase64());
+    QTest::newRow("spaces and tabs") << QByteArray(" QUJD\tREVG \n");
+    for (int size : { 15, 16, 17, 47, 48, 49, 4095 }) {
+        QTest::addRow("%d random bytes", size) << randomBytes(size, quint32(size)).toBase64();
+    }
+}
+
+void TestBase64Decoder::matchesFromBase64()
+{
+    QFETCH(QByteArray, base64);
+    QByteArray output;
+    QString error;
+    QVERIFY2(decode(base64, output, &error), qPrintable(error));
+    QCOMPARE(output, QByteArray::fromBase64(base64));
+}
+
+void TestBase64Decoder::splitAtEveryPosition()
+{
+    const QByteArray raw = randomBytes(200, 7);
+    const QByteArray base64 = withLineBreaks(raw.toBase64());
+
+    for (qsizetype split = 0; split <= base64.size(); ++split) {
+        QByteArray output;
+        Base64Decoder decoder(&output);
+        QVERIFY(decoder.feed(QByteArrayView(base64).first(split)));
+        QVERIFY(decoder.feed(QByteArrayView(base64).sliced(split)));
+        QVERIFY(decoder.finish());
+        QCOMPARE(output, raw);
+        QCOMPARE(decoder.decodedBytes(), qint64(raw.size()));
+    }
+}
+
+void TestBase64Decoder::dataUriPrefix()
+{
+    const QByteArray raw = randomBytes(300, 8);
+    const QByteArray uri = "data:image/jpeg;base64," + raw.toBase64();
+
+    QByteArray output;
+    QVERIFY(decode(Base64Decoder::stripDataUriPrefix(uri), output));
+    QCOMPARE(output, raw);
+    QCOMPARE(Base64Decoder::stripDataUriPrefix("QUJD").toByteArray(), QByteArray("QUJD"));
+}
+
+void TestBase64Decoder::writesToDevice()
+{
+    // 출력 조각(OutputChunkSize)보다 큰 입력이 여러 번 나뉘어 기록되는 경우
+    const QByteArray raw = randomBytes(3 * Base64Decoder::OutputChunkSize + 100, 9);
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+
+    Base64Decoder decoder(&buffer);
+    QVERIFY(decoder.feed(raw.toBase64()));
+    QVERIFY(decoder.finish());
+    QCOMPARE(buffer.data(), raw);
+}
+
+void TestBase64Decoder::strictRejectsNonAlphabet_data()
+{
+    QTest::addColumn<QByteArray>("base64");
+
+    // '-'와 '_'는 URL-safe 알파벳, 나머지는 응답에 섞여 들어올 수 있는 잡음
+    QTest::newRow("url-safe minus") << QByteArray("QUJD-A==");
+    QTest::newRow("url-safe underscore") << QByteArray("QUJD_A==");
+    QTest::newRow("stray byte") << QByteArray("QUJD\x01REVG");
+    QTest::newRow("data after padding") << QByteArray("QQ==QUJD");
+    QTest::newRow("truncated") << QByteArray("QUJDR");
+}
+
+void TestBase64Decoder::strictRejectsNonAlphabet()
+{
+    QFETCH(QByteArray, base64);
+    QByteArray output;
+    QString error;
+    QVERIFY(!decode(base64, output, &error));
+    QVERIFY(!error.isEmpty());
+}
+
+void TestBase64Decoder::lenientFallback()
+{
+    // NetworkWorker는 엄격한 디코딩이 실패하면 이 경로로 이전(fromBase64)과 같은 결과를 얻음
+    const QList<QByteArray> inputs{
+        QByteArray("QUJD-REVG"),
+        QByteArray("QUJD_REVG"),
+        QByteArray("QUJD\x01REVG"),
+        QByteArray("data:image/jpeg;base64,QUJD\x7fREVG"),
+    };
+    for (const QByteArray &input : inputs) {
+        QByteArray output;
+        QVERIFY(!decode(Base64Decoder::stripDataUriPrefix(input), output));
+        QCOMPARE(Base64Decoder::decodeLenient(input),
+                 QByteArray::fromBase64(Base64Decoder::stripDataUriPrefix(input).toByteArray()));
+        QVERIFY(!Base64Decoder::decodeLenient(input).isEmpty());
+    }
+}
+
+void TestBase64Decoder::decoder()
+{
+    QFETCH(QByteArray, base64);
+    QByteArray output;
+    QVERIFY(decode(base64, output));
+
+    QBENCHMARK {
+        decode(base64, output);
+    }
+    QCOMPARE(output, QByteArray::fromBase64(base64));
+}
+
+void TestBase64Decoder::fromBase64()
+{
+    // 비교용: 이전 경로 (QString 변환 없이 fromBase64만)
+    QFETCH(QByteArray, base64);
+    QByteArray output;
+    QBENCHMARK {
+        output = QByteArray::fromBase64(base64);
+    }
+    QVERIFY(!output.isEmpty());
+}
+
+void TestBase64Decoder::throughput()
+{
+    // 입력(base64) 기준 MB/s를 같은 조건에서 나란히 기록
+    QFETCH(QByteArray, base64);
+    const int rounds = qMax(3, int(64 * 1024 * 1024 / base64.size()));
+    QByteArray decoded, reference;
+    QElapsedTimer timer;
+
+    timer.start();
+    for (int i = 0; i < rounds; ++i) {
+        decode(base64, decoded);
+    }
+    qint64 decoderNsecs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int i = 0; i < rounds; ++i) {
+        reference = QByteArray::fromBase64(base64);
+    }
+    qint64 fromBase64Nsecs = timer.nsecsElapsed();
+
+    QCOMPARE(decoded, reference);
+    const qint64 bytes = qint64(base64.size()) * rounds;
+    const double decoderRate = megabytesPerSecond(bytes, decoderNsecs);
+    const double fromBase64Rate = megabytesPerSecond(bytes, fromBase64Nsecs);
+    qInfo("%s: Base64Decoder %.1f MB/s, QByteArray::fromBase64 %.1f MB/s (x%.2f)", QTest::currentDataTag(),
+          decoderRate, fromBase64Rate, fromBase64Rate > 0 ? decoderRate / fromBase64Rate : 0.0);
+}
+
+QTEST_APPLESS_MAIN(TestBase64Decoder)
+
+#include "tst_base64decoder.moc"
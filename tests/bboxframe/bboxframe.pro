@@ -0,0 +1,20 @@
+QT = core testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_bboxframe
+TEMPLATE = app
+
+INCLUDEPATH += ../..
+
+# 소스 파일
+SOURCES += \
+    tst_bboxframe.cpp \
+    ../../BBoxFrame.cpp \
+    ../../JsonStreamReader.cpp
+
+# 헤더 파일
+HEADERS += \
+    ../../BBoxFrame.h \
+    ../../JsonStreamReader.h
@@ -0,0 +1,267 @@
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QHash>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "BBoxFrame.h"
+
+// 워밍업 뒤 프레임마다 힙 할당이 없는지 세기 위해 이 테스트 바이너리의 전역 new를 교체
+namespace {
+std::atomic<qint64> allocationCount{0};
+}
+
+void *operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace {
+// 목 서버(MockSession::makeBBoxFrame)와 같은 모양의 BBox 프레임
+QByteArray bboxFrameJson(QRandomGenerator &random, int objects, qint64 timestamp)
+{
+    static const char *types[] = { "vehicle", "person", "human", "bicycle" };
+
+    QJsonArray boxes;
+    for (int i = 0; i < objects; ++i) {
+        boxes.append(QJsonObject{
+            { "id", i + 1 },
+            { "type", types[random.bounded(4)] },
+            { "confidence", 0.5 + random.bounded(0.5) },
+            { "x", random.bounded(1600) },
+            { "y", random.bounded(900) },
+            { "width", 40 + random.bounded(200) },
+            { "height", 40 + random.bounded(200) },
+        });
+    }
+
+    QJsonObject frame{
+        { "response_id", 200 },
+        { "timestamp", timestamp },
+        { "bboxes", boxes },
+    };
+    return QJsonDocument(frame).toJson(QJsonDocument::Compact);
+}
+
+// 객체 수가 프레임마다 달라지는 스트림 (앞의 fullFrames개는 maxObjects개로 가득 채움)
+QList<QByteArray> bboxStream(int frames, int fullFrames, int maxObjects)
+{
+    QRandomGenerator random(1234);
+    QList<QByteArray> stream;
+    for (int i = 0; i < frames; ++i) {
+        int objects = i < fullFrames ? maxObjects : random.bounded(maxObjects + 1);
+        stream.append(bboxFrameJson(random, objects, 1700000000000LL + i * 33));
+    }
+    return stream;
+}
+
+// GUI 쪽 소비자 흉내: 화면에 그린 프레임과 큐에 걸린 프레임 하나씩을 들고 있음
+struct Consumer {
+    BBoxFrameSnapshot displayed;
+    BBoxFrameSnapshot queued;
+
+    void deliver(std::shared_ptr<BBoxFrame> frame)
+    {
+        displayed = std::move(queued);
+        queued = std::move(frame);
+    }
+};
+}
+
+// 네트워크 스레드의 BBox 디코딩 경로(풀에서 꺼내 readBBoxFrame으로 채움)가
+// 워밍업 이후에는 같은 프레임과 같은 버퍼만 다시 쓰는지 확인
+class TestBBoxFrame : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void decodeFrame();
+    void decodeInvalidFrame();
+    void poolReusesReleasedFrame();
+    void noGrowthAfterWarmUp();
+    void decodeThroughPool_data();
+    void decodeThroughPool();
+};
+
+void TestBBoxFrame::decodeFrame()
+{
+    const QByteArray json = "{\"response_id\":200,\"timestamp\":1700000000123,\"bboxes\":["
+                            "{\"id\":7,\"type\":\"vehical\",\"confidence\":0.75,\"x\":10,\"y\":20,\"width\":30,\"height\":40},"
+                            "{\"id\":8,\"type\":\"Human\",\"confidence\":0.5,\"x\":1,\"y\":2,\"width\":3,\"height\":4,\"extra\":[1,{}]}"
+                            "],\"padding\":\"xxxx\"}";
+
+    BBoxFrame frame;
+    QString error;
+    QVERIFY2(readBBoxFrame(json, frame, &error), qPrintable(error));
+    QCOMPARE(frame.timestamp, qint64(1700000000123LL));
+    QCOMPARE(frame.boxes.size(), qsizetype(2));
+
+    const BBox &vehicle = frame.boxes.at(0);
+    QCOMPARE(vehicle.object_id, 7);
+    QVERIFY(vehicle.type == ObjectTypes::Vehicle);
+    QCOMPARE(vehicle.confidence, 0.75f);
+    QCOMPARE(vehicle.rect, QRect(10, 20, 30, 40));
+
+    const BBox &person = frame.boxes.at(1);
+    QCOMPARE(person.object_id, 8);
+    QVERIFY(person.type == ObjectTypes::Person);
+    QCOMPARE(person.rect, QRect(1, 2, 3, 4));
+}
+
+void TestBBoxFrame::decodeInvalidFrame()
+{
+    BBoxFrame frame;
+    QString error;
+    QVERIFY(!readBBoxFrame("[1,2,3]", frame, &error));
+    QVERIFY(!error.isEmpty());
+
+    error.clear();
+    QVERIFY(!readBBoxFrame("{\"bboxes\":[{\"id\":1,", frame, &error));
+    QVERIFY(!error.isEmpty());
+}
+
+void TestBBoxFrame::poolReusesReleasedFrame()
+{
+    BBoxFramePool pool;
+
+    std::shared_ptr<BBoxFrame> first = pool.acquire();
+    BBoxFrame *firstPtr = first.get();
+    first->boxes.append(BBox{1, ObjectTypes::Vehicle, 0.9f, QRect(0, 0, 10, 10)});
+    BBoxFrameSnapshot snapshot = std::move(first);
+
+    // GUI가 아직 들고 있으면 다른 프레임을 받아야 함
+    std::shared_ptr<BBoxFrame> second = pool.acquire();
+    QVERIFY(second.get() != firstPtr);
+    QCOMPARE(snapshot->boxes.size(), qsizetype(1));
+    second.reset();
+
+    // 마지막 스냅샷을 놓아 주면 빈 목록으로 돌아가 같은 프레임이 비워진 채로 돌아옴
+    snapshot.reset();
+    std::shared_ptr<BBoxFrame> reused = pool.acquire();
+    QCOMPARE(reused.get(), firstPtr);
+    QCOMPARE(reused.use_count(), 1L);   // 풀은 참조를 들고 있지 않음
+    QVERIFY(reused->boxes.isEmpty());
+    QCOMPARE(reused->timestamp, qint64(0));
+    QVERIFY(reused->boxes.capacity() >= BBoxFramePool::InitialCapacity);
+}
+
+void TestBBoxFrame::noGrowthAfterWarmUp()
+{
+    // 워밍업에서는 InitialCapacity보다 큰 프레임으로 풀의 모든 프레임을 한 번씩 키움
+    const int warmUpFrames = 16;
+    const int maxObjects = 2 * BBoxFramePool::InitialCapacity;
+    const QList<QByteArray> stream = bboxStream(500, warmUpFrames, maxObjects);
+
+    BBoxFramePool pool;
+    Consumer consumer;
+    QString error;
+
+    QHash<BBoxFrame *, const BBox *> buffers;
+    for (int i = 0; i < warmUpFrames; ++i) {
+        std::shared_ptr<BBoxFrame> frame = pool.acquire();
+        QVERIFY2(readBBoxFrame(stream.at(i), *frame, &error), qPrintable(error));
+        buffers.insert(frame.get(), frame->boxes.constData());
+        consumer.deliver(std::move(frame));
+    }
+    QVERIFY(buffers.size() <= BBoxFramePool::MaxPooledFrames);
+
+    // 이후에는 풀 밖의 새 프레임도, boxes 버퍼 재할당도, 제어 블록 할당도 없어야 함
+    // (검사 메시지를 만드는 할당이 섞이지 않도록 꺼내기~전달 구간만 셈)
+    for (qsizetype i = warmUpFrames; i < stream.size(); ++i) {
+        const qint64 allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+        std::shared_ptr<BBoxFrame> frame = pool.acquire();
+        BBoxFrame *framePtr = frame.get();
+        const long useCount = frame.use_count();
+        const BBox *bufferBefore = frame->boxes.constData();
+        const bool decoded = readBBoxFrame(stream.at(i), *frame, &error);
+        const BBox *bufferAfter = frame->boxes.constData();
+        const qsizetype capacity = frame->boxes.capacity();
+        consumer.deliver(std::move(frame));
+        const qint64 allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+        QVERIFY2(buffers.contains(framePtr), qPrintable(QString("New frame allocated at frame %1").arg(i)));
+        QCOMPARE(useCount, 1L);             // 빈 목록에서 꺼낸 프레임 (GUI 쪽 스냅샷은 모두 해제됨)
+        QVERIFY2(decoded, qPrintable(error));
+
+        const BBox *buffer = buffers.value(framePtr);
+        QCOMPARE(bufferBefore, buffer);
+        QCOMPARE(bufferAfter, buffer);
+        QVERIFY(capacity >= maxObjects);
+        QVERIFY2(allocations == 0, qPrintable(QString("%1 heap allocations at frame %2").arg(allocations).arg(i)));
+    }
+}
+
+void TestBBoxFrame::decodeThroughPool_data()
+{
+    QTest::addColumn<int>("objects");
+
+    QTest::newRow("8 objects") << 8;
+    QTest::newRow("32 objects") << 32;
+    QTest::newRow("128 objects") << 128;
+}
+
+void TestBBoxFrame::decodeThroughPool()
+{
+    QFETCH(int, objects);
+    QRandomGenerator random(42);
+    QList<QByteArray> stream;
+    for (int i = 0; i < 32; ++i) {
+        stream.append(bboxFrameJson(random, objects, 1700000000000LL + i * 33));
+    }
+
+    BBoxFramePool pool;
+    Consumer consumer;
+    for (const QByteArray &json : std::as_const(stream)) {
+        std::shared_ptr<BBoxFrame> frame = pool.acquire();
+        QVERIFY(readBBoxFrame(json, *frame));
+        consumer.deliver(std::move(frame));
+    }
+
+    qsizetype index = 0;
+    bool ok = true;
+    QBENCHMARK {
+        std::shared_ptr<BBoxFrame> frame = pool.acquire();
+        ok = readBBoxFrame(stream.at(index), *frame) && ok;
+        index = (index + 1) % stream.size();
+        consumer.deliver(std::move(frame));
+    }
+    QVERIFY(ok);
+    QCOMPARE(consumer.queued->boxes.size(), qsizetype(objects));
+}
+
+QTEST_APPLESS_MAIN(TestBBoxFrame)
+
+#include "tst_bboxframe.moc"
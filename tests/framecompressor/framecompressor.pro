@@ -0,0 +1,21 @@
+QT = core testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_framecompressor
+TEMPLATE = app
+
+INCLUDEPATH += ../..
+
+# 소스 파일
+SOURCES += \
+    tst_framecompressor.cpp \
+    ../../FrameCompressor.cpp
+
+# 헤더 파일
+HEADERS += \
+    ../../FrameCompressor.h
+
+win32-msvc*: LIBS += zlib.lib
+else: LIBS += -lz
@@ -0,0 +1,278 @@
+#include <QtTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QtEndian>
+
+#include "FrameCompressor.h"
+
+namespace {
+QByteArray toJson(const QJsonObject &object)
+{
+    return QJsonDocument(object).toJson(QJsonDocument::Compact);
+}
+
+// JPEG처럼 거의 압축되지 않는 바이트
+QByteArray randomBytes(QRandomGenerator &random, qsizetype size)
+{
+    QByteArray bytes(size, Qt::Uninitialized);
+    for (qsizetype i = 0; i < size; ++i) {
+        bytes[i] = char(random.bounded(256));
+    }
+    return bytes;
+}
+
+// 200: BBox 스트림 한 프레임 (목 서버와 같은 모양)
+QByteArray bboxFrame(int objects)
+{
+    static const char *types[] = { "vehicle", "person", "human", "bicycle" };
+    QRandomGenerator random(200);
+    QJsonArray boxes;
+    for (int i = 0; i < objects; ++i) {
+        boxes.append(QJsonObject{
+            { "id", i + 1 },
+            { "type", types[random.bounded(4)] },
+            { "confidence", 0.5 + random.bounded(0.5) },
+            { "x", random.bounded(1600) },
+            { "y", random.bounded(900) },
+            { "width", 40 + random.bounded(200) },
+            { "height", 40 + random.bounded(200) },
+        });
+    }
+    return toJson(QJsonObject{ { "response_id", 200 }, { "timestamp", 1700000000000LL }, { "bboxes", boxes } });
+}
+
+// 10: 이미지 조회 응답 한 페이지 (base64 JPEG)
+QByteArray imagePage(int images, qsizetype imageBytes)
+{
+    QRandomGenerator random(10);
+    QJsonArray data;
+    for (int i = 0; i < images; ++i) {
+        data.append(QJsonObject{
+            { "timestamp", QString("2024-01-01T10:%1:00").arg(i % 60, 2, 10, QChar('0')) },
+            { "image_id", QString("2024-01-01T10/%1").arg(i) },
+            { "image", QString::fromLatin1(randomBytes(random, imageBytes).toBase64()) },
+        });
+    }
+    return toJson(QJsonObject{ { "response_id", 10 }, { "data", data }, { "total", 1440 } });
+}
+
+QJsonObject roadLine(QRandomGenerator &random, int index)
+{
+    return QJsonObject{
+        { "index", index },
+        { "matrixNum1", random.bounded(1, 5) },
+        { "x1", random.bounded(1920) },
+        { "y1", random.bounded(1080) },
+        { "matrixNum2", random.bounded(1, 5) },
+        { "x2", random.bounded(1920) },
+        { "y2", random.bounded(1080) },
+    };
+}
+
+QJsonObject detectionLine(QRandomGenerator &random, int index)
+{
+    return QJsonObject{
+        { "index", index },
+        { "x1", random.bounded(1920) },
+        { "x2", random.bounded(1920) },
+        { "y1", random.bounded(1080) },
+        { "y2", random.bounded(1080) },
+        { "name", QString("line%1").arg(index) },
+        { "mode", "BothDirections" },
+    };
+}
+
+QJsonObject perpendicularLine(QRandomGenerator &random, int index)
+{
+    return QJsonObject{
+        { "index", index },
+        { "a", random.bounded(10.0) - 5.0 },
+        { "b", random.bounded(1080.0) },
+    };
+}
+
+// 12 / 16: 저장된 감지선 / 도로선 조회 응답
+QByteArray savedLines(int responseId, int lines)
+{
+    QRandomGenerator random(responseId);
+    QJsonArray data;
+    for (int i = 0; i < lines; ++i) {
+        data.append(responseId == 16 ? roadLine(random, i + 1) : detectionLine(random, i + 1));
+    }
+    return toJson(QJsonObject{ { "response_id", responseId }, { "data", data } });
+}
+
+// 40: 선 설정 일괄 업로드 (클라이언트 → 서버)
+QByteArray lineBatch(int linesPerKind)
+{
+    QRandomGenerator random(40);
+    QJsonArray road, detection, perpendicular;
+    for (int i = 0; i < linesPerKind; ++i) {
+        road.append(roadLine(random, i + 1));
+        detection.append(detectionLine(random, i + 1));
+        perpendicular.append(perpendicularLine(random, i + 1));
+    }
+    return toJson(QJsonObject{
+        { "request_id", 40 },
+        { "road_lines", road },
+        { "detection_lines", detection },
+        { "perpendicular_lines", perpendicular },
+    });
+}
+
+// 메시지 타입별 대표 페이로드 (벤치마크와 왕복 테스트가 같은 행을 씀)
+void addMessageRows()
+{
+    QTest::addColumn<QByteArray>("payload");
+
+    QTest::newRow("200 bbox frame (20 objects)") << bboxFrame(20);
+    QTest::newRow("200 bbox frame (100 objects)") << bboxFrame(100);
+    QTest::newRow("10 image page (20 x 48 KB)") << imagePage(20, 48 * 1024);
+    QTest::newRow("12 detection lines (16)") << savedLines(12, 16);
+    QTest::newRow("16 road lines (16)") << savedLines(16, 16);
+    QTest::newRow("40 line batch (3 x 16)") << lineBatch(16);
+}
+}
+
+// FrameCompressor의 형식 호환성과 메시지 타입별 압축률/CPU 비용
+// 벤치마크만 보려면: ./tst_framecompressor compress decompress qCompressBaseline
+class TestFrameCompressor : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip_data() { addMessageRows(); }
+    void roundTrip();
+    void streamingDecompress();
+    void corruptFrame();
+    void compress_data() { addMessageRows(); }
+    void compress();
+    void decompress_data() { addMessageRows(); }
+    void decompress();
+    void qCompressBaseline_data() { addMessageRows(); }
+    void qCompressBaseline();
+};
+
+void TestFrameCompressor::roundTrip()
+{
+    QFETCH(QByteArray, payload);
+    FrameCompressor compressor;
+
+    // 같은 z_stream을 reset해 다시 써도 결과가 같아야 함
+    QByteArray first, second, inflated;
+    QVERIFY2(compressor.compress(payload, first), qPrintable(compressor.errorString()));
+    QVERIFY2(compressor.compress(payload, second), qPrintable(compressor.errorString()));
+    QCOMPARE(second, first);
+    QCOMPARE(FrameCompressor::uncompressedSize(first), qint64(payload.size()));
+
+    QVERIFY2(compressor.decompress(first, inflated), qPrintable(compressor.errorString()));
+    QCOMPARE(inflated, payload);
+
+    // 서버(qCompress/qUncompress)와 같은 형식
+    QCOMPARE(qUncompress(first), payload);
+    QVERIFY2(compressor.decompress(qCompress(payload, 6), inflated), qPrintable(compressor.errorString()));
+    QCOMPARE(inflated, payload);
+
+    // 압축률 기록 (JPEG base64도 알파벳이 64자라 원본보다는 작아짐)
+    qInfo("%s: %lld -> %lld bytes (%.1f%%)", QTest::currentDataTag(), qint64(payload.size()),
+          qint64(first.size()), 100.0 * double(first.size()) / double(payload.size()));
+    QVERIFY(first.size() < payload.size());
+}
+
+void TestFrameCompressor::streamingDecompress()
+{
+    const QByteArray payload = imagePage(40, 64 * 1024);
+    FrameCompressor compressor;
+    QByteArray compressed;
+    QVERIFY(compressor.compress(payload, compressed));
+
+    QBuffer device(&compressed);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QByteArray inflated;
+    qsizetype largestChunk = 0;
+    bool ok = compressor.decompress(&device, compressed.size(), [&](QByteArrayView chunk) {
+        largestChunk = qMax(largestChunk, chunk.size());
+        inflated.append(chunk);
+        return true;
+    });
+    QVERIFY2(ok, qPrintable(compressor.errorString()));
+    QCOMPARE(inflated, payload);
+    QVERIFY(largestChunk <= FrameCompressor::ChunkSize);
+
+    // 같은 연결에서 다음 프레임도 그대로 풀려야 함
+    QByteArray small;
+    QVERIFY(compressor.decompress(qCompress(bboxFrame(5)), small));
+    QCOMPARE(small, bboxFrame(5));
+}
+
+void TestFrameCompressor::corruptFrame()
+{
+    const QByteArray payload = savedLines(12, 16);
+    FrameCompressor compressor;
+    QByteArray compressed, inflated;
+    QVERIFY(compressor.compress(payload, compressed));
+
+    QVERIFY(!compressor.decompress(QByteArrayView(compressed).first(2), inflated));
+    QVERIFY(!compressor.decompress(QByteArrayView(compressed).chopped(8), inflated));
+    QVERIFY(!compressor.errorString().isEmpty());
+
+    // 선언한 크기와 실제 풀린 크기가 다르면 실패
+    QByteArray wrongSize = compressed;
+    qToBigEndian(quint32(payload.size() - 1), wrongSize.data());
+    QVERIFY(!compressor.decompress(wrongSize, inflated));
+    qToBigEndian(quint32(payload.size() + 1), wrongSize.data());
+    QVERIFY(!compressor.decompress(wrongSize, inflated));
+
+    QBuffer device(&wrongSize);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QVERIFY(!compressor.decompress(&device, wrongSize.size(), [](QByteArrayView) { return true; }));
+
+    // 실패 후에도 z_stream은 다시 쓸 수 있어야 함
+    QVERIFY2(compressor.decompress(compressed, inflated), qPrintable(compressor.errorString()));
+    QCOMPARE(inflated, payload);
+}
+
+void TestFrameCompressor::compress()
+{
+    QFETCH(QByteArray, payload);
+    FrameCompressor compressor;
+    QByteArray output;
+    QVERIFY(compressor.compress(payload, output));
+
+    // 연결 하나가 같은 타입의 메시지를 계속 보내는 경우 (z_stream/출력 버퍼 재사용)
+    QBENCHMARK {
+        compressor.compress(payload, output);
+    }
+    QVERIFY(output.size() < payload.size());
+}
+
+void TestFrameCompressor::decompress()
+{
+    QFETCH(QByteArray, payload);
+    FrameCompressor compressor;
+    QByteArray compressed, inflated;
+    QVERIFY(compressor.compress(payload, compressed));
+
+    QBENCHMARK {
+        compressor.decompress(compressed, inflated);
+    }
+    QCOMPARE(inflated, payload);
+}
+
+void TestFrameCompressor::qCompressBaseline()
+{
+    // 비교용: 이전 방식처럼 메시지마다 zlib 상태를 새로 만드는 경우
+    QFETCH(QByteArray, payload);
+    QByteArray output;
+    QBENCHMARK {
+        output = qCompress(payload, 6);
+    }
+    QCOMPARE(qUncompress(output), payload);
+}
+
+QTEST_APPLESS_MAIN(TestFrameCompressor)
+
+#include "tst_framecompressor.moc"
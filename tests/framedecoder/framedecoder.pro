@@ -0,0 +1,20 @@
+QT = core testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_framedecoder
+TEMPLATE = app
+
+INCLUDEPATH += ../..
+
+# 소스 파일
+SOURCES += \
+    tst_framedecoder.cpp \
+    ../../FrameDecoder.cpp \
+    ../../JsonStreamReader.cpp
+
+# 헤더 파일
+HEADERS += \
+    ../../FrameDecoder.h \
+    ../../JsonStreamReader.h
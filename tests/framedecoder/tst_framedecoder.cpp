@@ -0,0 +1,381 @@
+#include <QtTest>
+#include <QBuffer>
+#include <QTemporaryFile>
+#include <QtEndian>
+#include <QCborMap>
+#include <QCborArray>
+#include <cstring>
+
+#include "FrameDecoder.h"
+#include "JsonStreamReader.h"
+
+namespace {
+QByteArray frameHeader(quint32 length)
+{
+    QByteArray header(FrameDecoder::HeaderSize, Qt::Uninitialized);
+    qToBigEndian(length, header.data());
+    return header;
+}
+
+QByteArray makeFrame(const QByteArray &payload)
+{
+    return frameHeader(quint32(payload.size())) + payload;
+}
+
+// response_id가 맨 앞에 오는 JSON 페이로드 (전체가 size 바이트가 되도록 채움)
+QByteArray jsonPayload(int responseId, qsizetype size, char fill = 'x')
+{
+    QByteArray payload = QByteArray("{\"response_id\":") + QByteArray::number(responseId) + ",\"data\":\"";
+    const QByteArray suffix = "\"}";
+    payload.append(qMax<qsizetype>(0, size - payload.size() - suffix.size()), fill);
+    payload.append(suffix);
+    return payload;
+}
+
+// 지금 꺼낼 수 있는 메모리 프레임을 모두 꺼냄
+QList<QByteArray> takeFrames(FrameDecoder &decoder)
+{
+    QList<QByteArray> frames;
+    QByteArrayView frame;
+    while (decoder.nextFrame(frame)) {
+        frames.append(frame.toByteArray());
+    }
+    return frames;
+}
+}
+
+// 수신 데이터가 어떤 경계에서 잘려 들어와도 같은 프레임이 나오는지 확인
+class TestFrameDecoder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void headerSplitAcrossReads_data();
+    void headerSplitAcrossReads();
+    void byteByByte();
+    void severalFramesInOneRead();
+    void frameFollowedByPartialFrame();
+    void largeFrameInMemory();
+    void largeFrameSpilled();
+    void resetDiscardsPartialFrame();
+    void resetDuringSpool();
+    void resetClearsError();
+    void sniffTopLevelIdOnly_data();
+    void sniffTopLevelIdOnly();
+    void fullDayImageQueryStaysBounded();
+};
+
+void TestFrameDecoder::headerSplitAcrossReads_data()
+{
+    QTest::addColumn<int>("split");
+
+    QTest::newRow("1 header byte") << 1;
+    QTest::newRow("2 header bytes") << 2;
+    QTest::newRow("3 header bytes") << 3;
+    QTest::newRow("header only") << 4;
+    QTest::newRow("header + partial payload") << 40;
+}
+
+void TestFrameDecoder::headerSplitAcrossReads()
+{
+    QFETCH(int, split);
+    const QByteArray payload = jsonPayload(16, 100);
+    const QByteArray data = makeFrame(payload);
+
+    FrameDecoder decoder;
+    QByteArrayView frame;
+    decoder.append(QByteArrayView(data).first(split));
+    QVERIFY(!decoder.nextFrame(frame));
+
+    decoder.append(QByteArrayView(data).sliced(split));
+    QVERIFY(decoder.nextFrame(frame));
+    QCOMPARE(frame.toByteArray(), payload);
+    QCOMPARE(decoder.lastFrameSize(), qint64(payload.size()));
+    QVERIFY(!decoder.nextFrame(frame));
+    QCOMPARE(decoder.bufferedBytes(), qsizetype(0));
+}
+
+void TestFrameDecoder::byteByByte()
+{
+    const QList<QByteArray> payloads{ jsonPayload(12, 50), jsonPayload(16, 3000), jsonPayload(41, 80) };
+    QByteArray data;
+    for (const QByteArray &payload : payloads) {
+        data += makeFrame(payload);
+    }
+
+    FrameDecoder decoder;
+    QList<QByteArray> received;
+    for (qsizetype i = 0; i < data.size(); ++i) {
+        decoder.append(QByteArrayView(data).sliced(i, 1));
+        received += takeFrames(decoder);
+    }
+    QCOMPARE(received, payloads);
+    QVERIFY(!decoder.hasError());
+}
+
+void TestFrameDecoder::severalFramesInOneRead()
+{
+    QList<QByteArray> payloads;
+    QByteArray data;
+    for (int i = 0; i < 50; ++i) {
+        payloads.append(jsonPayload(200, 100 + i * 7, char('a' + i % 26)));
+        data += makeFrame(payloads.last());
+    }
+    QVERIFY(data.size() < FrameDecoder::ReadChunkSize);
+
+    // 소켓 한 번 읽기에 모든 프레임이 들어온 경우
+    QBuffer device(&data);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    FrameDecoder decoder;
+    QCOMPARE(decoder.readFrom(&device), qint64(data.size()));
+    QCOMPARE(takeFrames(decoder), payloads);
+    QCOMPARE(decoder.bufferedBytes(), qsizetype(0));
+}
+
+void TestFrameDecoder::frameFollowedByPartialFrame()
+{
+    const QByteArray first = jsonPayload(12, 200);
+    const QByteArray second = jsonPayload(16, 500);
+    const QByteArray secondFrame = makeFrame(second);
+    const qsizetype half = secondFrame.size() / 2;
+
+    FrameDecoder decoder;
+    decoder.append(makeFrame(first) + secondFrame.first(half));
+    QCOMPARE(takeFrames(decoder), QList<QByteArray>{ first });
+    QCOMPARE(decoder.bufferedBytes(), half);
+
+    decoder.append(QByteArrayView(secondFrame).sliced(half));
+    QCOMPARE(takeFrames(decoder), QList<QByteArray>{ second });
+}
+
+void TestFrameDecoder::largeFrameInMemory()
+{
+    // 기준을 올려 50MB 프레임을 메모리로 받음 (버퍼가 프레임 크기만큼 늘어났다가 다음 프레임에서 줄어듦)
+    const qsizetype size = 50 * 1024 * 1024;
+    const QByteArray payload = jsonPayload(10, size);
+    QByteArray data = makeFrame(payload);
+
+    FrameDecoder decoder;
+    decoder.setSpillThreshold(64LL * 1024 * 1024);
+    QBuffer device(&data);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+
+    int frames = 0;
+    while (!device.atEnd()) {
+        QVERIFY(decoder.readFrom(&device) > 0);
+        QByteArrayView frame;
+        while (decoder.nextFrame(frame)) {
+            ++frames;
+            QVERIFY(!decoder.lastFrameSpilled());
+            QCOMPARE(frame.size(), size);
+            QVERIFY(std::memcmp(frame.data(), payload.constData(), size) == 0);
+        }
+    }
+    QCOMPARE(frames, 1);
+
+    decoder.append(makeFrame(jsonPayload(12, 100)));
+    QCOMPARE(takeFrames(decoder).size(), 1);
+    QVERIFY(decoder.capacity() < size);
+}
+
+void TestFrameDecoder::largeFrameSpilled()
+{
+    // 기본 기준(8MB)을 넘는 50MB 프레임은 임시 파일로 받아 spilledFrame()으로 전달
+    const qsizetype size = 50 * 1024 * 1024;
+    const QByteArray payload = jsonPayload(10, size);
+    QByteArray data = makeFrame(payload) + makeFrame(jsonPayload(12, 100));
+
+    FrameDecoder decoder;
+    QBuffer device(&data);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+
+    int spilledFrames = 0;
+    int memoryFrames = 0;
+    while (!device.atEnd()) {
+        QVERIFY(decoder.readFrom(&device) >= 0);
+        QByteArrayView frame;
+        while (decoder.nextFrame(frame)) {
+            if (!decoder.lastFrameSpilled()) {
+                ++memoryFrames;
+                continue;
+            }
+            ++spilledFrames;
+            QCOMPARE(decoder.lastFrameMessageId(), 10);
+            QCOMPARE(decoder.lastFrameSize(), qint64(size));
+            QIODevice *file = decoder.spilledFrame();
+            QVERIFY(file);
+            QCOMPARE(file->size(), qint64(size));
+            QByteArray chunk;
+            for (qsizetype pos = 0; pos < size; pos += chunk.size()) {
+                chunk = file->read(1024 * 1024);
+                QVERIFY(!chunk.isEmpty());
+                QVERIFY(std::memcmp(chunk.constData(), payload.constData() + pos, chunk.size()) == 0);
+            }
+        }
+    }
+    QCOMPARE(spilledFrames, 1);
+    QCOMPARE(memoryFrames, 1);
+    QVERIFY(!decoder.hasError());
+}
+
+void TestFrameDecoder::resetDiscardsPartialFrame()
+{
+    // 재연결: 끊기기 전 반쯤 받은 프레임이 다음 연결의 첫 프레임과 섞이면 안 됨
+    const QByteArray stale = makeFrame(jsonPayload(10, 1000));
+    const QByteArray fresh = jsonPayload(12, 300);
+
+    FrameDecoder decoder;
+    decoder.append(stale.first(stale.size() / 2));
+    QVERIFY(takeFrames(decoder).isEmpty());
+
+    decoder.reset();
+    QCOMPARE(decoder.bufferedBytes(), qsizetype(0));
+    decoder.append(makeFrame(fresh));
+    QCOMPARE(takeFrames(decoder), QList<QByteArray>{ fresh });
+}
+
+void TestFrameDecoder::resetDuringSpool()
+{
+    const QByteArray large = makeFrame(jsonPayload(10, 64 * 1024));
+    const QByteArray fresh = jsonPayload(12, 300);
+
+    FrameDecoder decoder;
+    decoder.setSpillThreshold(16 * 1024);
+    decoder.append(large.first(32 * 1024));
+    QVERIFY(takeFrames(decoder).isEmpty());
+
+    decoder.reset();
+    decoder.append(makeFrame(fresh));
+    QCOMPARE(takeFrames(decoder), QList<QByteArray>{ fresh });
+    QVERIFY(!decoder.lastFrameSpilled());
+}
+
+void TestFrameDecoder::resetClearsError()
+{
+    // 허용치를 넘는 길이는 페이로드를 기다리지 않고 오류, reset 후에는 정상 수신
+    FrameDecoder decoder;
+    decoder.setMaxFrameSize(1024);
+    decoder.append(frameHeader(1024 * 1024) + jsonPayload(16, FrameDecoder::SniffSize));
+    QVERIFY(takeFrames(decoder).isEmpty());
+    QVERIFY(decoder.hasError());
+
+    decoder.reset();
+    QVERIFY(!decoder.hasError());
+    const QByteArray fresh = jsonPayload(16, 200);
+    decoder.append(makeFrame(fresh));
+    QCOMPARE(takeFrames(decoder), QList<QByteArray>{ fresh });
+}
+
+void TestFrameDecoder::sniffTopLevelIdOnly_data()
+{
+    QTest::addColumn<QByteArray>("payload");
+    QTest::addColumn<int>("messageId");
+
+    // Qt가 만든 JSON/CBOR는 키가 이름순이라 "data"가 타입보다 앞에 옴
+    QTest::newRow("top level") << QByteArray("{\"response_id\":10,\"data\":[]}") << 10;
+    QTest::newRow("nested key first")
+        << QByteArray("{\"data\":[{\"response_id\":200}],\"meta\":{\"request_id\":3},\"response_id\":10}") << 10;
+    QTest::newRow("key text inside string")
+        << QByteArray("{\"log\":\"\\\"request_id\\\":5\",\"response_id\":10}") << 10;
+    QTest::newRow("value named like key") << QByteArray("{\"name\":\"response_id\",\"request_id\":7}") << 7;
+    QTest::newRow("top level key cut off")
+        << QByteArray("{\"data\":[{\"response_id\":200},{\"id\":") << -1;
+    QTest::newRow("not an object") << QByteArray("[{\"response_id\":10}]") << -1;
+
+    QCborMap nested;
+    nested.insert(QLatin1String("response_id"), 200);
+    QCborMap cbor;
+    cbor.insert(QLatin1String("data"), QCborArray{ nested });
+    cbor.insert(QLatin1String("response_id"), 10);
+    QTest::newRow("cbor nested key first") << cbor.toCborValue().toCbor() << 10;
+}
+
+void TestFrameDecoder::sniffTopLevelIdOnly()
+{
+    // 중첩 객체의 키를 잘못 읽으면 이미지 응답(10)이 다른 타입의 허용치로 검사됨
+    QFETCH(QByteArray, payload);
+    QFETCH(int, messageId);
+    QCOMPARE(FrameDecoder::sniffMessageId(payload), messageId);
+}
+
+void TestFrameDecoder::fullDayImageQueryStaysBounded()
+{
+    // 하루치 조회 응답 (이미지 2000장, 약 80MB)을 만들어 파일에서 소켓처럼 조각 단위로 받고,
+    // 임시 파일로 받은 프레임을 스트리밍으로 파싱하는 동안 메모리가 응답 크기와 무관하게 유지되는지 확인
+    const int imageCount = 2000;
+    QByteArray image(30 * 1024, Qt::Uninitialized);
+    for (qsizetype i = 0; i < image.size(); ++i) {
+        image[i] = char(i * 31 + i / 7);
+    }
+    const QByteArray base64 = image.toBase64();
+
+    QTemporaryFile payloadFile;
+    QVERIFY(payloadFile.open());
+    payloadFile.write("{\"response_id\":10,\"seq\":1,\"total\":" + QByteArray::number(imageCount) + ",\"data\":[");
+    for (int i = 0; i < imageCount; ++i) {
+        QByteArray timestamp = QTime(0, 0).addSecs(i * 40).toString("'2025-01-01T'HH:mm:ss").toUtf8();
+        payloadFile.write(QByteArray(i > 0 ? "," : "") + "{\"timestamp\":\"" + timestamp + "\",\"image\":\"");
+        payloadFile.write(base64);
+        payloadFile.write("\"}");
+    }
+    payloadFile.write("]}");
+    const qint64 payloadSize = payloadFile.size();
+    QVERIFY(payloadSize > 64LL * 1024 * 1024);
+    QVERIFY(payloadFile.seek(0));
+
+    // NetworkWorker와 같은 설정 (이미지 응답만 1GB까지, 8MB 초과는 임시 파일)
+    FrameDecoder decoder;
+    decoder.setMaxFrameSize(10, 1024LL * 1024 * 1024);
+    decoder.append(frameHeader(quint32(payloadSize)));
+
+    qsizetype peakCapacity = decoder.capacity();
+    QIODevice *spilled = nullptr;
+    while (!spilled) {
+        qint64 bytesRead = decoder.readFrom(&payloadFile);
+        QVERIFY(bytesRead >= 0);
+        peakCapacity = qMax(peakCapacity, decoder.capacity());
+
+        QByteArrayView frame;
+        if (decoder.nextFrame(frame)) {
+            QVERIFY(decoder.lastFrameSpilled());
+            spilled = decoder.spilledFrame();
+        } else {
+            QVERIFY(bytesRead > 0);
+        }
+    }
+    QVERIFY(!decoder.hasError());
+    QCOMPARE(decoder.lastFrameMessageId(), 10);
+    QCOMPARE(decoder.lastFrameSize(), payloadSize);
+    QVERIFY(peakCapacity <= 2 * FrameDecoder::ReadChunkSize);
+
+    JsonStreamReader reader(spilled);
+    QVERIFY(reader.readNext() == JsonStreamReader::BeginObject);
+    int images = 0;
+    qsizetype peakReaderBuffer = 0;
+    while (reader.readNext() == JsonStreamReader::Name) {
+        if (!reader.isName("data")) {
+            reader.skipValue();
+            continue;
+        }
+        QVERIFY(reader.readNext() == JsonStreamReader::BeginArray);
+        while (reader.readNext() == JsonStreamReader::BeginObject) {
+            while (reader.readNext() == JsonStreamReader::Name) {
+                bool isImage = reader.isName("image");
+                reader.readNext();
+                if (isImage) {
+                    QCOMPARE(reader.text().size(), base64.size());
+                    ++images;
+                }
+                peakReaderBuffer = qMax(peakReaderBuffer, reader.bufferCapacity());
+            }
+        }
+    }
+    QVERIFY(!reader.hasError());
+    QCOMPARE(images, imageCount);
+    // 가장 큰 값(이미지 하나)과 읽기 조각 몇 개 정도 (응답 전체 크기와 무관)
+    QVERIFY(peakReaderBuffer <= 4 * (base64.size() + 64 * 1024));
+}
+
+QTEST_APPLESS_MAIN(TestFrameDecoder)
+
+#include "tst_framedecoder.moc"
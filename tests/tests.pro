@@ -0,0 +1,8 @@
+# QtTest 단위 테스트/벤치마크 (qmake && make && make check)
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    framedecoder \
+    framecompressor \
+    base64decoder \
+    bboxframe